@@ -0,0 +1,2 @@
+#!/bin/sh
+"PATH_TO_YOUR_ENGINE/Engine/Binaries/Linux/UnrealEditor-Cmd" "PATH_TO_YOUR_UPROJECT_FILE" -run=GridlyImportExport -Config="PATH_TO_YOUR_PROJECT/Plugins/Gridly/Config/ImportExport.ini" -Section=Import "$@"
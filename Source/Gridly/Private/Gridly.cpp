@@ -8,10 +8,17 @@
 #include "ISettingsContainer.h"
 #include "ISettingsModule.h"
 #include "ISettingsSection.h"
-// For accessing Gridly's game settings
-#include "GridlyGameSettings.h"
 #endif
 
+#include "GridlyBPFunctionLibrary.h"
+#include "GridlyGameSettings.h"
+#include "GridlyLivePreviewCache.h"
+#include "GridlyProfiling.h"
+#include "GridlyTask_DownloadLocalizedTexts.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
+
 // For logging functionality
 #include "Logging/LogMacros.h"
 
@@ -25,6 +32,11 @@ DEFINE_LOG_CATEGORY(LogGridly);
 
 void FGridlyModule::StartupModule()
 {
+    if (FParse::Param(FCommandLine::Get(), TEXT("GridlyCountAllocations")))
+    {
+        FGridlyProfiling::EnableAllocationCounting();
+    }
+
 #if WITH_EDITOR
     // Register project settings
     if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
@@ -45,10 +57,14 @@ void FGridlyModule::StartupModule()
         }
     }
 #endif
+
+    FCoreDelegates::OnPostEngineInit.AddRaw(this, &FGridlyModule::OnPostEngineInit);
 }
 
 void FGridlyModule::ShutdownModule()
 {
+    FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
 #if WITH_EDITOR
     if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
     {
@@ -57,6 +73,40 @@ void FGridlyModule::ShutdownModule()
 #endif
 }
 
+void FGridlyModule::OnPostEngineInit()
+{
+#if !UE_BUILD_SHIPPING
+    // Live preview cache only applies to running development games, the editor previews through PIE. Shipping builds
+    // always show the shipped localization
+
+    if (GIsEditor || IsRunningCommandlet())
+    {
+        return;
+    }
+
+    const UGridlyGameSettings* GameSettings = GetDefault<UGridlyGameSettings>();
+
+    if (GameSettings->bCacheLivePreview)
+    {
+        FGridlyLivePreviewCache::Get().ApplyCachedDataset();
+
+        if (GameSettings->bRefreshLivePreviewOnStartup)
+        {
+            UGridlyTask_DownloadLocalizedTexts* Task = UGridlyTask_DownloadLocalizedTexts::DownloadLocalizedTexts(nullptr);
+            Task->OnSuccessDelegate.BindLambda([](const TArray<FPolyglotTextData>& PolyglotTextDatas)
+            {
+                UGridlyBPFunctionLibrary::UpdateLocalizationPreview(PolyglotTextDatas);
+            });
+            Task->OnFailDelegate.BindLambda([](const TArray<FPolyglotTextData>& PolyglotTextDatas, const FGridlyResult& Error)
+            {
+                UE_LOG(LogGridly, Warning, TEXT("Live preview refresh failed, keeping cached texts: %s"), *Error.Message);
+            });
+            Task->Activate();
+        }
+    }
+#endif
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FGridlyModule, Gridly)
@@ -10,4 +10,7 @@ class FGridlyModule : public IModuleInterface
 public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+private:
+    void OnPostEngineInit();
 };
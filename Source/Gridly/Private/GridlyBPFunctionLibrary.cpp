@@ -2,6 +2,7 @@
 
 #include "GridlyBPFunctionLibrary.h"
 
+#include "GridlyLivePreviewCache.h"
 #include "Internationalization/Culture.h"
 #include "Internationalization/Internationalization.h"
 #include "Internationalization/PolyglotTextData.h"
@@ -25,6 +26,72 @@ void UGridlyBPFunctionLibrary::EnableLocalizationPreview(const FString& Culture)
 
 void UGridlyBPFunctionLibrary::UpdateLocalizationPreview(const TArray<FPolyglotTextData>& PolyglotTextDatas)
 {
-	FTextLocalizationManager::Get().RegisterPolyglotTextData(PolyglotTextDatas);
+	FGridlyLivePreviewCache::Get().ApplyDataset(PolyglotTextDatas);
 	EnableLocalizationPreview(GetLocalizationPreviewCulture());
 }
+
+FGridlyDataset UGridlyBPFunctionLibrary::MakeGridlyDataset(const TArray<FGridlyTableRow>& GridlyTableRows)
+{
+	return FGridlyDataset(CopyTemp(GridlyTableRows));
+}
+
+int32 UGridlyBPFunctionLibrary::GetGridlyDatasetNum(const FGridlyDataset& Dataset)
+{
+	return Dataset.Num();
+}
+
+bool UGridlyBPFunctionLibrary::FindGridlyRecord(const FGridlyDataset& Dataset, const FString& RecordId, FGridlyTableRow& OutRow)
+{
+	if (const FGridlyTableRow* Row = Dataset.FindRow(RecordId))
+	{
+		OutRow = *Row;
+		return true;
+	}
+
+	return false;
+}
+
+bool UGridlyBPFunctionLibrary::FindGridlyCellValue(const FGridlyDataset& Dataset, const FString& RecordId, const FString& ColumnId,
+	FString& OutValue)
+{
+	if (const FGridlyTableCell* Cell = Dataset.FindCell(RecordId, ColumnId))
+	{
+		OutValue = Cell->Value;
+		return true;
+	}
+
+	return false;
+}
+
+TArray<FGridlyTableRow> UGridlyBPFunctionLibrary::FindGridlyRecordsByPath(const FGridlyDataset& Dataset, const FString& PathPrefix)
+{
+	const TConstArrayView<int32> RowIndices = Dataset.FindRowIndicesByPath(PathPrefix);
+
+	TArray<FGridlyTableRow> Rows;
+	Rows.Reserve(RowIndices.Num());
+	for (const int32 RowIndex : RowIndices)
+	{
+		Rows.Add(Dataset.GetRows()[RowIndex]);
+	}
+
+	return Rows;
+}
+
+TMap<FString, FString> UGridlyBPFunctionLibrary::GetGridlyColumnValues(const FGridlyDataset& Dataset, const FString& ColumnId)
+{
+	TMap<FString, FString> Values;
+
+	const int32 ColumnIndex = Dataset.FindColumnIndex(ColumnId);
+	if (ColumnIndex != INDEX_NONE)
+	{
+		for (int32 RowIndex = 0; RowIndex < Dataset.Num(); RowIndex++)
+		{
+			if (const FGridlyTableCell* Cell = Dataset.FindCell(RowIndex, ColumnIndex))
+			{
+				Values.Add(Dataset.GetRows()[RowIndex].Id, Cell->Value);
+			}
+		}
+	}
+
+	return Values;
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GridlyDataset.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 
 #include "GridlyBPFunctionLibrary.generated.h"
@@ -21,4 +22,25 @@ public:
 
 	UFUNCTION(Category = Gridly, BlueprintCallable)
 	static void UpdateLocalizationPreview(const TArray<FPolyglotTextData>& PolyglotTextDatas);
+
+	/** Builds the indices of the records, store the result in a variable rather than calling this per lookup */
+	UFUNCTION(Category = "Gridly|Dataset", BlueprintCallable)
+	static FGridlyDataset MakeGridlyDataset(const TArray<FGridlyTableRow>& GridlyTableRows);
+
+	UFUNCTION(Category = "Gridly|Dataset", BlueprintPure)
+	static int32 GetGridlyDatasetNum(const FGridlyDataset& Dataset);
+
+	UFUNCTION(Category = "Gridly|Dataset", BlueprintCallable)
+	static bool FindGridlyRecord(const FGridlyDataset& Dataset, const FString& RecordId, FGridlyTableRow& OutRow);
+
+	UFUNCTION(Category = "Gridly|Dataset", BlueprintPure)
+	static bool FindGridlyCellValue(const FGridlyDataset& Dataset, const FString& RecordId, const FString& ColumnId,
+		FString& OutValue);
+
+	UFUNCTION(Category = "Gridly|Dataset", BlueprintCallable)
+	static TArray<FGridlyTableRow> FindGridlyRecordsByPath(const FGridlyDataset& Dataset, const FString& PathPrefix);
+
+	/** Returns the values of a column for every record that has it, keyed by record ID */
+	UFUNCTION(Category = "Gridly|Dataset", BlueprintCallable)
+	static TMap<FString, FString> GetGridlyColumnValues(const FGridlyDataset& Dataset, const FString& ColumnId);
 };
@@ -0,0 +1,207 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyDataTableSnapshot.h"
+
+#include "Gridly.h"
+#include "GridlyDataTable.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Memory/MemoryView.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace GridlyDataTableSnapshot
+{
+	static const uint32 FileMagic = 0x47445453; // "GDTS"
+	static const int32 FileVersion = 1;
+}
+
+FString FGridlyDataTableSnapshot::GetSnapshotFilePath(const UGridlyDataTable& GridlyDataTable)
+{
+	const FString FileName = FPaths::MakeValidFileName(GridlyDataTable.GetPathName(), TEXT('_'));
+	return FPaths::ProjectSavedDir() / TEXT("Gridly") / TEXT("Snapshots") / FileName + TEXT(".bin");
+}
+
+bool FGridlyDataTableSnapshot::Save(const UGridlyDataTable& GridlyDataTable)
+{
+	UScriptStruct* RowStruct = GridlyDataTable.RowStruct;
+	if (!RowStruct)
+	{
+		return false;
+	}
+
+	// Write to a temporary file first so that a crash mid-write never leaves a truncated snapshot behind
+
+	const FString FilePath = GetSnapshotFilePath(GridlyDataTable);
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!FileWriter)
+		{
+			UE_LOG(LogGridly, Error, TEXT("Failed to write data table snapshot: %s"), *TempFilePath);
+			return false;
+		}
+
+		Write(*FileWriter, GridlyDataTable);
+
+		if (FileWriter->IsError() || !FileWriter->Close())
+		{
+			UE_LOG(LogGridly, Error, TEXT("Failed to write data table snapshot: %s"), *TempFilePath);
+			return false;
+		}
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempFilePath, true, true);
+}
+
+bool FGridlyDataTableSnapshot::Load(UGridlyDataTable& GridlyDataTable)
+{
+	const FString FilePath = GetSnapshotFilePath(GridlyDataTable);
+
+	// Memory map the snapshot where the platform supports it, so that nothing is copied before the rows are read
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+
+	if (MappedRegion)
+	{
+		FMemoryReaderView Reader(MakeMemoryView(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()));
+		return Read(Reader, GridlyDataTable, FilePath, true);
+	}
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+	return Read(Reader, GridlyDataTable, FilePath, true);
+}
+
+bool FGridlyDataTableSnapshot::SaveToMemory(const UGridlyDataTable& GridlyDataTable, TArray<uint8>& OutData)
+{
+	OutData.Reset();
+
+	if (!GridlyDataTable.RowStruct)
+	{
+		return false;
+	}
+
+	FMemoryWriter Writer(OutData);
+	Write(Writer, GridlyDataTable);
+	return !Writer.IsError();
+}
+
+bool FGridlyDataTableSnapshot::LoadFromMemory(UGridlyDataTable& GridlyDataTable, const TArray<uint8>& Data)
+{
+	FMemoryReader Reader(Data);
+	return Read(Reader, GridlyDataTable, GridlyDataTable.GetName(), false);
+}
+
+void FGridlyDataTableSnapshot::Write(FArchive& Writer, const UGridlyDataTable& GridlyDataTable)
+{
+	UScriptStruct* RowStruct = GridlyDataTable.RowStruct;
+
+	// Row names and object references are stored as strings, and rows as tagged properties, so that the
+	// snapshot survives changes to the row struct
+
+	FObjectAndNameAsStringProxyArchive ProxyWriter(Writer, false);
+
+	uint32 Magic = GridlyDataTableSnapshot::FileMagic;
+	int32 Version = GridlyDataTableSnapshot::FileVersion;
+	int64 SyncVersion = GridlyDataTable.SyncVersion;
+	FString StructPathName = RowStruct->GetPathName();
+	int32 NumRows = GridlyDataTable.GetRowMap().Num();
+	ProxyWriter << Magic << Version << SyncVersion << StructPathName << NumRows;
+
+	for (const TPair<FName, uint8*>& Row : GridlyDataTable.GetRowMap())
+	{
+		FName RowName = Row.Key;
+		ProxyWriter << RowName;
+		RowStruct->SerializeItem(ProxyWriter, Row.Value, nullptr);
+	}
+}
+
+bool FGridlyDataTableSnapshot::Read(FArchive& Reader, UGridlyDataTable& GridlyDataTable, const FString& SourceName,
+	const bool bRequireNewer)
+{
+	UScriptStruct* RowStruct = GridlyDataTable.RowStruct;
+	if (!RowStruct)
+	{
+		return false;
+	}
+
+	FObjectAndNameAsStringProxyArchive ProxyReader(Reader, false);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int64 SyncVersion = 0;
+	FString StructPathName;
+	int32 NumRows = 0;
+	ProxyReader << Magic << Version;
+
+	if (Magic != GridlyDataTableSnapshot::FileMagic || Version != GridlyDataTableSnapshot::FileVersion)
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Ignoring data table snapshot with unknown format: %s"), *SourceName);
+		return false;
+	}
+
+	ProxyReader << SyncVersion << StructPathName << NumRows;
+
+	if (bRequireNewer && SyncVersion <= GridlyDataTable.SyncVersion)
+	{
+		return false;
+	}
+
+	if (StructPathName != RowStruct->GetPathName() || NumRows < 0 || ProxyReader.IsError())
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Ignoring data table snapshot that does not match %s: %s"), *GridlyDataTable.GetName(),
+			*SourceName);
+		return false;
+	}
+
+	// Read all rows before touching the table, so that a damaged snapshot leaves the cooked rows intact
+
+	TArray<TPair<FName, uint8*>> Rows;
+	Rows.Reserve(NumRows);
+
+	for (int32 i = 0; i < NumRows && !ProxyReader.IsError(); i++)
+	{
+		FName RowName;
+		ProxyReader << RowName;
+
+		uint8* RowData = (uint8*) FMemory::Malloc(RowStruct->GetStructureSize());
+		RowStruct->InitializeStruct(RowData);
+		RowStruct->SerializeItem(ProxyReader, RowData, nullptr);
+		Rows.Emplace(RowName, RowData);
+	}
+
+	if (ProxyReader.IsError())
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Failed to read data table snapshot: %s"), *SourceName);
+
+		for (const TPair<FName, uint8*>& Row : Rows)
+		{
+			RowStruct->DestroyStruct(Row.Value);
+			FMemory::Free(Row.Value);
+		}
+		return false;
+	}
+
+	GridlyDataTable.EmptyTable();
+	for (const TPair<FName, uint8*>& Row : Rows)
+	{
+		GridlyDataTable.AddRowInternal(Row.Key, Row.Value);
+	}
+	GridlyDataTable.SyncVersion = SyncVersion;
+
+	UE_LOG(LogGridly, Log, TEXT("Applied data table snapshot with %d rows to %s"), Rows.Num(), *GridlyDataTable.GetName());
+	return true;
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyDataset.h"
+
+FGridlyDataset::FGridlyDataset(TArray<FGridlyTableRow>&& InRows)
+{
+	Build(MoveTemp(InRows));
+}
+
+void FGridlyDataset::Build(TArray<FGridlyTableRow>&& InRows)
+{
+	Rows = MoveTemp(InRows);
+	BuildIndices();
+}
+
+void FGridlyDataset::BuildIndices() const
+{
+	ResetIndices();
+	bIndexed = true;
+
+	RowIndexById.Reserve(Rows.Num());
+	AllRowIndices.Reserve(Rows.Num());
+
+	// Record IDs, columns and paths
+
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); RowIndex++)
+	{
+		const FGridlyTableRow& Row = Rows[RowIndex];
+
+		RowIndexById.FindOrAdd(Row.Id, RowIndex);
+		AllRowIndices.Add(RowIndex);
+
+		for (const FGridlyTableCell& Cell : Row.Cells)
+		{
+			if (!ColumnIndexById.Contains(Cell.ColumnId))
+			{
+				ColumnIndexById.Add(Cell.ColumnId, ColumnIds.Add(Cell.ColumnId));
+			}
+		}
+
+		if (!Row.Path.IsEmpty())
+		{
+			int32 SeparatorIndex = Row.Path.Find(TEXT("/"));
+			while (SeparatorIndex != INDEX_NONE)
+			{
+				RowIndicesByPath.FindOrAdd(Row.Path.Left(SeparatorIndex)).Add(RowIndex);
+				SeparatorIndex = Row.Path.Find(TEXT("/"), ESearchCase::IgnoreCase, ESearchDir::FromStart, SeparatorIndex + 1);
+			}
+			RowIndicesByPath.FindOrAdd(Row.Path).Add(RowIndex);
+		}
+	}
+
+	// Cell lookup matrix
+
+	const int32 NumColumns = ColumnIds.Num();
+	CellIndices.Init(INDEX_NONE, Rows.Num() * NumColumns);
+
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); RowIndex++)
+	{
+		const TArray<FGridlyTableCell>& Cells = Rows[RowIndex].Cells;
+		for (int32 CellIndex = 0; CellIndex < Cells.Num(); CellIndex++)
+		{
+			CellIndices[RowIndex * NumColumns + ColumnIndexById[Cells[CellIndex].ColumnId]] = CellIndex;
+		}
+	}
+}
+
+void FGridlyDataset::Reset()
+{
+	Rows.Reset();
+	ResetIndices();
+	bIndexed = true;
+}
+
+void FGridlyDataset::ResetIndices() const
+{
+	bIndexed = false;
+	ColumnIds.Reset();
+	RowIndexById.Reset();
+	ColumnIndexById.Reset();
+	RowIndicesByPath.Reset();
+	AllRowIndices.Reset();
+	CellIndices.Reset();
+}
+
+void FGridlyDataset::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		ResetIndices();
+	}
+}
+
+const TArray<FString>& FGridlyDataset::GetColumnIds() const
+{
+	EnsureIndices();
+	return ColumnIds;
+}
+
+int32 FGridlyDataset::FindRowIndex(const FString& RecordId) const
+{
+	EnsureIndices();
+	const int32* RowIndex = RowIndexById.Find(RecordId);
+	return RowIndex ? *RowIndex : INDEX_NONE;
+}
+
+int32 FGridlyDataset::FindColumnIndex(const FString& ColumnId) const
+{
+	EnsureIndices();
+	const int32* ColumnIndex = ColumnIndexById.Find(ColumnId);
+	return ColumnIndex ? *ColumnIndex : INDEX_NONE;
+}
+
+const FGridlyTableRow* FGridlyDataset::FindRow(const FString& RecordId) const
+{
+	const int32 RowIndex = FindRowIndex(RecordId);
+	return RowIndex != INDEX_NONE ? &Rows[RowIndex] : nullptr;
+}
+
+const FGridlyTableCell* FGridlyDataset::FindCell(const int32 RowIndex, const int32 ColumnIndex) const
+{
+	EnsureIndices();
+
+	if (!Rows.IsValidIndex(RowIndex) || !ColumnIds.IsValidIndex(ColumnIndex))
+	{
+		return nullptr;
+	}
+
+	const int32 CellIndex = CellIndices[RowIndex * ColumnIds.Num() + ColumnIndex];
+	return CellIndex != INDEX_NONE ? &Rows[RowIndex].Cells[CellIndex] : nullptr;
+}
+
+const FGridlyTableCell* FGridlyDataset::FindCell(const FString& RecordId, const FString& ColumnId) const
+{
+	return FindCell(FindRowIndex(RecordId), FindColumnIndex(ColumnId));
+}
+
+TConstArrayView<int32> FGridlyDataset::FindRowIndicesByPath(const FString& PathPrefix) const
+{
+	EnsureIndices();
+
+	if (PathPrefix.IsEmpty())
+	{
+		return AllRowIndices;
+	}
+
+	const TArray<int32>* RowIndices = RowIndicesByPath.Find(PathPrefix);
+	return RowIndices ? TConstArrayView<int32>(*RowIndices) : TConstArrayView<int32>();
+}
@@ -0,0 +1,249 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyLivePreviewCache.h"
+
+#include "Gridly.h"
+#include "GridlyGameSettings.h"
+#include "GridlyProfiling.h"
+#include "CoreGlobals.h"
+#include "HAL/FileManager.h"
+#include "Internationalization/TextLocalizationManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace GridlyLivePreviewCache
+{
+	static const uint32 FileMagic = 0x474C5043; // "GLPC"
+	static const int32 FileVersion = 1;
+}
+
+FGridlyLivePreviewCache& FGridlyLivePreviewCache::Get()
+{
+	static FGridlyLivePreviewCache Instance;
+	return Instance;
+}
+
+FString FGridlyLivePreviewCache::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Gridly") / TEXT("LivePreview.bin");
+}
+
+bool FGridlyLivePreviewCache::LoadFromFile(TArray<FPolyglotTextData>& OutPolyglotTextDatas) const
+{
+	const FString FilePath = GetCacheFilePath();
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumEntries = 0;
+	*Reader << Magic << Version << NumEntries;
+
+	if (Magic != GridlyLivePreviewCache::FileMagic || Version != GridlyLivePreviewCache::FileVersion || NumEntries < 0)
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Ignoring live preview cache with unknown format: %s"), *FilePath);
+		return false;
+	}
+
+	OutPolyglotTextDatas.Reset(NumEntries);
+
+	for (int32 i = 0; i < NumEntries && !Reader->IsError(); i++)
+	{
+		uint8 Category = 0;
+		FString Namespace, Key, NativeCulture, NativeString;
+		int32 NumLocalizedStrings = 0;
+		*Reader << Category << Namespace << Key << NativeCulture << NativeString << NumLocalizedStrings;
+
+		FPolyglotTextData& PolyglotTextData = OutPolyglotTextDatas.Emplace_GetRef(
+			static_cast<ELocalizedTextSourceCategory>(Category), Namespace, Key, NativeString, NativeCulture);
+
+		for (int32 j = 0; j < NumLocalizedStrings && !Reader->IsError(); j++)
+		{
+			FString Culture, LocalizedString;
+			*Reader << Culture << LocalizedString;
+			PolyglotTextData.AddLocalizedString(Culture, LocalizedString);
+		}
+	}
+
+	if (Reader->IsError() || !Reader->Close())
+	{
+		UE_LOG(LogGridly, Warning, TEXT("Failed to read live preview cache: %s"), *FilePath);
+		OutPolyglotTextDatas.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FGridlyLivePreviewCache::SaveToFile(const TArray<FPolyglotTextData>& PolyglotTextDatas) const
+{
+	// Write to a temporary file first so that a crash mid-write never leaves a truncated cache behind
+
+	const FString FilePath = GetCacheFilePath();
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogGridly, Error, TEXT("Failed to write live preview cache: %s"), *TempFilePath);
+			return false;
+		}
+
+		uint32 Magic = GridlyLivePreviewCache::FileMagic;
+		int32 Version = GridlyLivePreviewCache::FileVersion;
+		int32 NumEntries = PolyglotTextDatas.Num();
+		*Writer << Magic << Version << NumEntries;
+
+		for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+		{
+			uint8 Category = static_cast<uint8>(PolyglotTextData.GetCategory());
+			FString Namespace = PolyglotTextData.GetNamespace();
+			FString Key = PolyglotTextData.GetKey();
+			FString NativeCulture = PolyglotTextData.GetNativeCulture();
+			FString NativeString = PolyglotTextData.GetNativeString();
+			TArray<FString> Cultures = PolyglotTextData.GetLocalizedCultures();
+			int32 NumLocalizedStrings = Cultures.Num();
+			*Writer << Category << Namespace << Key << NativeCulture << NativeString << NumLocalizedStrings;
+
+			for (FString& Culture : Cultures)
+			{
+				FString LocalizedString;
+				PolyglotTextData.GetLocalizedString(Culture, LocalizedString);
+				*Writer << Culture << LocalizedString;
+			}
+		}
+
+		if (Writer->IsError() || !Writer->Close())
+		{
+			UE_LOG(LogGridly, Error, TEXT("Failed to write live preview cache: %s"), *TempFilePath);
+			return false;
+		}
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempFilePath, true, true);
+}
+
+bool FGridlyLivePreviewCache::ApplyCachedDataset()
+{
+	TArray<FPolyglotTextData> PolyglotTextDatas;
+	if (!LoadFromFile(PolyglotTextDatas) || PolyglotTextDatas.Num() == 0)
+	{
+		return false;
+	}
+
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		AddAppliedText(PolyglotTextData, HashPolyglotTextData(PolyglotTextData));
+	}
+
+	FTextLocalizationManager::Get().RegisterPolyglotTextData(PolyglotTextDatas);
+
+	UE_LOG(LogGridly, Log, TEXT("Applied %d cached live preview texts from: %s"), PolyglotTextDatas.Num(), *GetCacheFilePath());
+	return true;
+}
+
+int32 FGridlyLivePreviewCache::ApplyDataset(const TArray<FPolyglotTextData>& PolyglotTextDatas)
+{
+	GRIDLY_TRACE_SCOPE("Gridly::ApplyLivePreview");
+	SCOPE_CYCLE_COUNTER(STAT_GridlyApplyLivePreview);
+	GRIDLY_ALLOCATION_SCOPE(ApplyLivePreview);
+
+	TArray<FPolyglotTextData> ChangedPolyglotTextDatas;
+	TSet<FString> Identities;
+	Identities.Reserve(PolyglotTextDatas.Num());
+
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		FString Identity = GetIdentity(PolyglotTextData);
+		const uint32 Hash = HashPolyglotTextData(PolyglotTextData);
+		const FAppliedText* AppliedText = AppliedTexts.Find(Identity);
+		if (!AppliedText || AppliedText->Hash != Hash)
+		{
+			AddAppliedText(PolyglotTextData, Hash);
+			ChangedPolyglotTextDatas.Add(PolyglotTextData);
+		}
+		Identities.Add(MoveTemp(Identity));
+	}
+
+	// Texts deleted in Gridly are registered again without their translations, before the new set is registered
+
+	TArray<FPolyglotTextData> RemovedPolyglotTextDatas;
+	for (auto It = AppliedTexts.CreateIterator(); It; ++It)
+	{
+		if (!Identities.Contains(It.Key()))
+		{
+			const FAppliedText& AppliedText = It.Value();
+			RemovedPolyglotTextDatas.Emplace(AppliedText.Category, AppliedText.Namespace, AppliedText.Key, AppliedText.NativeString,
+				AppliedText.NativeCulture);
+			It.RemoveCurrent();
+		}
+	}
+
+	// Texts whose hash matches the one already applied are cache hits
+	FGridlyProfiling::AddCacheLookups(PolyglotTextDatas.Num() - ChangedPolyglotTextDatas.Num(), ChangedPolyglotTextDatas.Num());
+
+	if (RemovedPolyglotTextDatas.Num() > 0)
+	{
+		// Display strings are rebuilt so that the removed texts fall back to the localization resources of the game
+		FTextLocalizationManager::Get().RegisterPolyglotTextData(RemovedPolyglotTextDatas, false);
+		FTextLocalizationManager::Get().RefreshResources();
+	}
+
+	if (ChangedPolyglotTextDatas.Num() > 0)
+	{
+		FTextLocalizationManager::Get().RegisterPolyglotTextData(ChangedPolyglotTextDatas);
+	}
+
+	UE_LOG(LogGridly, Log, TEXT("Live preview updated: %d of %d texts changed, %d removed"), ChangedPolyglotTextDatas.Num(),
+		PolyglotTextDatas.Num(), RemovedPolyglotTextDatas.Num());
+
+	// The cache is only read by running development games, so previews in the editor, PIE and Shipping never write it
+#if !UE_BUILD_SHIPPING
+	if (GetDefault<UGridlyGameSettings>()->bCacheLivePreview && !GIsEditor && !GIsPlayInEditorWorld
+		&& (ChangedPolyglotTextDatas.Num() > 0 || RemovedPolyglotTextDatas.Num() > 0))
+	{
+		SaveToFile(PolyglotTextDatas);
+	}
+#endif
+
+	return ChangedPolyglotTextDatas.Num();
+}
+
+void FGridlyLivePreviewCache::AddAppliedText(const FPolyglotTextData& PolyglotTextData, const uint32 Hash)
+{
+	FAppliedText& AppliedText = AppliedTexts.FindOrAdd(GetIdentity(PolyglotTextData));
+	AppliedText.Hash = Hash;
+	AppliedText.Category = PolyglotTextData.GetCategory();
+	AppliedText.Namespace = PolyglotTextData.GetNamespace();
+	AppliedText.Key = PolyglotTextData.GetKey();
+	AppliedText.NativeCulture = PolyglotTextData.GetNativeCulture();
+	AppliedText.NativeString = PolyglotTextData.GetNativeString();
+}
+
+uint32 FGridlyLivePreviewCache::HashPolyglotTextData(const FPolyglotTextData& PolyglotTextData)
+{
+	uint32 Hash = FCrc::StrCrc32(*PolyglotTextData.GetNativeString());
+	Hash = HashCombine(Hash, FCrc::StrCrc32(*PolyglotTextData.GetNativeCulture()));
+
+	TArray<FString> Cultures = PolyglotTextData.GetLocalizedCultures();
+	Cultures.Sort();
+
+	for (const FString& Culture : Cultures)
+	{
+		FString LocalizedString;
+		PolyglotTextData.GetLocalizedString(Culture, LocalizedString);
+		Hash = HashCombine(Hash, FCrc::StrCrc32(*Culture));
+		Hash = HashCombine(Hash, FCrc::StrCrc32(*LocalizedString));
+	}
+
+	return Hash;
+}
+
+FString FGridlyLivePreviewCache::GetIdentity(const FPolyglotTextData& PolyglotTextData)
+{
+	return PolyglotTextData.GetNamespace() + TEXT(",") + PolyglotTextData.GetKey();
+}
@@ -0,0 +1,611 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyProfiling.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/MemoryBase.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+#include <atomic>
+
+UE_TRACE_CHANNEL_DEFINE(GridlyChannel);
+
+LLM_DEFINE_TAG(Gridly);
+
+DEFINE_STAT(STAT_GridlyDecodePages);
+DEFINE_STAT(STAT_GridlyConvertRows);
+DEFINE_STAT(STAT_GridlyWritePoFiles);
+DEFINE_STAT(STAT_GridlyImportDataTables);
+DEFINE_STAT(STAT_GridlySerializeExports);
+DEFINE_STAT(STAT_GridlyDiffRecords);
+DEFINE_STAT(STAT_GridlyApplyLivePreview);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Records"), STAT_GridlyRecords, STATGROUP_Gridly);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Records per Second"), STAT_GridlyRecordsPerSecond, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Bytes Sent"), STAT_GridlyBytesSent, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Bytes Received"), STAT_GridlyBytesReceived, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Requests"), STAT_GridlyActiveRequests, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Requests"), STAT_GridlyQueuedRequests, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache Hits"), STAT_GridlyCacheHits, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache Misses"), STAT_GridlyCacheMisses, STATGROUP_Gridly);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Decode Pages Allocations"), STAT_GridlyDecodePagesAllocations, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Convert Rows Allocations"), STAT_GridlyConvertRowsAllocations, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Write PO Files Allocations"), STAT_GridlyWritePoFilesAllocations, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import Data Tables Allocations"), STAT_GridlyImportDataTablesAllocations, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Serialize Exports Allocations"), STAT_GridlySerializeExportsAllocations, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Diff Records Allocations"), STAT_GridlyDiffRecordsAllocations, STATGROUP_Gridly);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Apply Live Preview Allocations"), STAT_GridlyApplyLivePreviewAllocations, STATGROUP_Gridly);
+
+TRACE_DECLARE_INT_COUNTER(GridlyBytesSent, TEXT("Gridly/BytesSent"));
+TRACE_DECLARE_INT_COUNTER(GridlyBytesReceived, TEXT("Gridly/BytesReceived"));
+TRACE_DECLARE_INT_COUNTER(GridlyRecords, TEXT("Gridly/Records"));
+TRACE_DECLARE_INT_COUNTER(GridlyRequestsInFlight, TEXT("Gridly/RequestsInFlight"));
+
+namespace GridlyProfiling
+{
+	/** Requests are queued, sent and completed on the game thread */
+	static TSet<const IHttpRequest*> QueuedRequests;
+	static int32 NumActiveRequests = 0;
+
+	/** Records added since the start of the current one second window of the records per second stat */
+	static int32 WindowRecords = 0;
+	static double WindowStartSeconds = 0.0;
+
+	/** Oldest timings are dropped beyond this, so that a long session does not grow without bounds */
+	static const int32 MaxTimings = 10000;
+
+	static TMap<const IHttpRequest*, double> QueuedSeconds;
+	static TMap<const IHttpRequest*, FGridlyRequestTiming> TimingsInFlight;
+	static TArray<FGridlyRequestTiming> Timings;
+
+	/** Completed requests that may still report decode time, by their index in Timings plus NumDroppedTimings */
+	static TMap<const IHttpRequest*, int64> CompletedTimingIds;
+	static int64 NumDroppedTimings = 0;
+
+	static FString GetEndpoint(const IHttpRequest& Request)
+	{
+		// Drop the scheme, host and query, and the view ID, which differs between projects
+
+		FString Path = Request.GetURL();
+		const int32 SchemeEnd = Path.Find(TEXT("://"));
+		if (SchemeEnd != INDEX_NONE)
+		{
+			Path.RightChopInline(SchemeEnd + 3);
+		}
+
+		int32 PathStart;
+		Path = Path.FindChar(TEXT('/'), PathStart) ? Path.RightChop(PathStart + 1) : FString();
+
+		int32 QueryStart;
+		if (Path.FindChar(TEXT('?'), QueryStart))
+		{
+			Path.LeftInline(QueryStart);
+		}
+
+		TArray<FString> Segments;
+		Path.ParseIntoArray(Segments, TEXT("/"));
+		for (int32 i = 1; i < Segments.Num(); i++)
+		{
+			if (Segments[i - 1] == TEXT("views"))
+			{
+				Segments[i] = TEXT("{viewId}");
+			}
+		}
+
+		return Request.GetVerb() + TEXT(" ") + FString::Join(Segments, TEXT("/"));
+	}
+
+	static FGridlyLatencyPercentiles GetPercentiles(TArray<double>& Values)
+	{
+		FGridlyLatencyPercentiles Percentiles;
+		if (Values.Num() == 0)
+		{
+			return Percentiles;
+		}
+
+		// Nearest rank
+		Values.Sort();
+		auto GetPercentile = [&Values](const double Percentile)
+		{
+			const int32 Rank = FMath::CeilToInt(Percentile * Values.Num());
+			return Values[FMath::Clamp(Rank - 1, 0, Values.Num() - 1)];
+		};
+
+		Percentiles.P50 = GetPercentile(0.50);
+		Percentiles.P95 = GetPercentile(0.95);
+		Percentiles.P99 = GetPercentile(0.99);
+		return Percentiles;
+	}
+
+	/** Allocations of each thread, counted by FCountingMalloc */
+	static thread_local int64 ThreadNumAllocations = 0;
+	static thread_local int64 ThreadNumBytes = 0;
+
+	static std::atomic<bool> bCountingAllocations(false);
+
+	/** Stage totals are added to from the threads that run the stages */
+	static std::atomic<int64> StageNumAllocations[static_cast<int32>(EGridlyStage::Num)];
+	static std::atomic<int64> StageNumBytes[static_cast<int32>(EGridlyStage::Num)];
+
+	/**
+	 * Forwards everything to the allocator it wraps, counting allocations and reallocations on the calling thread. It never
+	 * owns memory itself, so memory allocated before it was installed is freed correctly through it
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInnerMalloc) :
+			InnerMalloc(InInnerMalloc)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			AddAllocation(Count);
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			AddAllocation(Count);
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* MallocZeroed(SIZE_T Count, uint32 Alignment) override
+		{
+			AddAllocation(Count);
+			return InnerMalloc->MallocZeroed(Count, Alignment);
+		}
+
+		virtual void* TryMallocZeroed(SIZE_T Count, uint32 Alignment) override
+		{
+			AddAllocation(Count);
+			return InnerMalloc->TryMallocZeroed(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			AddAllocation(Count);
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			AddAllocation(Count);
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual void InitializeStatsMetadata() override
+		{
+			InnerMalloc->InitializeStatsMetadata();
+		}
+
+		virtual void UpdateStats() override
+		{
+			InnerMalloc->UpdateStats();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+		{
+			InnerMalloc->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+		{
+			InnerMalloc->DumpAllocatorStats(Ar);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return InnerMalloc->ValidateHeap();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return InnerMalloc->GetDescriptiveName();
+		}
+
+		virtual void OnMallocInitialized() override
+		{
+			InnerMalloc->OnMallocInitialized();
+		}
+
+		virtual void OnPreFork() override
+		{
+			InnerMalloc->OnPreFork();
+		}
+
+		virtual void OnPostFork() override
+		{
+			InnerMalloc->OnPostFork();
+		}
+
+	private:
+		static void AddAllocation(const SIZE_T Count)
+		{
+			// Reallocations to zero bytes are frees
+			if (Count > 0)
+			{
+				ThreadNumAllocations++;
+				ThreadNumBytes += Count;
+			}
+		}
+
+		FMalloc* InnerMalloc;
+	};
+
+	static void AddStageAllocationStat(const EGridlyStage Stage, const int64 NumAllocations)
+	{
+		switch (Stage)
+		{
+			case EGridlyStage::DecodePages: INC_DWORD_STAT_BY(STAT_GridlyDecodePagesAllocations, NumAllocations); break;
+			case EGridlyStage::ConvertRows: INC_DWORD_STAT_BY(STAT_GridlyConvertRowsAllocations, NumAllocations); break;
+			case EGridlyStage::WritePoFiles: INC_DWORD_STAT_BY(STAT_GridlyWritePoFilesAllocations, NumAllocations); break;
+			case EGridlyStage::ImportDataTables: INC_DWORD_STAT_BY(STAT_GridlyImportDataTablesAllocations, NumAllocations); break;
+			case EGridlyStage::SerializeExports: INC_DWORD_STAT_BY(STAT_GridlySerializeExportsAllocations, NumAllocations); break;
+			case EGridlyStage::DiffRecords: INC_DWORD_STAT_BY(STAT_GridlyDiffRecordsAllocations, NumAllocations); break;
+			case EGridlyStage::ApplyLivePreview: INC_DWORD_STAT_BY(STAT_GridlyApplyLivePreviewAllocations, NumAllocations); break;
+			default: break;
+		}
+	}
+
+	static TSharedRef<FJsonObject> PercentilesToJson(const FGridlyLatencyPercentiles& Percentiles)
+	{
+		const TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+		JsonObject->SetNumberField(TEXT("p50"), Percentiles.P50);
+		JsonObject->SetNumberField(TEXT("p95"), Percentiles.P95);
+		JsonObject->SetNumberField(TEXT("p99"), Percentiles.P99);
+		return JsonObject;
+	}
+}
+
+FGridlyProfiling::FDecodeScope::FDecodeScope(const FHttpRequestPtr& InRequest) :
+	Request(InRequest),
+	StartSeconds(FPlatformTime::Seconds())
+{
+}
+
+FGridlyProfiling::FDecodeScope::~FDecodeScope()
+{
+	AddDecodeTime(Request, FPlatformTime::Seconds() - StartSeconds);
+}
+
+FGridlyProfiling::FAllocationScope::FAllocationScope(const EGridlyStage InStage) :
+	Stage(InStage),
+	StartCount(GetThreadAllocationCount())
+{
+}
+
+FGridlyProfiling::FAllocationScope::~FAllocationScope()
+{
+	if (!IsCountingAllocations())
+	{
+		return;
+	}
+
+	const FGridlyAllocationCount Count = GetThreadAllocationCount() - StartCount;
+	GridlyProfiling::StageNumAllocations[static_cast<int32>(Stage)] += Count.NumAllocations;
+	GridlyProfiling::StageNumBytes[static_cast<int32>(Stage)] += Count.NumBytes;
+	GridlyProfiling::AddStageAllocationStat(Stage, Count.NumAllocations);
+}
+
+void FGridlyProfiling::OnRequestQueued(const IHttpRequest& Request)
+{
+	bool bAlreadyQueued = false;
+	GridlyProfiling::QueuedRequests.Add(&Request, &bAlreadyQueued);
+	if (!bAlreadyQueued)
+	{
+		INC_DWORD_STAT(STAT_GridlyQueuedRequests);
+		GridlyProfiling::QueuedSeconds.Add(&Request, FPlatformTime::Seconds());
+	}
+}
+
+void FGridlyProfiling::OnRequestDropped(const IHttpRequest& Request)
+{
+	if (GridlyProfiling::QueuedRequests.Remove(&Request) > 0)
+	{
+		DEC_DWORD_STAT(STAT_GridlyQueuedRequests);
+	}
+	GridlyProfiling::QueuedSeconds.Remove(&Request);
+}
+
+void FGridlyProfiling::OnRequestStarted(IHttpRequest& Request)
+{
+	FGridlyRequestTiming& Timing = GridlyProfiling::TimingsInFlight.Add(&Request);
+	Timing.Endpoint = GridlyProfiling::GetEndpoint(Request);
+	Timing.BytesSent = Request.GetContentLength();
+	Timing.StartSeconds = FPlatformTime::Seconds();
+	const double* QueuedSeconds = GridlyProfiling::QueuedSeconds.Find(&Request);
+	Timing.QueuedSeconds = QueuedSeconds ? *QueuedSeconds : Timing.StartSeconds;
+
+	// The HTTP module has no time to first byte, the first header is the closest to it. Headers are received on the game
+	// thread, so this is accurate to a tick of the HTTP manager
+
+	Request.OnHeaderReceived().BindLambda([](FHttpRequestPtr HeaderRequest, const FString&, const FString&)
+	{
+		FGridlyRequestTiming* HeaderTiming = GridlyProfiling::TimingsInFlight.Find(HeaderRequest.Get());
+		if (HeaderTiming && HeaderTiming->FirstByteSeconds == 0.0)
+		{
+			HeaderTiming->FirstByteSeconds = FPlatformTime::Seconds();
+		}
+	});
+
+	OnRequestDropped(Request);
+
+	GridlyProfiling::NumActiveRequests++;
+	INC_DWORD_STAT(STAT_GridlyActiveRequests);
+	INC_DWORD_STAT_BY(STAT_GridlyBytesSent, Request.GetContentLength());
+
+	TRACE_COUNTER_ADD(GridlyBytesSent, Request.GetContentLength());
+	TRACE_COUNTER_INCREMENT(GridlyRequestsInFlight);
+}
+
+void FGridlyProfiling::OnRequestCompleted(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response)
+{
+	if (Response.IsValid())
+	{
+		INC_DWORD_STAT_BY(STAT_GridlyBytesReceived, Response->GetContent().Num());
+		TRACE_COUNTER_ADD(GridlyBytesReceived, Response->GetContent().Num());
+	}
+
+	FGridlyRequestTiming Timing;
+	if (Request.IsValid() && GridlyProfiling::TimingsInFlight.RemoveAndCopyValue(Request.Get(), Timing))
+	{
+		Timing.CompleteSeconds = FPlatformTime::Seconds();
+		if (Timing.FirstByteSeconds == 0.0)
+		{
+			Timing.FirstByteSeconds = Timing.CompleteSeconds;
+		}
+		if (Response.IsValid())
+		{
+			Timing.ResponseCode = Response->GetResponseCode();
+			Timing.BytesReceived = Response->GetContent().Num();
+		}
+
+		if (GridlyProfiling::Timings.Num() >= GridlyProfiling::MaxTimings)
+		{
+			const int32 NumDropped = GridlyProfiling::MaxTimings / 10;
+			GridlyProfiling::Timings.RemoveAt(0, NumDropped);
+			GridlyProfiling::NumDroppedTimings += NumDropped;
+
+			for (auto It = GridlyProfiling::CompletedTimingIds.CreateIterator(); It; ++It)
+			{
+				if (It.Value() < GridlyProfiling::NumDroppedTimings)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		GridlyProfiling::CompletedTimingIds.Add(Request.Get(), GridlyProfiling::NumDroppedTimings + GridlyProfiling::Timings.Num());
+		GridlyProfiling::Timings.Add(MoveTemp(Timing));
+	}
+
+	GridlyProfiling::NumActiveRequests = FMath::Max(0, GridlyProfiling::NumActiveRequests - 1);
+	DEC_DWORD_STAT(STAT_GridlyActiveRequests);
+	TRACE_COUNTER_DECREMENT(GridlyRequestsInFlight);
+
+	// Nothing is decoded once the last request has completed, so the rate does not keep showing the last window
+
+	if (GridlyProfiling::NumActiveRequests == 0 && GridlyProfiling::QueuedRequests.Num() == 0)
+	{
+		SET_FLOAT_STAT(STAT_GridlyRecordsPerSecond, 0.f);
+		GridlyProfiling::WindowRecords = 0;
+		GridlyProfiling::WindowStartSeconds = 0.0;
+	}
+}
+
+void FGridlyProfiling::AddRecords(const int32 NumRecords)
+{
+	INC_DWORD_STAT_BY(STAT_GridlyRecords, NumRecords);
+	TRACE_COUNTER_ADD(GridlyRecords, NumRecords);
+
+	const double Now = FPlatformTime::Seconds();
+	if (GridlyProfiling::WindowStartSeconds == 0.0)
+	{
+		GridlyProfiling::WindowStartSeconds = Now;
+	}
+	GridlyProfiling::WindowRecords += NumRecords;
+
+	const double WindowSeconds = Now - GridlyProfiling::WindowStartSeconds;
+	if (WindowSeconds >= 1.0)
+	{
+		SET_FLOAT_STAT(STAT_GridlyRecordsPerSecond, GridlyProfiling::WindowRecords / WindowSeconds);
+		GridlyProfiling::WindowRecords = 0;
+		GridlyProfiling::WindowStartSeconds = Now;
+	}
+}
+
+void FGridlyProfiling::AddCacheLookups(const int32 NumHits, const int32 NumMisses)
+{
+	INC_DWORD_STAT_BY(STAT_GridlyCacheHits, NumHits);
+	INC_DWORD_STAT_BY(STAT_GridlyCacheMisses, NumMisses);
+}
+
+void FGridlyProfiling::AddDecodeTime(const FHttpRequestPtr& Request, const double Seconds)
+{
+	const int64* TimingId = Request.IsValid() ? GridlyProfiling::CompletedTimingIds.Find(Request.Get()) : nullptr;
+	if (TimingId)
+	{
+		const int64 TimingIndex = *TimingId - GridlyProfiling::NumDroppedTimings;
+		if (GridlyProfiling::Timings.IsValidIndex(TimingIndex))
+		{
+			GridlyProfiling::Timings[TimingIndex].DecodeSeconds += Seconds;
+		}
+	}
+}
+
+TArray<FGridlyRequestTiming> FGridlyProfiling::GetRequestTimings(const double SinceSeconds)
+{
+	TArray<FGridlyRequestTiming> RequestTimings;
+	for (const FGridlyRequestTiming& Timing : GridlyProfiling::Timings)
+	{
+		if (Timing.QueuedSeconds >= SinceSeconds)
+		{
+			RequestTimings.Add(Timing);
+		}
+	}
+	return RequestTimings;
+}
+
+TArray<FGridlyEndpointStats> FGridlyProfiling::GetEndpointStats(const TArray<FGridlyRequestTiming>& Timings)
+{
+	TMap<FString, TArray<const FGridlyRequestTiming*>> TimingsByEndpoint;
+	for (const FGridlyRequestTiming& Timing : Timings)
+	{
+		TimingsByEndpoint.FindOrAdd(Timing.Endpoint).Add(&Timing);
+	}
+	TimingsByEndpoint.KeySort(TLess<FString>());
+
+	TArray<FGridlyEndpointStats> EndpointStats;
+	for (const TPair<FString, TArray<const FGridlyRequestTiming*>>& EndpointTimings : TimingsByEndpoint)
+	{
+		FGridlyEndpointStats& Stats = EndpointStats.AddDefaulted_GetRef();
+		Stats.Endpoint = EndpointTimings.Key;
+
+		TArray<double> QueueWaits, TimesToFirstByte, TransferTimes, DecodeTimes, TotalTimes;
+		for (const FGridlyRequestTiming* Timing : EndpointTimings.Value)
+		{
+			Stats.NumRequests++;
+			Stats.NumFailed += Timing->IsSuccess() ? 0 : 1;
+			Stats.BytesSent += Timing->BytesSent;
+			Stats.BytesReceived += Timing->BytesReceived;
+
+			QueueWaits.Add(Timing->GetQueueWait());
+			TimesToFirstByte.Add(Timing->GetTimeToFirstByte());
+			TransferTimes.Add(Timing->GetTransferTime());
+			DecodeTimes.Add(Timing->DecodeSeconds);
+			TotalTimes.Add(Timing->GetTotalTime());
+		}
+
+		Stats.QueueWait = GridlyProfiling::GetPercentiles(QueueWaits);
+		Stats.TimeToFirstByte = GridlyProfiling::GetPercentiles(TimesToFirstByte);
+		Stats.TransferTime = GridlyProfiling::GetPercentiles(TransferTimes);
+		Stats.DecodeTime = GridlyProfiling::GetPercentiles(DecodeTimes);
+		Stats.TotalTime = GridlyProfiling::GetPercentiles(TotalTimes);
+	}
+
+	return EndpointStats;
+}
+
+TSharedRef<FJsonObject> FGridlyProfiling::RequestTimingsToJson(const double SinceSeconds)
+{
+	const TArray<FGridlyRequestTiming> RequestTimings = GetRequestTimings(SinceSeconds);
+
+	TArray<TSharedPtr<FJsonValue>> EndpointValues;
+	for (const FGridlyEndpointStats& Stats : GetEndpointStats(RequestTimings))
+	{
+		const TSharedRef<FJsonObject> EndpointObject = MakeShareable(new FJsonObject);
+		EndpointObject->SetStringField(TEXT("endpoint"), Stats.Endpoint);
+		EndpointObject->SetNumberField(TEXT("requests"), Stats.NumRequests);
+		EndpointObject->SetNumberField(TEXT("failed"), Stats.NumFailed);
+		EndpointObject->SetNumberField(TEXT("bytesSent"), Stats.BytesSent);
+		EndpointObject->SetNumberField(TEXT("bytesReceived"), Stats.BytesReceived);
+		EndpointObject->SetObjectField(TEXT("queueWaitSeconds"), GridlyProfiling::PercentilesToJson(Stats.QueueWait));
+		EndpointObject->SetObjectField(TEXT("timeToFirstByteSeconds"), GridlyProfiling::PercentilesToJson(Stats.TimeToFirstByte));
+		EndpointObject->SetObjectField(TEXT("transferSeconds"), GridlyProfiling::PercentilesToJson(Stats.TransferTime));
+		EndpointObject->SetObjectField(TEXT("decodeSeconds"), GridlyProfiling::PercentilesToJson(Stats.DecodeTime));
+		EndpointObject->SetObjectField(TEXT("totalSeconds"), GridlyProfiling::PercentilesToJson(Stats.TotalTime));
+		EndpointValues.Add(MakeShareable(new FJsonValueObject(EndpointObject)));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> RequestValues;
+	for (const FGridlyRequestTiming& Timing : RequestTimings)
+	{
+		const TSharedRef<FJsonObject> RequestObject = MakeShareable(new FJsonObject);
+		RequestObject->SetStringField(TEXT("endpoint"), Timing.Endpoint);
+		RequestObject->SetNumberField(TEXT("status"), Timing.ResponseCode);
+		RequestObject->SetNumberField(TEXT("bytesSent"), Timing.BytesSent);
+		RequestObject->SetNumberField(TEXT("bytesReceived"), Timing.BytesReceived);
+		RequestObject->SetNumberField(TEXT("queuedAt"), Timing.QueuedSeconds - SinceSeconds);
+		RequestObject->SetNumberField(TEXT("startedAt"), Timing.StartSeconds - SinceSeconds);
+		RequestObject->SetNumberField(TEXT("firstByteAt"), Timing.FirstByteSeconds - SinceSeconds);
+		RequestObject->SetNumberField(TEXT("completedAt"), Timing.CompleteSeconds - SinceSeconds);
+		RequestObject->SetNumberField(TEXT("decodeSeconds"), Timing.DecodeSeconds);
+		RequestValues.Add(MakeShareable(new FJsonValueObject(RequestObject)));
+	}
+
+	const TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetArrayField(TEXT("endpoints"), EndpointValues);
+	JsonObject->SetArrayField(TEXT("requests"), RequestValues);
+	return JsonObject;
+}
+
+void FGridlyProfiling::ResetRequestTimings()
+{
+	GridlyProfiling::Timings.Reset();
+	GridlyProfiling::CompletedTimingIds.Reset();
+	GridlyProfiling::NumDroppedTimings = 0;
+}
+
+void FGridlyProfiling::EnableAllocationCounting()
+{
+	check(IsInGameThread());
+
+	if (!GridlyProfiling::bCountingAllocations.exchange(true))
+	{
+		// Never deleted, other threads may still be calling into it
+		GMalloc = new GridlyProfiling::FCountingMalloc(GMalloc);
+	}
+}
+
+bool FGridlyProfiling::IsCountingAllocations()
+{
+	return GridlyProfiling::bCountingAllocations;
+}
+
+FGridlyAllocationCount FGridlyProfiling::GetThreadAllocationCount()
+{
+	return { GridlyProfiling::ThreadNumAllocations, GridlyProfiling::ThreadNumBytes };
+}
+
+FGridlyAllocationCount FGridlyProfiling::GetStageAllocationCount(const EGridlyStage Stage)
+{
+	return { GridlyProfiling::StageNumAllocations[static_cast<int32>(Stage)], GridlyProfiling::StageNumBytes[static_cast<int32>(Stage)] };
+}
+
+void FGridlyProfiling::ResetStageAllocationCounts()
+{
+	for (int32 i = 0; i < static_cast<int32>(EGridlyStage::Num); i++)
+	{
+		GridlyProfiling::StageNumAllocations[i] = 0;
+		GridlyProfiling::StageNumBytes[i] = 0;
+	}
+}
@@ -5,9 +5,11 @@
 #include "Engine/EngineTypes.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "Containers/Ticker.h"
 #include "Gridly.h"
 #include "GridlyGameSettings.h"
 #include "GridlyLocalizedTextConverter.h"
+#include "GridlyProfiling.h"
 #include "GridlyTableRow.h"
 #include "HttpModule.h"
 #include "JsonObjectConverter.h"
@@ -28,6 +30,7 @@ void UGridlyTask_DownloadLocalizedTexts::Activate()
 
 	Limit = GameSettings->ImportMaxRecordsPerRequest;
 	TotalCount = 0;
+	ReceivedCount = 0;
 
 	ViewIds.Reset();
 	for (int i = 0; i < GameSettings->ImportFromViewIds.Num(); i++)
@@ -45,6 +48,8 @@ void UGridlyTask_DownloadLocalizedTexts::Activate()
 
 void UGridlyTask_DownloadLocalizedTexts::RequestPage(const int ViewIdIndex, const int Offset)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::RequestPage");
+
 	CurrentViewIdIndex = ViewIdIndex;
 	CurrentOffset = Offset;
 
@@ -69,9 +74,10 @@ void UGridlyTask_DownloadLocalizedTexts::RequestPage(const int ViewIdIndex, cons
 			FGenericPlatformHttp::UrlEncode(FString::Printf(TEXT("{\"offset\":%d,\"limit\":%d}"), Offset, Limit));
 
 		FStringFormatNamedArguments Args;
+		Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
 		Args.Add(TEXT("ViewId"), *ViewId);
 		Args.Add(TEXT("PaginationSettings"), *PaginationSettings);
-		const FString Url = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/records?page={PaginationSettings}"),
+		const FString Url = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}/records?page={PaginationSettings}"),
 			Args);
 
 		HttpRequest = FHttpModule::Get().CreateRequest();
@@ -88,23 +94,33 @@ void UGridlyTask_DownloadLocalizedTexts::RequestPage(const int ViewIdIndex, cons
 		if (OnProgressDelegate.IsBound())
 			OnProgressDelegate.Execute(PolyglotTextDatas, .1f);
 
-		// Throttles number of requests by sleeping between each
+		// Throttles number of requests by waiting between each
 
 		UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+		FGridlyProfiling::OnRequestQueued(*HttpRequest);
+
 		if (World)
 		{
 			FTimerHandle TimerHandle;
 			World->GetTimerManager().SetTimer(TimerHandle, [this, ViewId, Offset]()
 			{
+				FGridlyProfiling::OnRequestStarted(*HttpRequest);
 				HttpRequest->ProcessRequest();
 				UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
 			}, 1.f, false);
 		}
 		else
 		{
-			HttpRequest->ProcessRequest();
-			UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
-			FPlatformProcess::Sleep(1.f);
+			// Without a world (e.g. live preview refresh on startup or commandlets), throttle on the core ticker instead of blocking
+			// the thread, so that other downloads keep going in the meantime. Commandlets have to tick the core ticker
+
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, ViewId, Offset](float)
+			{
+				FGridlyProfiling::OnRequestStarted(*HttpRequest);
+				HttpRequest->ProcessRequest();
+				UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
+				return false;
+			}), 1.f);
 		}
 	}
 	else
@@ -118,14 +134,20 @@ void UGridlyTask_DownloadLocalizedTexts::RequestPage(const int ViewIdIndex, cons
 void UGridlyTask_DownloadLocalizedTexts::OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr,
 	FHttpResponsePtr HttpResponsePtr, bool bSuccess)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::OnPageResponse");
+	FGridlyProfiling::OnRequestCompleted(HttpRequestPtr, HttpResponsePtr);
+
 	if (bSuccess && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok)
 	{
 		// Header
 
-		TArray<FString> Headers = HttpResponsePtr->GetAllHeaders();
-		for (int i = 0; i < Headers.Num(); i++)
+		if (UE_LOG_ACTIVE(LogGridly, Verbose))
 		{
-			UE_LOG(LogGridly, Verbose, TEXT("%s"), *Headers[i]);
+			TArray<FString> Headers = HttpResponsePtr->GetAllHeaders();
+			for (int i = 0; i < Headers.Num(); i++)
+			{
+				UE_LOG(LogGridly, Verbose, TEXT("%s"), *Headers[i]);
+			}
 		}
 
 		// Convert from JSON to texts
@@ -136,15 +158,40 @@ void UGridlyTask_DownloadLocalizedTexts::OnProcessRequestComplete(FHttpRequestPt
 		TMap<FString, FPolyglotTextData> PolyglotTextDataMap;
 		TArray<FGridlyTableRow> TableRows;
 
-		if (FJsonObjectConverter::JsonArrayStringToUStruct(Content, &TableRows, 0, 0)
-		    && FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(TableRows, PolyglotTextDataMap))
+		bool bDecoded;
 		{
+			GRIDLY_TRACE_SCOPE("Gridly::DecodeJson");
+			SCOPE_CYCLE_COUNTER(STAT_GridlyDecodePages);
+			GRIDLY_ALLOCATION_SCOPE(DecodePages);
+			FGridlyProfiling::FDecodeScope DecodeScope(HttpRequestPtr);
+			bDecoded = FJsonObjectConverter::JsonArrayStringToUStruct(Content, &TableRows, 0, 0);
+		}
+
+		if (bDecoded && FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(TableRows, PolyglotTextDataMap))
+		{
+			FGridlyProfiling::AddRecords(TableRows.Num());
+
+			// The texts are moved out of the map rather than copied
 			TArray<FPolyglotTextData> CurrentPolyglotTextDatas;
-			PolyglotTextDataMap.GenerateValueArray(CurrentPolyglotTextDatas);
-			PolyglotTextDatas.Append(CurrentPolyglotTextDatas);
+			CurrentPolyglotTextDatas.Reserve(PolyglotTextDataMap.Num());
+			for (TPair<FString, FPolyglotTextData>& Pair : PolyglotTextDataMap)
+			{
+				CurrentPolyglotTextDatas.Add(MoveTemp(Pair.Value));
+			}
 
 			const int ViewIdTotalCount = FCString::Atoi(*HttpResponsePtr->GetHeader("X-Total-Count"));
 			TotalCount += CurrentOffset == 0 ? ViewIdTotalCount : 0;
+			ReceivedCount += TableRows.Num();
+
+			// Page events only carry this page, so listeners do not copy the accumulated texts on every page
+
+			// Blueprint page events share the pins of the other events, so the counts come through as the progress
+			OnPage.Broadcast(CurrentPolyglotTextDatas, TotalCount > 0 ? static_cast<float>(ReceivedCount) / TotalCount : 1.f,
+				FGridlyResult::Success);
+			if (OnPageDelegate.IsBound())
+				OnPageDelegate.Execute(CurrentPolyglotTextDatas, ReceivedCount, TotalCount);
+
+			PolyglotTextDatas.Append(MoveTemp(CurrentPolyglotTextDatas));
 			const float EstimatedProgressViewIds =
 				static_cast<float>(CurrentViewIdIndex) / static_cast<float>(FMath::Max(1, ViewIds.Num()));
 			const float EstimatedProgressPagination = static_cast<float>(PolyglotTextDatas.Num()) / static_cast<float>(TotalCount);
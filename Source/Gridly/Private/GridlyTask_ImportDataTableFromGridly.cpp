@@ -2,18 +2,123 @@
 
 #include "GridlyTask_ImportDataTableFromGridly.h"
 
+#include "Algo/StableSort.h"
+#include "Async/Async.h"
 #include "Engine/EngineTypes.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "Containers/Ticker.h"
 #include "GridlyDataTableImporterJSON.h"
+#include "GridlyDataTableSnapshot.h"
 #include "Gridly.h"
 #include "GridlyGameSettings.h"
+#include "GridlyProfiling.h"
 #include "GridlyTableRow.h"
 #include "HttpModule.h"
 #include "JsonObjectConverter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "GenericPlatform/GenericPlatformHttp.h"
 #include "Runtime/Online/HTTP/Public/Interfaces/IHttpResponse.h"
 
+namespace GridlyImportDataTable
+{
+	bool DecodePage(FString& Content, TArray<FGridlyTableRow>& OutTableRows)
+	{
+		GRIDLY_TRACE_SCOPE("Gridly::DecodePage");
+		SCOPE_CYCLE_COUNTER(STAT_GridlyDecodePages);
+		GRIDLY_ALLOCATION_SCOPE(DecodePages);
+
+#if HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
+		// Convert any arrays that are in the json into a single string that can then be loaded 
+		// into the FGridlyTableCell's value within the JsonArrayStringToUStruct call.
+		// When the FGridlyDataTableImporterJSON comes to actually load it, it will read it as a array
+		// and so be able to load it into a array/set
+		FRegexPattern Pattern(TEXT("\"value\":(\\[.*?\"\\])"), ERegexPatternFlags::CaseInsensitive);
+		FRegexMatcher Matcher(Pattern, Content);
+
+		while (Matcher.FindNext())
+		{
+			FString ArrayContent = Matcher.GetCaptureGroup(1);
+			FString Replacement = TEXT("\"") + ArrayContent.Replace(TEXT("\""), TEXT("\\\"")) + TEXT("\"");
+			Content.ReplaceInline(*ArrayContent, *Replacement);
+		}
+#endif //HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
+
+		return FJsonObjectConverter::JsonArrayStringToUStruct(Content, &OutTableRows, 0, 0);
+	}
+
+	void MergeViews(TArray<FGridlyTableRow>& TableRows, const TArray<int32>& RowViewIndices, const EGridlyViewMergeMode MergeMode)
+	{
+		GRIDLY_TRACE_SCOPE("Gridly::MergeViews");
+
+		// Pages of the views arrive interleaved, so rows are ordered by view first to let earlier views win on conflicts
+
+		TArray<int32> RowOrder;
+		RowOrder.Reserve(TableRows.Num());
+		for (int32 i = 0; i < TableRows.Num(); i++)
+		{
+			RowOrder.Add(i);
+		}
+		Algo::StableSortBy(RowOrder, [&RowViewIndices](const int32 RowIndex) { return RowViewIndices[RowIndex]; });
+
+		// Hash join on the record ID
+
+		TArray<FGridlyTableRow> MergedRows;
+		TMap<FString, int32> MergedRowIndexById;
+		MergedRows.Reserve(TableRows.Num());
+		MergedRowIndexById.Reserve(TableRows.Num());
+
+		for (const int32 RowIndex : RowOrder)
+		{
+			FGridlyTableRow& TableRow = TableRows[RowIndex];
+
+			const int32* MergedRowIndex = MergedRowIndexById.Find(TableRow.Id);
+			if (!MergedRowIndex)
+			{
+				MergedRowIndexById.Add(TableRow.Id, MergedRows.Num());
+				MergedRows.Add(MoveTemp(TableRow));
+				continue;
+			}
+
+			if (MergeMode == EGridlyViewMergeMode::Columns)
+			{
+				FGridlyTableRow& MergedRow = MergedRows[*MergedRowIndex];
+				if (MergedRow.Path.IsEmpty())
+				{
+					MergedRow.Path = MoveTemp(TableRow.Path);
+				}
+
+				for (FGridlyTableCell& Cell : TableRow.Cells)
+				{
+					if (!MergedRow.Cells.ContainsByPredicate([&Cell](const FGridlyTableCell& MergedCell)
+					{
+						return MergedCell.ColumnId == Cell.ColumnId;
+					}))
+					{
+						MergedRow.Cells.Add(MoveTemp(Cell));
+					}
+				}
+			}
+		}
+
+		TableRows = MoveTemp(MergedRows);
+	}
+
+	TSharedRef<FJsonObject> MakeRowObject(const FGridlyTableRow& TableRow)
+	{
+		const TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+		JsonObject->SetStringField("name", TableRow.Id);
+
+		for (int j = 0; j < TableRow.Cells.Num(); j++)
+		{
+			JsonObject->SetStringField("_path", TableRow.Path);
+			JsonObject->SetStringField(TableRow.Cells[j].ColumnId, TableRow.Cells[j].Value);
+		}
+
+		return JsonObject;
+	}
+}
+
 UGridlyTask_ImportDataTableFromGridly::UGridlyTask_ImportDataTableFromGridly()
 {
 	if (!HasAnyFlags(RF_ClassDefaultObject))
@@ -28,208 +133,587 @@ void UGridlyTask_ImportDataTableFromGridly::Activate()
 
 	Limit = GameSettings->ImportMaxRecordsPerRequest;
 	TotalCount = 0;
+	bFailed = false;
 
 	ViewIds.Reset();
 	if (GridlyDataTable && !GridlyDataTable->ViewId.IsEmpty())
 	{
 		ViewIds.Add(GridlyDataTable->ViewId);
+		for (const FString& AdditionalViewId : GridlyDataTable->AdditionalViewIds)
+		{
+			if (!AdditionalViewId.IsEmpty())
+			{
+				ViewIds.AddUnique(AdditionalViewId);
+			}
+		}
 	}
 
 	GridlyTableRows.Reset();
+	RowViewIndices.Reset();
+	RowObjects.Reset();
+	Dataset.Reset();
 
-	RequestPage(0, 0);
-}
-
-void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, const int Offset)
-{
-	CurrentViewIdIndex = ViewIdIndex;
-	CurrentOffset = Offset;
+	ViewColumnIds.Reset();
+	bHasViewSchema = false;
 
 	if (ViewIds.Num() == 0)
 	{
 		const FGridlyResult FailResult = FGridlyResult{"Unable to import data table: no view IDs were specified"};
 		UE_LOG(LogGridly, Error, TEXT("%s"), *FailResult.Message);
-		OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
-		if (OnFailDelegate.IsBound())
-			OnFailDelegate.Execute(GridlyTableRows, FailResult);
+		BroadcastFail(FailResult);
 		return;
 	}
 
-	if (ViewIdIndex < ViewIds.Num())
+	// The schemas of all views are requested at once, the records are only requested once all of them have arrived
+
+	bHasViewSchema = true;
+	NumPendingViews = ViewIds.Num();
+	for (int i = 0; i < ViewIds.Num(); i++)
 	{
-		const FString& ViewId = ViewIds[ViewIdIndex];
+		RequestViewSchema(i);
+	}
+}
 
-		const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-		const FString ApiKey = GameSettings->ImportApiKey;
+void UGridlyTask_ImportDataTableFromGridly::RequestViewSchema(const int ViewIdIndex)
+{
+	GRIDLY_TRACE_SCOPE("Gridly::RequestViewSchema");
 
-		const FString PaginationSettings = FGenericPlatformHttp::UrlEncode(FString::Printf(TEXT("{\"offset\":%d,\"limit\":%d}"),
-			Offset,
-			Limit));
+	const FString& ViewId = ViewIds[ViewIdIndex];
 
-		FStringFormatNamedArguments Args;
-		Args.Add(TEXT("ViewId"), *ViewId);
-		Args.Add(TEXT("PaginationSettings"), *PaginationSettings);
-		const FString Url = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/records?page={PaginationSettings}"),
-			Args);
+	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	const FString ApiKey = GameSettings->ImportApiKey;
 
-		HttpRequest = FHttpModule::Get().CreateRequest();
-		HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-		HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("ApiKey %s"), *ApiKey));
+	FStringFormatNamedArguments Args;
+	Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
+	Args.Add(TEXT("ViewId"), *ViewId);
+	const FString Url = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}"), Args);
 
-		HttpRequest->SetVerb(TEXT("GET"));
-		HttpRequest->SetURL(Url);
+	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("ApiKey %s"), *ApiKey));
 
-		HttpRequest->OnProcessRequestComplete().BindUObject(this, &UGridlyTask_ImportDataTableFromGridly::OnProcessRequestComplete);
+	HttpRequest->SetVerb(TEXT("GET"));
+	HttpRequest->SetURL(Url);
 
-		OnProgress.Broadcast(GridlyTableRows, .1f, FGridlyResult::Success);
-		if (OnProgressDelegate.IsBound())
-			OnProgressDelegate.Execute(GridlyTableRows, .1f);
+	HttpRequest->OnProcessRequestComplete().BindUObject(this,
+		&UGridlyTask_ImportDataTableFromGridly::OnViewSchemaRequestComplete, ViewIdIndex);
 
-		// Throttles number of requests by sleeping between each
+	FGridlyProfiling::OnRequestStarted(*HttpRequest);
+	HttpRequest->ProcessRequest();
+	UE_LOG(LogGridly, Log, TEXT("Requesting schema of view ID: %s"), *ViewId);
+}
+
+void UGridlyTask_ImportDataTableFromGridly::OnViewSchemaRequestComplete(FHttpRequestPtr HttpRequestPtr,
+	FHttpResponsePtr HttpResponsePtr, bool bSuccess, const int ViewIdIndex)
+{
+	GRIDLY_TRACE_SCOPE("Gridly::OnViewSchemaResponse");
+	FGridlyProfiling::OnRequestCompleted(HttpRequestPtr, HttpResponsePtr);
+
+	const TArray<TSharedPtr<FJsonValue>>* Columns = nullptr;
 
-		UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
-		if (World)
+	if (bSuccess && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok)
+	{
+		FGridlyProfiling::FDecodeScope DecodeScope(HttpRequestPtr);
+
+		TSharedPtr<FJsonObject> ViewObject;
+		const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(HttpResponsePtr->GetContentAsString());
+		if (FJsonSerializer::Deserialize(JsonReader, ViewObject) && ViewObject.IsValid())
 		{
-			FTimerHandle TimerHandle;
-			World->GetTimerManager().SetTimer(TimerHandle, [this, ViewId, Offset]()
-			{
-				HttpRequest->ProcessRequest();
-				UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
-			}, 1.f, false);
+			ViewObject->TryGetArrayField(TEXT("columns"), Columns);
 		}
-		else
+	}
+
+	if (Columns)
+	{
+		for (const TSharedPtr<FJsonValue>& Column : *Columns)
 		{
-			HttpRequest->ProcessRequest();
-			UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
-			FPlatformProcess::Sleep(1.f);
+			const TSharedPtr<FJsonObject>* ColumnObject = nullptr;
+			FString ColumnId;
+			if (Column->TryGetObject(ColumnObject) && (*ColumnObject)->TryGetStringField(TEXT("id"), ColumnId))
+			{
+				ViewColumnIds.AddUnique(ColumnId);
+			}
 		}
 	}
-	else
+	else if (bHasViewSchema)
 	{
-		TArray<TSharedPtr<FJsonValue>> JsonValues;
+		// The schema is only used to report problems early, so the import goes ahead and checks every row instead
 
-		for (int i = 0; i < GridlyTableRows.Num(); i++)
-		{
-			const TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-			JsonObject->SetStringField("name", GridlyTableRows[i].Id);
+		UE_LOG(LogGridly, Warning, TEXT("Unable to fetch the schema of view ID: %s, columns will be checked per row"),
+			*ViewIds[ViewIdIndex]);
+		bHasViewSchema = false;
+	}
 
-			for (int j = 0; j < GridlyTableRows[i].Cells.Num(); j++)
-			{
-				JsonObject->SetStringField("_path", GridlyTableRows[i].Path);
-				JsonObject->SetStringField(GridlyTableRows[i].Cells[j].ColumnId, GridlyTableRows[i].Cells[j].Value);
-			}
+	if (--NumPendingViews > 0)
+	{
+		return;
+	}
 
-			JsonValues.Add(MakeShareable(new FJsonValueObject(JsonObject)));
-		}
+	if (!bHasViewSchema)
+	{
+		ViewColumnIds.Reset();
+	}
+	else if (!ValidateViewSchema())
+	{
+		return;
+	}
 
-		GridlyDataTable->EmptyTable();
+	ViewDownloads.Init(FViewDownload(), ViewIds.Num());
+	NumPendingViews = ViewIds.Num();
+	for (int i = 0; i < ViewIds.Num(); i++)
+	{
+		RequestPage(i, 0);
+	}
+}
 
-		FString JsonString;
-		const TSharedRef<TJsonWriter<>> JsonWriter = TJsonStringWriter<>::Create(&JsonString);
-		FJsonSerializer::Serialize(JsonValues, JsonWriter);
+bool UGridlyTask_ImportDataTableFromGridly::ValidateViewSchema()
+{
+	// Report mismatches between the row struct and the view once per column, before any records are downloaded
 
-		TArray<FString> OutProblems;
-		if (FGridlyDataTableImporterJSON(*GridlyDataTable, JsonString, OutProblems).ReadTable())
-		{
-			UE_LOG(LogGridly, Log, TEXT("Imported data table from Gridly: %s"), *GridlyDataTable->GetName());
-			OnSuccess.Broadcast(GridlyTableRows, 1.f, FGridlyResult::Success);
-			if (OnSuccessDelegate.IsBound())
-				OnSuccessDelegate.Execute(GridlyTableRows);
-		}
-		else
+	TArray<FString> OutProblems;
+	const bool bValid = GridlyDataTable->RowStruct
+		&& FGridlyDataTableImporterJSON(*GridlyDataTable, OutProblems).BindColumns(ViewColumnIds);
+
+	for (int i = 0; i < OutProblems.Num(); i++)
+	{
+		UE_LOG(LogGridly, Warning, TEXT("%s"), *OutProblems[i]);
+	}
+
+	if (!bValid)
+	{
+		const FGridlyResult FailResult = FGridlyResult{"Unable to import data table: the row struct does not match the Gridly view"};
+		UE_LOG(LogGridly, Error, TEXT("%s"), *FailResult.Message);
+		BroadcastFail(FailResult);
+	}
+
+	return bValid;
+}
+
+void UGridlyTask_ImportDataTableFromGridly::RequestPage(const int ViewIdIndex, const int Offset)
+{
+	GRIDLY_TRACE_SCOPE("Gridly::RequestPage");
+
+	const FString& ViewId = ViewIds[ViewIdIndex];
+	ViewDownloads[ViewIdIndex].Offset = Offset;
+
+	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	const FString ApiKey = GameSettings->ImportApiKey;
+
+	const FString PaginationSettings = FGenericPlatformHttp::UrlEncode(FString::Printf(TEXT("{\"offset\":%d,\"limit\":%d}"),
+		Offset,
+		Limit));
+
+	FStringFormatNamedArguments Args;
+	Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
+	Args.Add(TEXT("ViewId"), *ViewId);
+	Args.Add(TEXT("PaginationSettings"), *PaginationSettings);
+	const FString Url = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}/records?page={PaginationSettings}"),
+		Args);
+
+	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("ApiKey %s"), *ApiKey));
+
+	HttpRequest->SetVerb(TEXT("GET"));
+	HttpRequest->SetURL(Url);
+
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UGridlyTask_ImportDataTableFromGridly::OnProcessRequestComplete,
+		ViewIdIndex);
+
+	OnProgress.Broadcast(GridlyTableRows, .1f, FGridlyResult::Success);
+	if (OnProgressDelegate.IsBound())
+		OnProgressDelegate.Execute(GridlyTableRows, .1f);
+
+	// Throttles number of requests by waiting between each. Every view has its own chain of page requests
+
+	UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	FGridlyProfiling::OnRequestQueued(*HttpRequest);
+
+	if (World)
+	{
+		FTimerHandle TimerHandle;
+		World->GetTimerManager().SetTimer(TimerHandle, [this, HttpRequest, ViewId, Offset]()
 		{
-			for (int i = 0; i < OutProblems.Num(); i++)
-			{
-				UE_LOG(LogGridly, Error, TEXT("%s"), *OutProblems[i]);
-			}
+			FGridlyProfiling::OnRequestStarted(*HttpRequest);
+			HttpRequest->ProcessRequest();
+			UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
+		}, 1.f, false);
+	}
+	else
+	{
+		// Without a world (e.g. imports from the editor, runtime refreshes or commandlets), throttle on the core ticker instead of
+		// blocking the thread, so that the page chains of all views wait at the same time. Commandlets have to tick the core ticker
 
-			const FGridlyResult FailResult = FGridlyResult{"Failed to parse downloaded content"};
-			OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
-			if (OnFailDelegate.IsBound())
-				OnFailDelegate.Execute(GridlyTableRows, FailResult);
-		}
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, HttpRequest, ViewId, Offset](float)
+		{
+			FGridlyProfiling::OnRequestStarted(*HttpRequest);
+			HttpRequest->ProcessRequest();
+			UE_LOG(LogGridly, Log, TEXT("Requesting view ID: %s, with offset: %d, limit: %d"), *ViewId, Offset, Limit);
+			return false;
+		}), 1.f);
 	}
 }
 
 void UGridlyTask_ImportDataTableFromGridly::OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr,
-	FHttpResponsePtr HttpResponsePtr, bool bSuccess)
+	FHttpResponsePtr HttpResponsePtr, bool bSuccess, const int ViewIdIndex)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::OnPageResponse");
+	FGridlyProfiling::OnRequestCompleted(HttpRequestPtr, HttpResponsePtr);
+
+	if (bFailed)
+	{
+		return;
+	}
+
 	if (bSuccess && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok)
 	{
 		// Header
 
-		TArray<FString> Headers = HttpResponsePtr->GetAllHeaders();
-		for (int i = 0; i < Headers.Num(); i++)
+		if (UE_LOG_ACTIVE(LogGridly, Verbose))
 		{
-			UE_LOG(LogGridly, Verbose, TEXT("%s"), *Headers[i]);
+			TArray<FString> Headers = HttpResponsePtr->GetAllHeaders();
+			for (int i = 0; i < Headers.Num(); i++)
+			{
+				UE_LOG(LogGridly, Verbose, TEXT("%s"), *Headers[i]);
+			}
 		}
 
-		// Convert from JSON to texts
-#if HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
+		const int ViewIdTotalCount = FCString::Atoi(*HttpResponsePtr->GetHeader("X-Total-Count"));
+
+		// Convert from JSON to rows
 		FString Content = HttpResponsePtr->GetContentAsString();
-#else // HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
-		const FString Content = HttpResponsePtr->GetContentAsString();
-#endif // HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
 		UE_LOG(LogGridly, Verbose, TEXT("%s"), *Content);
 
-		TArray<FGridlyTableRow> TableRows;
+		if (bRuntimeRefresh)
+		{
+			// Decode on a worker so that large pages do not hitch the game thread, then continue on the game thread.
+			// Row objects of several views can only be made once the views have been merged
 
-#if HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
-		// Convert any arrays that are in the json into a single string that can then be loaded 
-		// into the FGridlyTableCell's value within the JsonArrayStringToUStruct call.
-		// When the FGridlyDataTableImporterJSON comes to actually load it, it will read it as a array
-		// and so be able to load it into a array/set
-		FRegexPattern Pattern(TEXT("\"value\":(\\[.*?\"\\])"), ERegexPatternFlags::CaseInsensitive);
-		FRegexMatcher Matcher(Pattern, Content);
+			const bool bMakeRowObjects = ViewIds.Num() == 1;
 
-		while (Matcher.FindNext())
+			TWeakObjectPtr<UGridlyTask_ImportDataTableFromGridly> WeakThis(this);
+			Async(EAsyncExecution::ThreadPool, [WeakThis, HttpRequestPtr, Content = MoveTemp(Content), ViewIdIndex,
+				ViewIdTotalCount, bMakeRowObjects]() mutable
+			{
+				GRIDLY_TRACE_SCOPE("Gridly::DecodePageAsync");
+				const double DecodeStartSeconds = FPlatformTime::Seconds();
+
+				TArray<FGridlyTableRow> TableRows;
+				TArray<TSharedPtr<FJsonObject>> PageRowObjects;
+				const bool bDecoded = GridlyImportDataTable::DecodePage(Content, TableRows);
+
+				if (bDecoded && bMakeRowObjects)
+				{
+					PageRowObjects.Reserve(TableRows.Num());
+					for (const FGridlyTableRow& TableRow : TableRows)
+					{
+						PageRowObjects.Add(GridlyImportDataTable::MakeRowObject(TableRow));
+					}
+				}
+
+				const double DecodeSeconds = FPlatformTime::Seconds() - DecodeStartSeconds;
+
+				AsyncTask(ENamedThreads::GameThread, [WeakThis, HttpRequestPtr, DecodeSeconds, bDecoded,
+					TableRows = MoveTemp(TableRows), PageRowObjects = MoveTemp(PageRowObjects), ViewIdIndex,
+					ViewIdTotalCount]() mutable
+				{
+					FGridlyProfiling::AddDecodeTime(HttpRequestPtr, DecodeSeconds);
+
+					UGridlyTask_ImportDataTableFromGridly* This = WeakThis.Get();
+					if (This && !This->bFailed)
+					{
+						This->RowObjects.Append(MoveTemp(PageRowObjects));
+						This->OnPageDecoded(bDecoded, MoveTemp(TableRows), ViewIdIndex, ViewIdTotalCount);
+					}
+				});
+			});
+			return;
+		}
+
+		TArray<FGridlyTableRow> TableRows;
+		bool bDecoded;
 		{
-			FString ArrayContent = Matcher.GetCaptureGroup(1);
-			FString Replacement = TEXT("\"") + ArrayContent.Replace(TEXT("\""), TEXT("\\\"")) + TEXT("\"");
-			Content.ReplaceInline(*ArrayContent, *Replacement);
+			FGridlyProfiling::FDecodeScope DecodeScope(HttpRequestPtr);
+			bDecoded = GridlyImportDataTable::DecodePage(Content, TableRows);
 		}
-#endif //HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
-		
-		if (FJsonObjectConverter::JsonArrayStringToUStruct(Content, &TableRows, 0, 0))
+		OnPageDecoded(bDecoded, MoveTemp(TableRows), ViewIdIndex, ViewIdTotalCount);
+	}
+	else
+	{
+		BroadcastFail(FGridlyResult{"Failed to connect to Gridly"});
+	}
+}
+
+void UGridlyTask_ImportDataTableFromGridly::OnPageDecoded(const bool bDecoded, TArray<FGridlyTableRow>&& TableRows,
+	const int ViewIdIndex, const int ViewIdTotalCount)
+{
+	GRIDLY_TRACE_SCOPE("Gridly::OnPageDecoded");
+
+	if (!bDecoded)
+	{
+		BroadcastFail(FGridlyResult{"Failed to parse downloaded content"});
+		return;
+	}
+
+	FViewDownload& ViewDownload = ViewDownloads[ViewIdIndex];
+	if (ViewDownload.Offset == 0)
+	{
+		ViewDownload.TotalCount = ViewIdTotalCount;
+		TotalCount += ViewIdTotalCount;
+	}
+	ViewDownload.ReceivedCount += TableRows.Num();
+	FGridlyProfiling::AddRecords(TableRows.Num());
+
+	// Page events only carry this page, so listeners do not copy the accumulated rows on every page
+
+	// Blueprint page events share the pins of the other events, so the counts come through as the progress
+	const int32 RecordsReceived = GridlyTableRows.Num() + TableRows.Num();
+	OnPage.Broadcast(TableRows, TotalCount > 0 ? static_cast<float>(RecordsReceived) / TotalCount : 1.f, FGridlyResult::Success);
+	if (OnPageDelegate.IsBound())
+		OnPageDelegate.Execute(TableRows, RecordsReceived, TotalCount);
+
+	if (ViewIds.Num() > 1)
+	{
+		RowViewIndices.AddUninitialized(TableRows.Num());
+		for (int i = RowViewIndices.Num() - TableRows.Num(); i < RowViewIndices.Num(); i++)
 		{
-			GridlyTableRows.Append(TableRows);
+			RowViewIndices[i] = ViewIdIndex;
+		}
+	}
+	GridlyTableRows.Append(MoveTemp(TableRows));
+
+	float EstimatedProgress = 0.f;
+	for (const FViewDownload& Download : ViewDownloads)
+	{
+		EstimatedProgress += Download.TotalCount > 0 ? static_cast<float>(Download.ReceivedCount) / Download.TotalCount : 0.f;
+	}
+	EstimatedProgress /= ViewDownloads.Num();
+
+	OnProgress.Broadcast(GridlyTableRows, EstimatedProgress, FGridlyResult::Success);
+	if (OnProgressDelegate.IsBound())
+		OnProgressDelegate.Execute(GridlyTableRows, EstimatedProgress);
+
+	if ((ViewDownload.Offset + Limit) < ViewDownload.TotalCount)
+	{
+		RequestPage(ViewIdIndex, ViewDownload.Offset + Limit);
+	}
+	else if (--NumPendingViews == 0)
+	{
+		OnAllViewsDownloaded();
+	}
+}
+
+void UGridlyTask_ImportDataTableFromGridly::OnAllViewsDownloaded()
+{
+	GRIDLY_TRACE_SCOPE("Gridly::OnAllViewsDownloaded");
 
-			const int ViewIdTotalCount = FCString::Atoi(*HttpResponsePtr->GetHeader("X-Total-Count"));
-			TotalCount += CurrentOffset == 0 ? ViewIdTotalCount : 0;
-			const float EstimatedProgressViewIds =
-				static_cast<float>(CurrentViewIdIndex) / static_cast<float>(FMath::Max(1, ViewIds.Num()));
-			const float EstimatedProgressPagination = static_cast<float>(GridlyTableRows.Num()) / static_cast<float>(TotalCount);
-			const float EstimatedProgress = (EstimatedProgressViewIds + EstimatedProgressPagination) / 2.f;
+	if (bRuntimeRefresh && ViewIds.Num() > 1)
+	{
+		// Merging and making row objects for large views would hitch the game thread, so both happen on a worker
 
-			OnProgress.Broadcast(GridlyTableRows, EstimatedProgress, FGridlyResult::Success);
-			if (OnProgressDelegate.IsBound())
-				OnProgressDelegate.Execute(GridlyTableRows, EstimatedProgress);
+		TWeakObjectPtr<UGridlyTask_ImportDataTableFromGridly> WeakThis(this);
+		Async(EAsyncExecution::ThreadPool, [WeakThis, TableRows = MoveTemp(GridlyTableRows),
+			RowViewIndices = MoveTemp(RowViewIndices), MergeMode = GridlyDataTable->ViewMergeMode]() mutable
+		{
+			GRIDLY_TRACE_SCOPE("Gridly::MergeViewsAsync");
 
-			if ((CurrentOffset + Limit) < TotalCount)
+			GridlyImportDataTable::MergeViews(TableRows, RowViewIndices, MergeMode);
+
+			TArray<TSharedPtr<FJsonObject>> MergedRowObjects;
+			MergedRowObjects.Reserve(TableRows.Num());
+			for (const FGridlyTableRow& TableRow : TableRows)
 			{
-				RequestPage(CurrentViewIdIndex, CurrentOffset + Limit);
+				MergedRowObjects.Add(GridlyImportDataTable::MakeRowObject(TableRow));
 			}
-			else
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, TableRows = MoveTemp(TableRows),
+				MergedRowObjects = MoveTemp(MergedRowObjects)]() mutable
 			{
-				RequestPage(CurrentViewIdIndex + 1, 0);
-			}
-		}
-		else
+				if (UGridlyTask_ImportDataTableFromGridly* This = WeakThis.Get())
+				{
+					GRIDLY_TRACE_SCOPE("Gridly::BuildDataset");
+					This->RowObjects = MoveTemp(MergedRowObjects);
+					This->Dataset.Build(MoveTemp(TableRows));
+					This->StartRuntimeRefresh();
+				}
+			});
+		});
+		return;
+	}
+
+	if (ViewIds.Num() > 1)
+	{
+		GridlyImportDataTable::MergeViews(GridlyTableRows, RowViewIndices, GridlyDataTable->ViewMergeMode);
+		RowViewIndices.Empty();
+	}
+
+	if (bRuntimeRefresh)
+	{
+		Dataset.Build(MoveTemp(GridlyTableRows));
+		StartRuntimeRefresh();
+		return;
+	}
+
+	// Index the downloaded records once, the rows are moved rather than copied into the dataset
+
+	Dataset.Build(MoveTemp(GridlyTableRows));
+	const TArray<FGridlyTableRow>& DatasetRows = Dataset.GetRows();
+
+	TArray<TSharedPtr<FJsonValue>> JsonValues;
+
+	for (int i = 0; i < DatasetRows.Num(); i++)
+	{
+		JsonValues.Add(MakeShareable(new FJsonValueObject(GridlyImportDataTable::MakeRowObject(DatasetRows[i]))));
+	}
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+	FJsonSerializer::Serialize(JsonValues, JsonWriter);
+
+	TArray<FString> OutProblems;
+	FGridlyDataTableImporterJSON Importer(*GridlyDataTable, JsonString, OutProblems);
+	if (bHasViewSchema)
+	{
+		// Column problems have already been reported when the schema was validated
+		Importer.BindColumns(ViewColumnIds);
+		OutProblems.Reset();
+	}
+
+	OnPreImportDelegate.ExecuteIfBound();
+
+	bool bImported;
+	{
+		GRIDLY_TRACE_SCOPE("Gridly::ReadTable");
+		SCOPE_CYCLE_COUNTER(STAT_GridlyImportDataTables);
+		GRIDLY_ALLOCATION_SCOPE(ImportDataTables);
+		bImported = Importer.ReadTable();
+	}
+
+	if (bImported)
+	{
+		GridlyDataTable->SyncVersion = FDateTime::UtcNow().GetTicks();
+		UE_LOG(LogGridly, Log, TEXT("Imported data table from Gridly: %s"), *GridlyDataTable->GetName());
+		OnSuccess.Broadcast(DatasetRows, 1.f, FGridlyResult::Success);
+		if (OnSuccessDelegate.IsBound())
+			OnSuccessDelegate.Execute(DatasetRows);
+	}
+	else
+	{
+		for (int i = 0; i < OutProblems.Num(); i++)
 		{
-			const FGridlyResult FailResult = FGridlyResult{"Failed to parse downloaded content"};
-			OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
-			if (OnFailDelegate.IsBound())
-				OnFailDelegate.Execute(GridlyTableRows, FailResult);
+			UE_LOG(LogGridly, Error, TEXT("%s"), *OutProblems[i]);
 		}
+
+		const FGridlyResult FailResult = FGridlyResult{"Failed to parse downloaded content"};
+		OnFail.Broadcast(DatasetRows, 1.f, FailResult);
+		if (OnFailDelegate.IsBound())
+			OnFailDelegate.Execute(DatasetRows, FailResult);
 	}
-	else
+}
+
+void UGridlyTask_ImportDataTableFromGridly::BroadcastFail(const FGridlyResult& FailResult)
+{
+	// Parallel requests of other views may still complete, they are ignored once the task has failed
+
+	bFailed = true;
+	OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
+	if (OnFailDelegate.IsBound())
+		OnFailDelegate.Execute(GridlyTableRows, FailResult);
+}
+
+void UGridlyTask_ImportDataTableFromGridly::StartRuntimeRefresh()
+{
+	const TArray<FGridlyTableRow>& DatasetRows = Dataset.GetRows();
+
+	if (!GridlyDataTable->RowStruct)
 	{
-		const FGridlyResult FailResult = FGridlyResult{"Failed to connect to Gridly"};
-		OnFail.Broadcast(GridlyTableRows, 1.f, FailResult);
+		const FGridlyResult FailResult = FGridlyResult{"Unable to refresh data table: no RowStruct specified"};
+		UE_LOG(LogGridly, Error, TEXT("%s"), *FailResult.Message);
+		OnFail.Broadcast(DatasetRows, 1.f, FailResult);
 		if (OnFailDelegate.IsBound())
-			OnFailDelegate.Execute(GridlyTableRows, FailResult);
+			OnFailDelegate.Execute(DatasetRows, FailResult);
+		return;
 	}
+
+	RefreshProblems.Reset();
+	RefreshImporter = MakeUnique<FGridlyDataTableImporterJSON>(*GridlyDataTable, RefreshProblems);
+	if (bHasViewSchema)
+	{
+		RefreshImporter->BindColumns(ViewColumnIds);
+		RefreshProblems.Reset();
+	}
+	RefreshRowIndex = 0;
+	ChangedRowNames.Reset();
+
+	FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UGridlyTask_ImportDataTableFromGridly::TickRuntimeRefresh));
+}
+
+bool UGridlyTask_ImportDataTableFromGridly::TickRuntimeRefresh(float DeltaTime)
+{
+	GRIDLY_TRACE_SCOPE("Gridly::TickRuntimeRefresh");
+	SCOPE_CYCLE_COUNTER(STAT_GridlyImportDataTables);
+	GRIDLY_ALLOCATION_SCOPE(ImportDataTables);
+
+	// Rows are merged in place in time slices, only rows that differ from the current ones are written to
+
+	const double BudgetSeconds = GetDefault<UGridlyGameSettings>()->RuntimeRefreshFrameBudgetMs / 1000.0;
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+	while (RefreshRowIndex < RowObjects.Num())
+	{
+		bool bChanged = false;
+		const FName RowName = RefreshImporter->MergeRow(RowObjects[RefreshRowIndex].ToSharedRef(), RefreshRowIndex, bChanged);
+		if (bChanged)
+		{
+			ChangedRowNames.Add(RowName);
+		}
+
+		RefreshRowIndex++;
+
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			return true;
+		}
+	}
+
+	RefreshImporter->RemoveUnmergedRows(ChangedRowNames);
+	RefreshImporter.Reset();
+	RowObjects.Empty();
+
+	for (int i = 0; i < RefreshProblems.Num(); i++)
+	{
+		UE_LOG(LogGridly, Warning, TEXT("%s"), *RefreshProblems[i]);
+	}
+
+	UE_LOG(LogGridly, Log, TEXT("Refreshed data table from Gridly: %s, %d rows changed"), *GridlyDataTable->GetName(),
+		ChangedRowNames.Num());
+
+	if (ChangedRowNames.Num() > 0)
+	{
+		GridlyDataTable->SyncVersion = FDateTime::UtcNow().GetTicks();
+		if (GridlyDataTable->bUseRuntimeSnapshot)
+		{
+			FGridlyDataTableSnapshot::Save(*GridlyDataTable);
+		}
+
+		GridlyDataTable->OnRowsChanged.Broadcast(ChangedRowNames);
+		GridlyDataTable->OnRowsChangedDelegate.Broadcast(ChangedRowNames);
+	}
+
+	const TArray<FGridlyTableRow>& DatasetRows = Dataset.GetRows();
+	OnSuccess.Broadcast(DatasetRows, 1.f, FGridlyResult::Success);
+	if (OnSuccessDelegate.IsBound())
+		OnSuccessDelegate.Execute(DatasetRows);
+
+	return false;
+}
+
+void UGridlyTask_ImportDataTableFromGridly::CopyDataset(FGridlyDataset& OutDataset) const
+{
+	OutDataset = Dataset;
 }
 
 UGridlyTask_ImportDataTableFromGridly* UGridlyTask_ImportDataTableFromGridly::ImportDataTableFromGridly(
@@ -240,3 +724,11 @@ UGridlyTask_ImportDataTableFromGridly* UGridlyTask_ImportDataTableFromGridly::Im
 	ImportDataTableFromGridly->GridlyDataTable = GridlyDataTable;
 	return ImportDataTableFromGridly;
 }
+
+UGridlyTask_ImportDataTableFromGridly* UGridlyTask_ImportDataTableFromGridly::RefreshDataTableFromGridly(
+	const UObject* WorldContextObject, UGridlyDataTable* GridlyDataTable)
+{
+	UGridlyTask_ImportDataTableFromGridly* RefreshDataTableFromGridly = ImportDataTableFromGridly(WorldContextObject, GridlyDataTable);
+	RefreshDataTableFromGridly->bRuntimeRefresh = true;
+	return RefreshDataTableFromGridly;
+}
@@ -5,6 +5,7 @@
 // Include necessary Unreal Engine headers
 #include "Gridly.h"
 #include "GridlyGameSettings.h"
+#include "GridlyProfiling.h"
 
 #if WITH_EDITOR
 #include "LocalizationSettings.h"
@@ -24,6 +25,8 @@
 
 TArray<FString> FGridlyCultureConverter::GetTargetCultures()
 {
+	GRIDLY_TRACE_SCOPE("Gridly::GetTargetCultures");
+
 	TArray<FString> TargetCultures;
 
 #if WITH_EDITOR
@@ -1,3 +1,129 @@
 ﻿// Copyright (c) 2021 LocalizeDirect AB
 
 #include "GridlyDataTable.h"
+
+#include "DataTableUtils.h"
+#include "GridlyDataTableSnapshot.h"
+
+void UGridlyDataTable::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+#if WITH_EDITOR
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		OnDataTableChanged().AddUObject(this, &UGridlyDataTable::OnGridlyDataTableChanged);
+	}
+#endif
+}
+
+void UGridlyDataTable::PostLoad()
+{
+	Super::PostLoad();
+
+	// The editor always works on the asset itself, snapshots only apply to the game
+
+	if (bUseRuntimeSnapshot && !GIsEditor && !IsRunningCommandlet() && !HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FGridlyDataTableSnapshot::Load(*this);
+	}
+}
+
+#if WITH_EDITOR
+
+bool UGridlyDataTable::GetDirtyCells(TMap<FName, TBitArray<>>& OutDirtyCells, const bool bIgnoreSyncedHashes) const
+{
+	OutDirtyCells.Reset();
+
+	if (!RowStruct || (!bChangedSinceSync && !bIgnoreSyncedHashes))
+	{
+		return false;
+	}
+
+	const bool bSameColumns = !bIgnoreSyncedHashes && HashColumns() == SyncedColumnsHash;
+
+	for (const TPair<FName, uint8*>& Row : GetRowMap())
+	{
+		FGridlyRowHashes RowHashes;
+		HashRow(Row.Value, RowHashes);
+
+		const FGridlyRowHashes* SyncedHashes = bSameColumns ? SyncedRowHashes.Find(Row.Key) : nullptr;
+		if (SyncedHashes && SyncedHashes->RowHash == RowHashes.RowHash)
+		{
+			continue;
+		}
+
+		// New rows are entirely dirty, existing rows only in the cells that differ
+
+		TBitArray<>& DirtyCells = OutDirtyCells.Add(Row.Key, TBitArray<>(true, RowHashes.CellHashes.Num()));
+		if (SyncedHashes && SyncedHashes->CellHashes.Num() == RowHashes.CellHashes.Num())
+		{
+			for (int32 i = 0; i < RowHashes.CellHashes.Num(); i++)
+			{
+				DirtyCells[i] = SyncedHashes->CellHashes[i] != RowHashes.CellHashes[i];
+			}
+		}
+	}
+
+	return OutDirtyCells.Num() > 0;
+}
+
+void UGridlyDataTable::MarkSynced()
+{
+	const uint32 ColumnsHash = HashColumns();
+
+	TMap<FName, FGridlyRowHashes> RowHashes;
+	if (RowStruct)
+	{
+		RowHashes.Reserve(GetRowMap().Num());
+		for (const TPair<FName, uint8*>& Row : GetRowMap())
+		{
+			HashRow(Row.Value, RowHashes.Add(Row.Key));
+		}
+	}
+
+	bChangedSinceSync = false;
+
+	// Syncing a table that already matched Gridly leaves the asset untouched
+
+	if (ColumnsHash == SyncedColumnsHash && RowHashes.OrderIndependentCompareEqual(SyncedRowHashes))
+	{
+		return;
+	}
+
+	SyncedColumnsHash = ColumnsHash;
+	SyncedRowHashes = MoveTemp(RowHashes);
+	MarkPackageDirty();
+}
+
+void UGridlyDataTable::OnGridlyDataTableChanged()
+{
+	bChangedSinceSync = true;
+}
+
+uint32 UGridlyDataTable::HashColumns() const
+{
+	uint32 Hash = 0;
+	for (TFieldIterator<const FProperty> It(RowStruct); It; ++It)
+	{
+		// The name string, not the FName index, which differs between sessions
+		Hash = HashCombine(Hash, FCrc::StrCrc32(*It->GetName()));
+	}
+	return Hash;
+}
+
+void UGridlyDataTable::HashRow(const uint8* RowData, FGridlyRowHashes& OutRowHashes) const
+{
+	OutRowHashes.RowHash = 0;
+	OutRowHashes.CellHashes.Reset();
+
+	for (TFieldIterator<const FProperty> It(RowStruct); It; ++It)
+	{
+		const FString Value = DataTableUtils::GetPropertyValueAsString(*It, RowData, EDataTableExportFlags::None);
+		const uint32 CellHash = FCrc::StrCrc32(*Value);
+		OutRowHashes.CellHashes.Add(CellHash);
+		OutRowHashes.RowHash = HashCombine(OutRowHashes.RowHash, CellHash);
+	}
+}
+
+#endif
@@ -8,6 +8,45 @@
 
 #include "GridlyDataTable.generated.h"
 
+UDELEGATE()
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGridlyDataTableRowsChangedDelegate, const TArray<FName>&, ChangedRowNames);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FGridlyDataTableRowsChangedNativeDelegate, const TArray<FName>&);
+
+/**
+ * How the records of the additional views of a Gridly data table are combined with the ones of the main view
+ */
+UENUM(BlueprintType)
+enum class EGridlyViewMergeMode : uint8
+{
+	/** Each view holds a subset of the records. Records are combined, for duplicate record IDs the first view wins */
+	Rows,
+
+	/** Each view holds a subset of the columns. Cells of records with the same record ID are joined into one row */
+	Columns
+};
+
+/**
+ * Hashes of a row as it was last exported to or imported from Gridly
+ */
+USTRUCT()
+struct GRIDLY_API FGridlyRowHashes
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint32 RowHash = 0;
+
+	/** One hash per row struct property, in field iteration order */
+	UPROPERTY()
+	TArray<uint32> CellHashes;
+
+	bool operator==(const FGridlyRowHashes& Other) const
+	{
+		return RowHash == Other.RowHash && CellHashes == Other.CellHashes;
+	}
+};
+
 /**
  * Data table that can sync with Gridly
  */
@@ -15,10 +54,68 @@ UCLASS(BlueprintType, HideCategories = Object)
 class GRIDLY_API UGridlyDataTable : public UDataTable
 {
 	friend class FGridlyDataTableImporterJSON;
+	friend class FGridlyDataTableSnapshot;
 	
 	GENERATED_BODY()
 
+public:
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	/**
+	 * Finds the rows that changed since the last successful export or import, with a bit per row struct property that is set
+	 * for changed cells. Returns false when nothing has changed. With bIgnoreSyncedHashes, every row and cell counts as changed,
+	 * for when the records on Gridly no longer match the stored hashes
+	 */
+	bool GetDirtyCells(TMap<FName, TBitArray<>>& OutDirtyCells, bool bIgnoreSyncedHashes = false) const;
+
+	/** Stores the hashes of all rows as synced with Gridly. The package is only dirtied when the hashes changed */
+	void MarkSynced();
+#endif
+
 public:
 	UPROPERTY(Category = Gridly, EditDefaultsOnly)
 	FString ViewId;
+
+	/** Further views to import from, fetched in parallel with the main view. Exports only go to the main view */
+	UPROPERTY(Category = Gridly, EditDefaultsOnly)
+	TArray<FString> AdditionalViewIds;
+
+	UPROPERTY(Category = Gridly, EditDefaultsOnly)
+	EGridlyViewMergeMode ViewMergeMode = EGridlyViewMergeMode::Rows;
+
+	/** When set, rows refreshed at runtime are saved to Saved/Gridly/Snapshots and applied on startup if newer than the cooked table */
+	UPROPERTY(Category = Gridly, EditDefaultsOnly)
+	bool bUseRuntimeSnapshot = false;
+
+	/** UTC ticks of the last successful sync with Gridly, used to pick the newer of the cooked rows and the runtime snapshot */
+	UPROPERTY(Category = Gridly, VisibleAnywhere, BlueprintReadOnly)
+	int64 SyncVersion = 0;
+
+	/** Fires after a runtime refresh with the names of all rows that were added, modified or removed */
+	UPROPERTY(Category = Gridly, BlueprintAssignable, Transient)
+	FGridlyDataTableRowsChangedDelegate OnRowsChanged;
+
+	FGridlyDataTableRowsChangedNativeDelegate OnRowsChangedDelegate;
+
+#if WITH_EDITORONLY_DATA
+private:
+	UPROPERTY()
+	TMap<FName, FGridlyRowHashes> SyncedRowHashes;
+
+	/** Hash of the row struct property names the synced hashes were computed with */
+	UPROPERTY()
+	uint32 SyncedColumnsHash = 0;
+
+	/** Cleared when synced and set by data table change notifications, so unchanged tables are not hashed again */
+	bool bChangedSinceSync = true;
+#endif
+
+#if WITH_EDITOR
+private:
+	void OnGridlyDataTableChanged();
+	uint32 HashColumns() const;
+	void HashRow(const uint8* RowData, FGridlyRowHashes& OutRowHashes) const;
+#endif
 };
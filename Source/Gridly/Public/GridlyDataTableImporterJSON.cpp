@@ -32,6 +32,8 @@ const TCHAR* JSONTypeToString(const EJson InType)
 	}
 }
 
+const FString EmptyJSONData;
+
 /** Returns what string is used as the key/name field for a data table */
 FString GetKeyFieldName(const UDataTable& InDataTable)
 {
@@ -54,8 +56,20 @@ FGridlyDataTableImporterJSON::FGridlyDataTableImporterJSON(UDataTable& InDataTab
 {
 }
 
+FGridlyDataTableImporterJSON::FGridlyDataTableImporterJSON(UDataTable& InDataTable, TArray<FString>& OutProblems) :
+	DataTable(&InDataTable),
+	JSONData(GridlyDataTableJSONUtils::EmptyJSONData),
+	ImportProblems(OutProblems)
+{
+}
+
 FGridlyDataTableImporterJSON::~FGridlyDataTableImporterJSON()
 {
+	if (ScratchRowData)
+	{
+		DataTable->RowStruct->DestroyStruct(ScratchRowData);
+		FMemory::Free(ScratchRowData);
+	}
 }
 
 bool FGridlyDataTableImporterJSON::ReadTable()
@@ -83,6 +97,9 @@ bool FGridlyDataTableImporterJSON::ReadTable()
 		}
 	}
 
+	// Recorded before the rows are replaced, so that an open transaction can undo the import
+	DataTable->Modify(true);
+
 	// Empty existing data
 	DataTable->EmptyTable();
 
@@ -103,63 +120,193 @@ bool FGridlyDataTableImporterJSON::ReadTable()
 		}
 	}
 
-	DataTable->Modify(true);
-
 	return true;
 }
 
-bool FGridlyDataTableImporterJSON::ReadRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx)
+FName FGridlyDataTableImporterJSON::MergeRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx,
+	bool& bOutChanged)
 {
-	// Get row name
-	FString RowKey = GridlyDataTableJSONUtils::GetKeyFieldName(*DataTable);
-	FName RowName = DataTableUtils::MakeValidName(InParsedTableRowObject->GetStringField(RowKey));
+	bOutChanged = false;
 
-	// Check its not 'none'
+	const FName RowName = ReadRowName(InParsedTableRowObject, InRowIdx);
 	if (RowName.IsNone())
 	{
-		ImportProblems.Add(FString::Printf(TEXT("Row '%d' missing key field '%s'."), InRowIdx, *RowKey));
-		return false;
+		return NAME_None;
 	}
 
-	// Check its not a duplicate
-	if (!DataTable->AllowDuplicateRowsOnImport() && DataTable->GetRowMap().Find(RowName) != nullptr)
+	bool bAlreadyMerged = false;
+	MergedRowNames.Add(RowName, &bAlreadyMerged);
+	if (bAlreadyMerged && !DataTable->AllowDuplicateRowsOnImport())
 	{
 		ImportProblems.Add(FString::Printf(TEXT("Duplicate row name '%s'."), *RowName.ToString()));
+		return RowName;
+	}
+
+	if (!bHasColumnBindings)
+	{
+		CheckExtraFields(InParsedTableRowObject, RowName);
+	}
+
+	// Read into scratch memory first, so that unchanged rows are never written to
+
+	UScriptStruct* RowStruct = DataTable->RowStruct;
+	if (!ScratchRowData)
+	{
+		ScratchRowData = (uint8*) FMemory::Malloc(RowStruct->GetStructureSize());
+		RowStruct->InitializeStruct(ScratchRowData);
+	}
+	else
+	{
+		RowStruct->ClearScriptStruct(ScratchRowData);
+	}
+
+	const bool bRead = bHasColumnBindings
+		? ReadBoundRow(InParsedTableRowObject, RowName, ScratchRowData)
+		: ReadStruct(InParsedTableRowObject, RowStruct, RowName, ScratchRowData);
+	if (!bRead)
+	{
+		// Keep the existing row rather than replacing it with a partially read one
+		ImportProblems.Add(FString::Printf(TEXT("Failed to read row '%d'."), InRowIdx));
+		return RowName;
+	}
+
+	uint8* const* ExistingRowData = DataTable->GetRowMap().Find(RowName);
+	if (!ExistingRowData)
+	{
+		uint8* RowData = (uint8*) FMemory::Malloc(RowStruct->GetStructureSize());
+		RowStruct->InitializeStruct(RowData);
+		RowStruct->CopyScriptStruct(RowData, ScratchRowData);
+
+		UGridlyDataTable* GridlyDataTable = Cast<UGridlyDataTable>(DataTable);
+		GridlyDataTable->AddRowInternal(RowName, RowData);
+		bOutChanged = true;
+	}
+	else if (!RowStruct->CompareScriptStruct(*ExistingRowData, ScratchRowData, PPF_None))
+	{
+		RowStruct->CopyScriptStruct(*ExistingRowData, ScratchRowData);
+		bOutChanged = true;
+	}
+
+	return RowName;
+}
+
+void FGridlyDataTableImporterJSON::RemoveUnmergedRows(TArray<FName>& OutRemovedRowNames)
+{
+	UGridlyDataTable* GridlyDataTable = Cast<UGridlyDataTable>(DataTable);
+
+	for (const FName& RowName : DataTable->GetRowNames())
+	{
+		if (!MergedRowNames.Contains(RowName))
+		{
+			GridlyDataTable->RemoveRowInternal(RowName);
+			OutRemovedRowNames.Add(RowName);
+		}
+	}
+}
+
+bool FGridlyDataTableImporterJSON::BindColumns(const TArray<FString>& ColumnIds)
+{
+	ColumnBindings.Reset();
+	bHasColumnBindings = false;
+
+	if (!DataTable->RowStruct)
+	{
+		ImportProblems.Add(TEXT("No RowStruct specified."));
 		return false;
 	}
 
-	// Detect any extra fields within the data for this row
-	if (!DataTable->bIgnoreExtraFields)
+	TSet<FString> BoundColumnIds;
+	int32 NumBoundColumns = 0;
+
+	TArray<FString> TempPropertyImportNames;
+	for (TFieldIterator<FProperty> It(DataTable->RowStruct); It; ++It)
 	{
-		TArray<FString> TempPropertyImportNames;
-		for (const TPair<FString, TSharedPtr<FJsonValue>>& ParsedPropertyKeyValuePair : InParsedTableRowObject->Values)
+		FProperty* BaseProp = *It;
+		const FString ColumnName = DataTableUtils::GetPropertyExportName(BaseProp);
+
+		// The record path is not a column of the view
+		if (ColumnName == TEXT("_path"))
 		{
-			if (ParsedPropertyKeyValuePair.Key == RowKey)
-			{
-				// Skip the row name, as that doesn't match a property
-				continue;
-			}
+			ColumnBindings.Add({BaseProp, ColumnName, ColumnName});
+			continue;
+		}
 
-			FName PropName = DataTableUtils::MakeValidName(ParsedPropertyKeyValuePair.Key);
-			FProperty* ColumnProp = FindFProperty<FProperty>(DataTable->RowStruct, PropName);
-			for (TFieldIterator<FProperty> It(DataTable->RowStruct); It && !ColumnProp; ++It)
-			{
 #if ENGINE_MINOR_VERSION >= 26
-				DataTableUtils::GetPropertyImportNames(*It, TempPropertyImportNames);
+		DataTableUtils::GetPropertyImportNames(BaseProp, TempPropertyImportNames);
 #else
-				TempPropertyImportNames = DataTableUtils::GetPropertyImportNames(*It);
+		TempPropertyImportNames = DataTableUtils::GetPropertyImportNames(BaseProp);
 #endif
-				ColumnProp = TempPropertyImportNames.Contains(ParsedPropertyKeyValuePair.Key) ? *It : nullptr;
-			}
+		const FString* ColumnId = TempPropertyImportNames.FindByPredicate([&ColumnIds](const FString& PropertyName)
+		{
+			return ColumnIds.Contains(PropertyName);
+		});
+
+		if (ColumnId)
+		{
+			ColumnBindings.Add({BaseProp, *ColumnId, ColumnName});
+			BoundColumnIds.Add(*ColumnId);
+			NumBoundColumns++;
+			continue;
+		}
+
+#if WITH_EDITOR
+		static const FName DataTableImportOptionalMetadataKey(TEXT("DataTableImportOptional"));
+		if (BaseProp->HasMetaData(DataTableImportOptionalMetadataKey))
+		{
+			continue;
+		}
+#endif // WITH_EDITOR
+
+		if (!DataTable->bIgnoreMissingFields)
+		{
+			ImportProblems.Add(FString::Printf(TEXT("Property '%s' of struct '%s' has no matching column in the Gridly view."),
+				*ColumnName, *DataTable->RowStruct->GetName()));
+		}
+	}
 
-			if (!ColumnProp)
+	if (!DataTable->bIgnoreExtraFields)
+	{
+		for (const FString& ColumnId : ColumnIds)
+		{
+			if (!BoundColumnIds.Contains(ColumnId))
 			{
-				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' cannot be found in struct '%s'."),
-					*PropName.ToString(), *RowName.ToString(), *DataTable->RowStruct->GetName()));
+				ImportProblems.Add(FString::Printf(TEXT("Column '%s' of the Gridly view cannot be found in struct '%s'."), *ColumnId,
+					*DataTable->RowStruct->GetName()));
 			}
 		}
 	}
 
+	if (NumBoundColumns == 0)
+	{
+		ImportProblems.Add(FString::Printf(TEXT("None of the columns of the Gridly view match struct '%s'."),
+			*DataTable->RowStruct->GetName()));
+		return false;
+	}
+
+	bHasColumnBindings = true;
+	return true;
+}
+
+bool FGridlyDataTableImporterJSON::ReadRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx)
+{
+	const FName RowName = ReadRowName(InParsedTableRowObject, InRowIdx);
+	if (RowName.IsNone())
+	{
+		return false;
+	}
+
+	// Check its not a duplicate
+	if (!DataTable->AllowDuplicateRowsOnImport() && DataTable->GetRowMap().Find(RowName) != nullptr)
+	{
+		ImportProblems.Add(FString::Printf(TEXT("Duplicate row name '%s'."), *RowName.ToString()));
+		return false;
+	}
+
+	if (!bHasColumnBindings)
+	{
+		CheckExtraFields(InParsedTableRowObject, RowName);
+	}
+
 	// Allocate data to store information, using UScriptStruct to know its size
 	uint8* RowData = (uint8*) FMemory::Malloc(DataTable->RowStruct->GetStructureSize());
 	DataTable->RowStruct->InitializeStruct(RowData);
@@ -169,7 +316,63 @@ bool FGridlyDataTableImporterJSON::ReadRow(const TSharedRef<FJsonObject>& InPars
 	UGridlyDataTable* GridlyDataTable = Cast<UGridlyDataTable>(DataTable);
 	GridlyDataTable->AddRowInternal(RowName, RowData);
 
-	return ReadStruct(InParsedTableRowObject, DataTable->RowStruct, RowName, RowData);
+	return bHasColumnBindings
+		? ReadBoundRow(InParsedTableRowObject, RowName, RowData)
+		: ReadStruct(InParsedTableRowObject, DataTable->RowStruct, RowName, RowData);
+}
+
+FName FGridlyDataTableImporterJSON::ReadRowName(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx)
+{
+	// Get row name
+	FString RowKey = GridlyDataTableJSONUtils::GetKeyFieldName(*DataTable);
+	FName RowName = DataTableUtils::MakeValidName(InParsedTableRowObject->GetStringField(RowKey));
+
+	// Check its not 'none'
+	if (RowName.IsNone())
+	{
+		ImportProblems.Add(FString::Printf(TEXT("Row '%d' missing key field '%s'."), InRowIdx, *RowKey));
+	}
+
+	return RowName;
+}
+
+void FGridlyDataTableImporterJSON::CheckExtraFields(const TSharedRef<FJsonObject>& InParsedTableRowObject, const FName InRowName)
+{
+	// Detect any extra fields within the data for this row
+	if (DataTable->bIgnoreExtraFields)
+	{
+		return;
+	}
+
+	const FString RowKey = GridlyDataTableJSONUtils::GetKeyFieldName(*DataTable);
+
+	TArray<FString> TempPropertyImportNames;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& ParsedPropertyKeyValuePair : InParsedTableRowObject->Values)
+	{
+		if (ParsedPropertyKeyValuePair.Key == RowKey)
+		{
+			// Skip the row name, as that doesn't match a property
+			continue;
+		}
+
+		FName PropName = DataTableUtils::MakeValidName(ParsedPropertyKeyValuePair.Key);
+		FProperty* ColumnProp = FindFProperty<FProperty>(DataTable->RowStruct, PropName);
+		for (TFieldIterator<FProperty> It(DataTable->RowStruct); It && !ColumnProp; ++It)
+		{
+#if ENGINE_MINOR_VERSION >= 26
+			DataTableUtils::GetPropertyImportNames(*It, TempPropertyImportNames);
+#else
+			TempPropertyImportNames = DataTableUtils::GetPropertyImportNames(*It);
+#endif
+			ColumnProp = TempPropertyImportNames.Contains(ParsedPropertyKeyValuePair.Key) ? *It : nullptr;
+		}
+
+		if (!ColumnProp)
+		{
+			ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' cannot be found in struct '%s'."),
+				*PropName.ToString(), *InRowName.ToString(), *DataTable->RowStruct->GetName()));
+		}
+	}
 }
 
 bool FGridlyDataTableImporterJSON::ReadStruct(const TSharedRef<FJsonObject>& InParsedObject, UScriptStruct* InStruct,
@@ -220,58 +423,87 @@ bool FGridlyDataTableImporterJSON::ReadStruct(const TSharedRef<FJsonObject>& InP
 			continue;
 		}
 
-		if (BaseProp->ArrayDim == 1)
+		if (!ReadProperty(ParsedPropertyValue.ToSharedRef(), InRowName, ColumnName, InStructData, BaseProp))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FGridlyDataTableImporterJSON::ReadBoundRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const FName InRowName,
+	void* InRowData)
+{
+	// Columns have been validated once up front, so missing cells are simply left at their defaults
+
+	for (const FGridlyColumnBinding& ColumnBinding : ColumnBindings)
+	{
+		const TSharedPtr<FJsonValue> ParsedPropertyValue = InParsedTableRowObject->TryGetField(ColumnBinding.ColumnId);
+		if (ParsedPropertyValue.IsValid() && !ReadProperty(ParsedPropertyValue.ToSharedRef(), InRowName, ColumnBinding.ColumnName,
+			InRowData, ColumnBinding.Property))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FGridlyDataTableImporterJSON::ReadProperty(const TSharedRef<FJsonValue>& ParsedPropertyValue, const FName InRowName,
+	const FString& ColumnName, void* InStructData, FProperty* BaseProp)
+{
+	if (BaseProp->ArrayDim == 1)
+	{
+		void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, 0);
+#if HS_GRIDLY_ALLOW_ARBITARY_STRUCT_IN_TABLE		
+		if (!ReadStructEntry(ParsedPropertyValue, InRowName, ColumnName, InStructData, BaseProp, Data))
 		{
-			void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, 0);
-if HS_GRIDLY_ALLOW_ARBITARY_STRUCT_IN_TABLE		
-			if (!ReadStructEntry(ParsedPropertyValue.ToSharedRef(), InRowName, ColumnName, InStructData, BaseProp, Data))
+			// Attempt to see if the stored string is a json string, and if so, reparse that
+			if (ParsedPropertyValue->Type == EJson::String)
 			{
-				// Attempt to see if the stored string is a json string, and if so, reparse that
-				if (ParsedPropertyValue->Type == EJson::String)
-				{
  					TSharedPtr<FJsonValue> parsedRowStruct;
-					FString maybeJsonString;
-					ParsedPropertyValue->TryGetString(maybeJsonString);
+				FString maybeJsonString;
+				ParsedPropertyValue->TryGetString(maybeJsonString);
  					{
  						const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(maybeJsonString);
-						if (FJsonSerializer::Deserialize(JsonReader, parsedRowStruct) )
+					if (FJsonSerializer::Deserialize(JsonReader, parsedRowStruct) )
  						{
-							ReadStructEntry(parsedRowStruct.ToSharedRef(), InRowName, ColumnName, InStructData, BaseProp, Data);
+						ReadStructEntry(parsedRowStruct.ToSharedRef(), InRowName, ColumnName, InStructData, BaseProp, Data);
  						}
  					}
-				}
 			}
+		}
 #else
-			ReadStructEntry(ParsedPropertyValue.ToSharedRef(), InRowName, ColumnName, InStructData, BaseProp, Data);
+		ReadStructEntry(ParsedPropertyValue, InRowName, ColumnName, InStructData, BaseProp, Data);
 #endif //HS_GRIDLY_ALLOW_ARBITARY_STRUCT_IN_TABLE		
-		}
-		else
-		{
-			const TCHAR* const ParsedPropertyType = GridlyDataTableJSONUtils::JSONTypeToString(ParsedPropertyValue->Type);
+	}
+	else
+	{
+		const TCHAR* const ParsedPropertyType = GridlyDataTableJSONUtils::JSONTypeToString(ParsedPropertyValue->Type);
 
-			const TArray<TSharedPtr<FJsonValue>>* PropertyValuesPtr;
-			if (!ParsedPropertyValue->TryGetArray(PropertyValuesPtr))
-			{
-				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Array, got %s."),
-					*ColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
-			}
+		const TArray<TSharedPtr<FJsonValue>>* PropertyValuesPtr;
+		if (!ParsedPropertyValue->TryGetArray(PropertyValuesPtr))
+		{
+			ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Array, got %s."),
+				*ColumnName, *InRowName.ToString(), ParsedPropertyType));
+			return false;
+		}
 
-			if (BaseProp->ArrayDim != PropertyValuesPtr->Num())
-			{
-				ImportProblems.Add(FString::Printf(
-					TEXT("Property '%s' on row '%s' is a static sized array with %d elements, but we have %d values to import"),
-					*ColumnName, *InRowName.ToString(), BaseProp->ArrayDim, PropertyValuesPtr->Num()));
-			}
+		if (BaseProp->ArrayDim != PropertyValuesPtr->Num())
+		{
+			ImportProblems.Add(FString::Printf(
+				TEXT("Property '%s' on row '%s' is a static sized array with %d elements, but we have %d values to import"),
+				*ColumnName, *InRowName.ToString(), BaseProp->ArrayDim, PropertyValuesPtr->Num()));
+		}
 
-			for (int32 ArrayEntryIndex = 0; ArrayEntryIndex < BaseProp->ArrayDim; ++ArrayEntryIndex)
+		for (int32 ArrayEntryIndex = 0; ArrayEntryIndex < BaseProp->ArrayDim; ++ArrayEntryIndex)
+		{
+			if (PropertyValuesPtr->IsValidIndex(ArrayEntryIndex))
 			{
-				if (PropertyValuesPtr->IsValidIndex(ArrayEntryIndex))
-				{
-					void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, ArrayEntryIndex);
-					const TSharedPtr<FJsonValue>& PropertyValueEntry = (*PropertyValuesPtr)[ArrayEntryIndex];
-					ReadContainerEntry(PropertyValueEntry.ToSharedRef(), InRowName, ColumnName, ArrayEntryIndex, BaseProp, Data);
-				}
+				void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, ArrayEntryIndex);
+				const TSharedPtr<FJsonValue>& PropertyValueEntry = (*PropertyValuesPtr)[ArrayEntryIndex];
+				ReadContainerEntry(PropertyValueEntry.ToSharedRef(), InRowName, ColumnName, ArrayEntryIndex, BaseProp, Data);
 			}
 		}
 	}
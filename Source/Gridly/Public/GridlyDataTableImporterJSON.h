@@ -16,14 +16,36 @@ class GRIDLY_API FGridlyDataTableImporterJSON
 {
 public:
 	FGridlyDataTableImporterJSON(UDataTable& InDataTable, const FString& InJSONData, TArray<FString>& OutProblems);
+	/** Creates an importer for merging already parsed rows with MergeRow */
+	FGridlyDataTableImporterJSON(UDataTable& InDataTable, TArray<FString>& OutProblems);
 	~FGridlyDataTableImporterJSON();
 
 	bool ReadTable();
 
+	/**
+	 * Reads a row and updates the table in place, without emptying it or calling any editor-only functions.
+	 * Rows that are identical to the existing ones are left untouched. Returns the row name, or NAME_None if the row has no key
+	 */
+	FName MergeRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx, bool& bOutChanged);
+
+	/** Removes all rows that have not been merged by this importer */
+	void RemoveUnmergedRows(TArray<FName>& OutRemovedRowNames);
+
+	/**
+	 * Validates the row struct against the column IDs of a Gridly view and binds each property to its column, reporting
+	 * problems once per column instead of once per row. Returns false if no property matches any column
+	 */
+	bool BindColumns(const TArray<FString>& ColumnIds);
+
 private:
 	bool ReadRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx);
+	FName ReadRowName(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx);
+	void CheckExtraFields(const TSharedRef<FJsonObject>& InParsedTableRowObject, const FName InRowName);
 	bool ReadStruct(const TSharedRef<FJsonObject>& InParsedObject, UScriptStruct* InStruct, const FName InRowName,
 		void* InStructData);
+	bool ReadBoundRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const FName InRowName, void* InRowData);
+	bool ReadProperty(const TSharedRef<FJsonValue>& ParsedPropertyValue, const FName InRowName, const FString& ColumnName,
+		void* InStructData, FProperty* BaseProp);
 	bool ReadStructEntry(const TSharedRef<FJsonValue>& InParsedPropertyValue, const FName InRowName, const FString& InColumnName,
 		const void* InRowData, FProperty* InProperty, void* InPropertyData);
 	bool ReadContainerEntry(const TSharedRef<FJsonValue>& InParsedPropertyValue, const FName InRowName, const FString& InColumnName,
@@ -32,5 +54,18 @@ private:
 	UDataTable* DataTable;
 	const FString& JSONData;
 	TArray<FString>& ImportProblems;
+
+	TSet<FName> MergedRowNames;
+	uint8* ScratchRowData = nullptr;
+
+	struct FGridlyColumnBinding
+	{
+		FProperty* Property;
+		FString ColumnId;
+		FString ColumnName;
+	};
+
+	TArray<FGridlyColumnBinding> ColumnBindings;
+	bool bHasColumnBindings = false;
 };
 
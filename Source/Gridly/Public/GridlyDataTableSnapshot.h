@@ -0,0 +1,32 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UGridlyDataTable;
+
+/**
+ * Binary snapshot of the rows of a Gridly data table, saved to Saved/Gridly/Snapshots after a runtime refresh.
+ * On startup the snapshot is memory mapped and applied if its sync version is newer than the one of the cooked table.
+ */
+class GRIDLY_API FGridlyDataTableSnapshot
+{
+public:
+	static FString GetSnapshotFilePath(const UGridlyDataTable& GridlyDataTable);
+
+	static bool Save(const UGridlyDataTable& GridlyDataTable);
+
+	/** Replaces the rows of the table with the snapshot. Returns false if there is no snapshot newer than the table */
+	static bool Load(UGridlyDataTable& GridlyDataTable);
+
+	/** Writes the rows of the table in the snapshot format, e.g. to restore them after an editor import */
+	static bool SaveToMemory(const UGridlyDataTable& GridlyDataTable, TArray<uint8>& OutData);
+
+	/** Replaces the rows of the table with a snapshot saved by SaveToMemory, regardless of its sync version */
+	static bool LoadFromMemory(UGridlyDataTable& GridlyDataTable, const TArray<uint8>& Data);
+
+private:
+	static void Write(FArchive& Writer, const UGridlyDataTable& GridlyDataTable);
+	static bool Read(FArchive& Reader, UGridlyDataTable& GridlyDataTable, const FString& SourceName, bool bRequireNewer);
+};
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GridlyTableRow.h"
+
+#include "GridlyDataset.generated.h"
+
+/**
+ * Downloaded Gridly records with hash indices by record ID, path and column, built once per download.
+ * Paths are indexed on "/" boundaries, so a path prefix of "ui/menu" matches "ui/menu" and "ui/menu/options" but not "ui/menus".
+ * Only the rows are serialized, the indices of a loaded dataset are built again on its first lookup.
+ */
+USTRUCT(BlueprintType)
+struct GRIDLY_API FGridlyDataset
+{
+	GENERATED_BODY()
+
+public:
+	FGridlyDataset() = default;
+	explicit FGridlyDataset(TArray<FGridlyTableRow>&& InRows);
+
+	void Build(TArray<FGridlyTableRow>&& InRows);
+	void Reset();
+
+	int32 Num() const { return Rows.Num(); }
+	const TArray<FGridlyTableRow>& GetRows() const { return Rows; }
+	const TArray<FString>& GetColumnIds() const;
+
+	int32 FindRowIndex(const FString& RecordId) const;
+	int32 FindColumnIndex(const FString& ColumnId) const;
+
+	const FGridlyTableRow* FindRow(const FString& RecordId) const;
+	const FGridlyTableCell* FindCell(const int32 RowIndex, const int32 ColumnIndex) const;
+	const FGridlyTableCell* FindCell(const FString& RecordId, const FString& ColumnId) const;
+
+	/** Returns indices into GetRows() of all rows at or below the given path. An empty prefix matches every row */
+	TConstArrayView<int32> FindRowIndicesByPath(const FString& PathPrefix) const;
+
+	void PostSerialize(const FArchive& Ar);
+
+private:
+	void BuildIndices() const;
+	void ResetIndices() const;
+
+	/** Builds the indices if they have not been built for the current rows */
+	void EnsureIndices() const
+	{
+		if (!bIndexed)
+		{
+			BuildIndices();
+		}
+	}
+
+private:
+	UPROPERTY(Category = Gridly, VisibleAnywhere)
+	TArray<FGridlyTableRow> Rows;
+
+	mutable bool bIndexed = false;
+	mutable TArray<FString> ColumnIds;
+	mutable TMap<FString, int32> RowIndexById;
+	mutable TMap<FString, int32> ColumnIndexById;
+	mutable TMap<FString, TArray<int32>> RowIndicesByPath;
+	mutable TArray<int32> AllRowIndices;
+
+	/** Rows.Num() x ColumnIds.Num() matrix of indices into FGridlyTableRow::Cells, INDEX_NONE where a row has no such cell */
+	mutable TArray<int32> CellIndices;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGridlyDataset> : public TStructOpsTypeTraitsBase2<FGridlyDataset>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
@@ -6,6 +6,8 @@
 #include "Serialization/JsonSerializer.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 
 UGridlyGameSettings::UGridlyGameSettings(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer),
@@ -321,6 +323,19 @@ bool UGridlyGameSettings::DeserializeJsonToArray(const FString& JsonString, TArr
     return false;
 }
 
+FString UGridlyGameSettings::GetApiBaseUrl()
+{
+    FString BaseUrl = GetDefault<UGridlyGameSettings>()->ApiBaseUrl;
+
+    // Shipping builds always use the configured URL, so that the command line cannot redirect requests with the API keys
+#if !UE_BUILD_SHIPPING
+    FParse::Value(FCommandLine::Get(), TEXT("GridlyApiUrl="), BaseUrl);
+#endif
+
+    BaseUrl.RemoveFromEnd(TEXT("/"));
+    return BaseUrl;
+}
+
 FString UGridlyGameSettings::GetGridlyConfigPath()
 {
     return FPaths::Combine(FPaths::ProjectConfigDir(), TEXT("GridlyConfig.ini"));
@@ -13,6 +13,20 @@ enum class EGridlyColumnDataType : uint8
     Number
 };
 
+/** How an editor import of a Gridly data table can be undone */
+UENUM(BlueprintType)
+enum class EGridlyDataTableImportUndoMode : uint8
+{
+    /** The import is a regular editor transaction that can be undone with Ctrl+Z */
+    Full,
+
+    /** The rows are kept in a compact binary snapshot in memory, which can be restored with Revert Last Gridly Import */
+    Snapshot,
+
+    /** The import cannot be undone */
+    None
+};
+
 USTRUCT(BlueprintType)
 struct GRIDLY_API FGridlyColumnInfo
 {
@@ -45,6 +59,14 @@ public:
     UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "1", ClampMax = "1000"))
     int ImportMaxRecordsPerRequest = 1000;
 
+    /** Time in milliseconds that a runtime refresh of a Gridly data table may spend applying rows each frame */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config, meta = (ClampMin = "0.1"))
+    float RuntimeRefreshFrameBudgetMs = 2.f;
+
+    /** Full undo keeps the whole table in the transaction buffer, which gets expensive for large tables */
+    UPROPERTY(Category = "Gridly|Import Settings|Advanced", BlueprintReadOnly, EditAnywhere, Config)
+    EGridlyDataTableImportUndoMode DataTableImportUndoMode = EGridlyDataTableImportUndoMode::Full;
+
     /** The API key can be retrieved from your Gridly dashboard. Make sure you have write access */
     UPROPERTY(Category = "Gridly|Export Settings", BlueprintReadOnly, EditAnywhere, Transient)
     FString ExportApiKey;
@@ -109,6 +131,18 @@ public:
     UPROPERTY(Category = "Gridly|Options", BlueprintReadOnly, EditAnywhere, Config, meta = (EditCondition = "bExportMetadata"))
     TMap<FString, FGridlyColumnInfo> MetadataMapping;
 
+    /** Base URL of the Gridly API. Point it at a local mock server to run syncs without a Gridly account */
+    UPROPERTY(Category = "Gridly|Options|Advanced", BlueprintReadOnly, EditAnywhere, Config)
+    FString ApiBaseUrl = "https://api.gridly.com";
+
+    /** When set, the last live preview dataset is saved to Saved/Gridly and applied on startup of non-editor builds other than Shipping, before any new download has completed */
+    UPROPERTY(Category = "Gridly|Live Preview", BlueprintReadOnly, EditAnywhere, Config)
+    bool bCacheLivePreview = false;
+
+    /** When set, non-editor builds other than Shipping download the import views in the background on startup and only re-register the texts that changed since the cached dataset */
+    UPROPERTY(Category = "Gridly|Live Preview", BlueprintReadOnly, EditAnywhere, Config, meta = (EditCondition = "bCacheLivePreview"))
+    bool bRefreshLivePreviewOnStartup = false;
+
 public:
     UGridlyGameSettings(const FObjectInitializer& ObjectInitializer);
 
@@ -116,6 +150,9 @@ public:
     static FString SerializeArrayToJson(const TArray<FString>& Array);
     static bool DeserializeJsonToArray(const FString& JsonString, TArray<FString>& OutArray);
 
+    /** ApiBaseUrl without a trailing slash, or the URL given on the command line with -GridlyApiUrl= outside of Shipping builds */
+    static FString GetApiBaseUrl();
+
 public:
     static bool OnSettingsSaved();
 
@@ -0,0 +1,51 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Internationalization/PolyglotTextData.h"
+
+/**
+ * Persists the last live preview dataset to Saved/Gridly so that it can be registered on startup,
+ * and keeps track of what has been registered so that refreshes only re-register changed texts.
+ */
+class GRIDLY_API FGridlyLivePreviewCache
+{
+public:
+	static FGridlyLivePreviewCache& Get();
+
+	static FString GetCacheFilePath();
+
+	bool LoadFromFile(TArray<FPolyglotTextData>& OutPolyglotTextDatas) const;
+	bool SaveToFile(const TArray<FPolyglotTextData>& PolyglotTextDatas) const;
+
+	/** Registers the cached dataset with the text localization manager. Returns false if there was no usable cache */
+	bool ApplyCachedDataset();
+
+	/**
+	 * Registers the texts that differ from what has already been applied, and saves the full dataset when caching is enabled.
+	 * The dataset is a complete download: applied texts that it no longer contains are removed again
+	 */
+	int32 ApplyDataset(const TArray<FPolyglotTextData>& PolyglotTextDatas);
+
+private:
+	/** A registered text, with what it takes to register it again without its translations */
+	struct FAppliedText
+	{
+		uint32 Hash = 0;
+		ELocalizedTextSourceCategory Category = ELocalizedTextSourceCategory::Game;
+		FString Namespace;
+		FString Key;
+		FString NativeCulture;
+		FString NativeString;
+	};
+
+	void AddAppliedText(const FPolyglotTextData& PolyglotTextData, uint32 Hash);
+
+	static uint32 HashPolyglotTextData(const FPolyglotTextData& PolyglotTextData);
+	static FString GetIdentity(const FPolyglotTextData& PolyglotTextData);
+
+	/** Every text that has been registered this session, by "{namespace},{key}" */
+	TMap<FString, FAppliedText> AppliedTexts;
+};
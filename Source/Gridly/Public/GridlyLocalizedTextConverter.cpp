@@ -6,28 +6,72 @@
 #include "GridlyCultureConverter.h"
 #include "GridlyDataTableImporterJSON.h"
 #include "GridlyGameSettings.h"
+#include "GridlyProfiling.h"
 #include "Internationalization/PolyglotTextData.h"
 #include "Misc/FileHelper.h"
 
 bool FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(const TArray<FGridlyTableRow>& TableRows,
 	TMap<FString, FPolyglotTextData>& OutPolyglotTextDatas)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::TableRowsToPolyglotTextDatas");
+	SCOPE_CYCLE_COUNTER(STAT_GridlyConvertRows);
+	GRIDLY_ALLOCATION_SCOPE(ConvertRows);
+
 	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
 	const TArray<FString> TargetCultures = FGridlyCultureConverter::GetTargetCultures();
 
 	const bool bUseCombinedNamespaceKey = GameSettings->bUseCombinedNamespaceId;
 	const bool bUsePathAsNamespace = !bUseCombinedNamespaceKey && GameSettings->NamespaceColumnId == "path";
 
+	// Every row has the same columns, so each column ID is matched against the language prefixes and converted to a
+	// culture once, rather than once per cell
+
+	struct FLanguageColumn
+	{
+		FString Culture;
+		bool bIsSource = false;
+	};
+	TArray<FLanguageColumn> LanguageColumns;
+	TMap<FString, int32> LanguageColumnIndices;
+
+	const auto FindLanguageColumn =
+		[&LanguageColumns, &LanguageColumnIndices, &TargetCultures, GameSettings](const FString& ColumnId)
+	{
+		if (const int32* LanguageColumnIndex = LanguageColumnIndices.Find(ColumnId))
+		{
+			return *LanguageColumnIndex;
+		}
+
+		FLanguageColumn LanguageColumn;
+		if (ColumnId.StartsWith(GameSettings->SourceLanguageColumnIdPrefix))
+		{
+			LanguageColumn.bIsSource = FGridlyCultureConverter::ConvertFromGridly(TargetCultures,
+				ColumnId.RightChop(GameSettings->SourceLanguageColumnIdPrefix.Len()), LanguageColumn.Culture);
+		}
+		else if (ColumnId.StartsWith(GameSettings->TargetLanguageColumnIdPrefix))
+		{
+			FGridlyCultureConverter::ConvertFromGridly(TargetCultures,
+				ColumnId.RightChop(GameSettings->TargetLanguageColumnIdPrefix.Len()), LanguageColumn.Culture);
+		}
+		return LanguageColumnIndices.Add(ColumnId, LanguageColumns.Add(MoveTemp(LanguageColumn)));
+	};
+
+	OutPolyglotTextDatas.Reserve(OutPolyglotTextDatas.Num() + TableRows.Num());
+
+	// Language column and text of the translations of the current row
+	TArray<TPair<int32, const FString*>> Translations;
+	const FString EmptyString;
+
 	for (int i = 0; i < TableRows.Num(); i++)
 	{
 		UE_LOG(LogGridly, Verbose, TEXT("Row %d: %s (%s)"), i, *TableRows[i].Id, *TableRows[i].Path);
 
-		FString Key = TableRows[i].Id;
-		FString FullKey = Key;
-		FString Namespace = bUsePathAsNamespace ? TableRows[i].Path : TEXT("");
-		FString SourceCulture;
-		FString SourceText;
-		TMap<FString, FString> Translations;
+		const FString& FullKey = TableRows[i].Id;
+		FString Key = FullKey;
+		FString Namespace = bUsePathAsNamespace ? TableRows[i].Path : FString();
+		int32 SourceColumnIndex = INDEX_NONE;
+		const FString* SourceText = &EmptyString;
+		Translations.Reset();
 
 		for (int j = 0; j < TableRows[i].Cells.Num(); j++)
 		{
@@ -43,24 +87,15 @@ bool FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(const TArray<FG
 
 			// If language column
 
-			if (GridlyTableCell.ColumnId.StartsWith(GameSettings->SourceLanguageColumnIdPrefix))
+			const int32 LanguageColumnIndex = FindLanguageColumn(GridlyTableCell.ColumnId);
+			if (LanguageColumns[LanguageColumnIndex].bIsSource)
 			{
-				const FString GridlyCulture = GridlyTableCell.ColumnId.RightChop(GameSettings->SourceLanguageColumnIdPrefix.Len());
-				FString Culture;
-				if (FGridlyCultureConverter::ConvertFromGridly(TargetCultures, GridlyCulture, Culture))
-				{
-					SourceCulture = Culture;
-					SourceText = GridlyTableCell.Value;
-				}
+				SourceColumnIndex = LanguageColumnIndex;
+				SourceText = &GridlyTableCell.Value;
 			}
-			else if (GridlyTableCell.ColumnId.StartsWith(GameSettings->TargetLanguageColumnIdPrefix))
+			else if (!LanguageColumns[LanguageColumnIndex].Culture.IsEmpty())
 			{
-				const FString GridlyCulture = GridlyTableCell.ColumnId.RightChop(GameSettings->TargetLanguageColumnIdPrefix.Len());
-				FString Culture;
-				if (FGridlyCultureConverter::ConvertFromGridly(TargetCultures, GridlyCulture, Culture))
-				{
-					Translations.Add(Culture, GridlyTableCell.Value);
-				}
+				Translations.Emplace(LanguageColumnIndex, &GridlyTableCell.Value);
 			}
 		}
 
@@ -71,115 +106,114 @@ bool FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(const TArray<FG
 			FString NewKey;
 			if (Key.Split(",", &Namespace, &NewKey))
 			{
-				Key = NewKey;
+				Key = MoveTemp(NewKey);
 			}
 		}
 
-		Namespace = Namespace.Replace(TEXT(" "), TEXT(""));
+		Namespace.ReplaceInline(TEXT(" "), TEXT(""));
 
-		if (SourceText.IsEmpty() || SourceCulture.IsEmpty())
+		const FString& SourceCulture = SourceColumnIndex != INDEX_NONE ? LanguageColumns[SourceColumnIndex].Culture : EmptyString;
+		if (SourceText->IsEmpty() || SourceCulture.IsEmpty())
 		{
 			UE_LOG(LogGridly, Warning, TEXT("Could not find native culture/source string in imported text with key: %s,%s"),
 				*Namespace, *Key);
 			//continue;
 		}
 
-		FPolyglotTextData PolyglotTextData(ELocalizedTextSourceCategory::Game, Namespace, Key, SourceText, SourceCulture);
+		FPolyglotTextData PolyglotTextData(ELocalizedTextSourceCategory::Game, Namespace, Key, *SourceText, SourceCulture);
+
+		// Later cells of the same culture replace earlier ones, even when they are empty
 
-		for (const TPair<FString, FString>& Pair : Translations)
+		for (const TPair<int32, const FString*>& Translation : Translations)
 		{
-			if (!Pair.Value.IsEmpty())
+			const FString& Culture = LanguageColumns[Translation.Key].Culture;
+			if (!Translation.Value->IsEmpty())
 			{
-				PolyglotTextData.AddLocalizedString(Pair.Key, Pair.Value);
+				PolyglotTextData.AddLocalizedString(Culture, *Translation.Value);
+			}
+			else
+			{
+				PolyglotTextData.RemoveLocalizedString(Culture);
 			}
 		}
 
-		OutPolyglotTextDatas.Add(FullKey, PolyglotTextData);
+		OutPolyglotTextDatas.Add(FullKey, MoveTemp(PolyglotTextData));
 	}
 
 	return OutPolyglotTextDatas.Num() > 0;
 }
 
-// Taken from "Engine\Source\Developer\Localization\Private\PortableObjectPipeline.cpp"
-FString ConditionArchiveStrForPO(const FString& InStr)
+// Same escapes as ConditionArchiveStrForPO in "Engine\Source\Developer\Localization\Private\PortableObjectPipeline.cpp",
+// appended in a single pass instead of a copy per escape
+static void AppendArchiveStrForPO(FString& Out, const FString& InStr)
 {
-	FString Result = InStr;
-	Result.ReplaceInline(TEXT("\\"), TEXT("\\\\"), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\""), TEXT("\\\""), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\r"), TEXT("\\r"), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\n"), TEXT("\\n"), ESearchCase::CaseSensitive);
-	Result.ReplaceInline(TEXT("\t"), TEXT("\\t"), ESearchCase::CaseSensitive);
-	return Result;
+	for (const TCHAR Char : InStr)
+	{
+		switch (Char)
+		{
+			case TEXT('\\'): Out += TEXT("\\\\"); break;
+			case TEXT('"'): Out += TEXT("\\\""); break;
+			case TEXT('\r'): Out += TEXT("\\r"); break;
+			case TEXT('\n'): Out += TEXT("\\n"); break;
+			case TEXT('\t'): Out += TEXT("\\t"); break;
+			default: Out.AppendChar(Char); break;
+		}
+	}
 }
 
 bool FGridlyLocalizedTextConverter::WritePoFile(const TArray<FPolyglotTextData>& PolyglotTextDatas, const FString& TargetCulture,
 	const FString& Path)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::WritePoFile");
+	SCOPE_CYCLE_COUNTER(STAT_GridlyWritePoFiles);
+	GRIDLY_ALLOCATION_SCOPE(WritePoFiles);
+
 	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
 	const bool bUseCombinedNamespaceKey = GameSettings->bUseCombinedNamespaceId;
-	TArray<FString> Lines;
-	int numOfLines = 0;
-	TArray<TCHAR> CharsToReplace = { TEXT('\n'), TEXT('\r'), TEXT('\t'), TEXT('"'), TEXT('\\') };
 
-	for (int i = 0; i < PolyglotTextDatas.Num(); i++)
-	{
-		FString TargetString;
+	// The file is written as one string, with the same line terminators as FFileHelper::SaveStringArrayToFile, rather than
+	// as an array with a string per line. Four lines per text
+	FString Lines;
+	int32 NumLines = 0;
+	FString TargetString;
 
-		if (PolyglotTextDatas[i].GetLocalizedString(TargetCulture, TargetString))
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		if (!PolyglotTextData.GetLocalizedString(TargetCulture, TargetString))
 		{
-			if (bUseCombinedNamespaceKey) {
-				Lines.Add(FString::Printf(TEXT("msgctxt \"%s,%s\""), *PolyglotTextDatas[i].GetNamespace(),
-					*PolyglotTextDatas[i].GetKey()));
-			}
-			else {
-				Lines.Add(FString::Printf(TEXT("msgctxt \",%s\""), *PolyglotTextDatas[i].GetKey()));
-			}
-
-			
-			FString NativeString = PolyglotTextDatas[i].GetNativeString().ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgid \"%s\""), *NativeString));
-
-			TargetString = ConditionArchiveStrForPO(TargetString);
-			//TargetString.ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgstr \"%s\""), *TargetString));
-
-			Lines.Add(TEXT(""));
-		}		
-		else {
-			if (bUseCombinedNamespaceKey) {
-				Lines.Add(FString::Printf(TEXT("msgctxt \"%s,%s\""), *PolyglotTextDatas[i].GetNamespace(),
-					*PolyglotTextDatas[i].GetKey()));
-			}
-			else {
-				Lines.Add(FString::Printf(TEXT("msgctxt \",%s\""), *PolyglotTextDatas[i].GetKey()));
-			}
-
-
-			FString NativeString = PolyglotTextDatas[i].GetNativeString().ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgid \"%s\""), *NativeString));
-
-			TargetString = TEXT("");
-			TargetString = TargetString.ReplaceCharWithEscapedChar(&CharsToReplace);
-			Lines.Add(FString::Printf(TEXT("msgstr \"%s\""), *TargetString));
+			TargetString.Reset();
+		}
 
-			Lines.Add(TEXT(""));
+		Lines += TEXT("msgctxt \"");
+		if (bUseCombinedNamespaceKey)
+		{
+			Lines += PolyglotTextData.GetNamespace();
 		}
-		
+		Lines += TEXT(",");
+		Lines += PolyglotTextData.GetKey();
+		Lines += TEXT("\"");
+		Lines += LINE_TERMINATOR;
+		Lines += TEXT("msgid \"");
+		AppendArchiveStrForPO(Lines, PolyglotTextData.GetNativeString());
+		Lines += TEXT("\"");
+		Lines += LINE_TERMINATOR;
+		Lines += TEXT("msgstr \"");
+		AppendArchiveStrForPO(Lines, TargetString);
+		Lines += TEXT("\"");
+		Lines += LINE_TERMINATOR;
+		Lines += LINE_TERMINATOR;
+
+		NumLines += 4;
 	}
 
-	if (FFileHelper::SaveStringArrayToFile(Lines, *Path))
+	if (FFileHelper::SaveStringToFile(Lines, *Path))
 	{
-		UE_LOG(LogGridly, Log, TEXT("Exported .po file (%d lines): %s"), Lines.Num(), *Path);
-		if (Lines.Num() > 0) {
-			return true;
-		}
-		else {
-			return false;
-		}
+		UE_LOG(LogGridly, Log, TEXT("Exported .po file (%d lines): %s"), NumLines, *Path);
+		return NumLines > 0;
 	}
 	else
 	{
 		UE_LOG(LogGridly, Error, TEXT("Failed to export .po file to path: %s"), *Path);
 		return false;
-	}	
+	}
 }
@@ -0,0 +1,182 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/** Trace channel of the plugin. Run with -trace=default,counters,gridly to record the Gridly scopes in Unreal Insights */
+UE_TRACE_CHANNEL_EXTERN(GridlyChannel, GRIDLY_API);
+
+/** Low-level memory tag of the plugin, shown by memreport and stat LLM when run with -llm */
+LLM_DECLARE_TAG_API(Gridly, GRIDLY_API);
+
+DECLARE_STATS_GROUP(TEXT("Gridly"), STATGROUP_Gridly, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decode Pages"), STAT_GridlyDecodePages, STATGROUP_Gridly, GRIDLY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Convert Rows"), STAT_GridlyConvertRows, STATGROUP_Gridly, GRIDLY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Write PO Files"), STAT_GridlyWritePoFiles, STATGROUP_Gridly, GRIDLY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Import Data Tables"), STAT_GridlyImportDataTables, STATGROUP_Gridly, GRIDLY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize Exports"), STAT_GridlySerializeExports, STATGROUP_Gridly, GRIDLY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Diff Records"), STAT_GridlyDiffRecords, STATGROUP_Gridly, GRIDLY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Live Preview"), STAT_GridlyApplyLivePreview, STATGROUP_Gridly, GRIDLY_API);
+
+/** CPU scope on the Gridly trace channel. Allocations within the scope are tracked under the Gridly LLM tag */
+#define GRIDLY_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, GridlyChannel); LLM_SCOPE_BYTAG(Gridly)
+
+/** Counts the allocations of the calling thread within the scope towards a stage, e.g. GRIDLY_ALLOCATION_SCOPE(ConvertRows) */
+#define GRIDLY_ALLOCATION_SCOPE(Stage) \
+	FGridlyProfiling::FAllocationScope PREPROCESSOR_JOIN(GridlyAllocationScope, __LINE__)(EGridlyStage::Stage)
+
+/** Stages of the pipeline whose allocations are counted, one for each cycle stat above */
+enum class EGridlyStage : uint8
+{
+	DecodePages,
+	ConvertRows,
+	WritePoFiles,
+	ImportDataTables,
+	SerializeExports,
+	DiffRecords,
+	ApplyLivePreview,
+	Num
+};
+
+struct FGridlyAllocationCount
+{
+	int64 NumAllocations = 0;
+	int64 NumBytes = 0;
+
+	FGridlyAllocationCount operator-(const FGridlyAllocationCount& Other) const
+	{
+		return { NumAllocations - Other.NumAllocations, NumBytes - Other.NumBytes };
+	}
+};
+
+class FJsonObject;
+
+/** Timing of a single Gridly request. Times are FPlatformTime::Seconds() */
+struct GRIDLY_API FGridlyRequestTiming
+{
+	/** Verb and path of the request with the view ID left out, e.g. "GET v1/views/{viewId}/records" */
+	FString Endpoint;
+
+	int32 ResponseCode = 0;
+	int64 BytesSent = 0;
+	int64 BytesReceived = 0;
+
+	double QueuedSeconds = 0.0;
+	double StartSeconds = 0.0;
+	double FirstByteSeconds = 0.0;
+	double CompleteSeconds = 0.0;
+
+	/** Time spent decoding the response after it completed */
+	double DecodeSeconds = 0.0;
+
+	double GetQueueWait() const { return StartSeconds - QueuedSeconds; }
+	double GetTimeToFirstByte() const { return FirstByteSeconds - StartSeconds; }
+	double GetTransferTime() const { return CompleteSeconds - FirstByteSeconds; }
+	double GetTotalTime() const { return CompleteSeconds - QueuedSeconds + DecodeSeconds; }
+	bool IsSuccess() const { return EHttpResponseCodes::IsOk(ResponseCode); }
+};
+
+struct FGridlyLatencyPercentiles
+{
+	double P50 = 0.0;
+	double P95 = 0.0;
+	double P99 = 0.0;
+};
+
+/** Latency histogram of the requests to one endpoint */
+struct GRIDLY_API FGridlyEndpointStats
+{
+	FString Endpoint;
+	int32 NumRequests = 0;
+	int32 NumFailed = 0;
+	int64 BytesSent = 0;
+	int64 BytesReceived = 0;
+
+	FGridlyLatencyPercentiles QueueWait;
+	FGridlyLatencyPercentiles TimeToFirstByte;
+	FGridlyLatencyPercentiles TransferTime;
+	FGridlyLatencyPercentiles DecodeTime;
+	FGridlyLatencyPercentiles TotalTime;
+};
+
+/**
+ * Traces the traffic and records of the plugin as counters, and reports them to stat Gridly. Every Gridly request reports
+ * when it is queued, sent and completed, which is also kept as a timing per request. All functions are called on the game thread
+ */
+class GRIDLY_API FGridlyProfiling
+{
+public:
+	/** Measures the decoding of a response, from construction to destruction */
+	class GRIDLY_API FDecodeScope
+	{
+	public:
+		explicit FDecodeScope(const FHttpRequestPtr& InRequest);
+		~FDecodeScope();
+
+	private:
+		FHttpRequestPtr Request;
+		double StartSeconds;
+	};
+
+	/** Adds the allocations the calling thread makes during its lifetime to a stage. Nested scopes count towards both stages */
+	class GRIDLY_API FAllocationScope
+	{
+	public:
+		explicit FAllocationScope(EGridlyStage InStage);
+		~FAllocationScope();
+
+	private:
+		EGridlyStage Stage;
+		FGridlyAllocationCount StartCount;
+	};
+
+	/** Call for requests that wait in a queue or for the throttle before they are sent */
+	static void OnRequestQueued(const IHttpRequest& Request);
+
+	/** Call for queued requests that are discarded without being sent */
+	static void OnRequestDropped(const IHttpRequest& Request);
+
+	/** Call right before the request is processed. Binds the header received delegate of the request to time the first byte */
+	static void OnRequestStarted(IHttpRequest& Request);
+
+	static void OnRequestCompleted(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response);
+
+	/** Adds decode time to a completed request, for responses that are decoded off the game thread */
+	static void AddDecodeTime(const FHttpRequestPtr& Request, double Seconds);
+
+	/** Adds records decoded from or encoded for Gridly */
+	static void AddRecords(int32 NumRecords);
+
+	static void AddCacheLookups(int32 NumHits, int32 NumMisses);
+
+	/** Completed requests that were queued or started at or after SinceSeconds, oldest first */
+	static TArray<FGridlyRequestTiming> GetRequestTimings(double SinceSeconds = 0.0);
+
+	static TArray<FGridlyEndpointStats> GetEndpointStats(const TArray<FGridlyRequestTiming>& Timings);
+
+	/** Percentiles per endpoint, and every request as a timeline with times relative to SinceSeconds */
+	static TSharedRef<FJsonObject> RequestTimingsToJson(double SinceSeconds);
+
+	static void ResetRequestTimings();
+
+	/**
+	 * Wraps the global allocator to count the allocations of every thread, which the allocation scopes and stat Gridly report.
+	 * Called on startup when run with -GridlyCountAllocations. Counting cannot be turned off again
+	 */
+	static void EnableAllocationCounting();
+	static bool IsCountingAllocations();
+
+	/** Allocations made by the calling thread since counting was enabled */
+	static FGridlyAllocationCount GetThreadAllocationCount();
+
+	static FGridlyAllocationCount GetStageAllocationCount(EGridlyStage Stage);
+	static void ResetStageAllocationCounts();
+};
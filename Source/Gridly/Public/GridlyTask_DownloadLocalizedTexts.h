@@ -16,6 +16,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FDownloadLocalizedTextsDelegate,
 DECLARE_DELEGATE_OneParam(FDownloadLocalizedTextsSuccessDelegate, const TArray<FPolyglotTextData>&);
 DECLARE_DELEGATE_TwoParams(FDownloadLocalizedTextsProgressDelegate, const TArray<FPolyglotTextData>&, float);
 DECLARE_DELEGATE_TwoParams(FDownloadLocalizedTextsFailDelegate, const TArray<FPolyglotTextData>&, const FGridlyResult&);
+DECLARE_DELEGATE_ThreeParams(FDownloadLocalizedTextsPageNativeDelegate, const TArray<FPolyglotTextData>&, int32, int32);
 
 UCLASS()
 class GRIDLY_API UGridlyTask_DownloadLocalizedTexts : public UBlueprintAsyncActionBase
@@ -44,9 +45,17 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FDownloadLocalizedTextsDelegate OnFail;
 
+	/**
+	 * Fires once per downloaded page with only the texts of that page, and the share of the records received so far as the
+	 * progress. Prefer this over OnProgress for large views
+	 */
+	UPROPERTY(BlueprintAssignable)
+	FDownloadLocalizedTextsDelegate OnPage;
+
 	FDownloadLocalizedTextsSuccessDelegate OnSuccessDelegate;
 	FDownloadLocalizedTextsProgressDelegate OnProgressDelegate;
 	FDownloadLocalizedTextsFailDelegate OnFailDelegate;;
+	FDownloadLocalizedTextsPageNativeDelegate OnPageDelegate;
 
 private:
 	FHttpRequestPtr HttpRequest;
@@ -54,6 +63,7 @@ private:
 
 	int Limit;
 	int TotalCount;
+	int ReceivedCount;
 
 	TArray<FString> ViewIds;
 	int CurrentViewIdIndex;
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "GridlyDataTable.h"
+#include "GridlyDataTableImporterJSON.h"
+#include "GridlyDataset.h"
 #include "GridlyResult.h"
 #include "GridlyTableRow.h"
 #include "Interfaces/IHttpRequest.h"
@@ -17,6 +19,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FImportDataTableFromGridlyDelegat
 DECLARE_DELEGATE_OneParam(FImportDataTableFromGridlySuccessDelegate, const TArray<FGridlyTableRow>&);
 DECLARE_DELEGATE_TwoParams(FImportDataTableFromGridlyProgressDelegate, const TArray<FGridlyTableRow>&, float);
 DECLARE_DELEGATE_TwoParams(FImportDataTableFromGridlyFailDelegate, const TArray<FGridlyTableRow>&, const FGridlyResult&);
+DECLARE_DELEGATE_ThreeParams(FImportDataTableFromGridlyPageNativeDelegate, const TArray<FGridlyTableRow>&, int32, int32);
+DECLARE_DELEGATE(FImportDataTableFromGridlyPreImportDelegate);
 
 UCLASS()
 class GRIDLY_API UGridlyTask_ImportDataTableFromGridly : public UBlueprintAsyncActionBase
@@ -28,14 +32,35 @@ public:
 
 	virtual void Activate() override;
 
+	void RequestViewSchema(const int ViewIdIndex);
+	void OnViewSchemaRequestComplete(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess,
+		const int ViewIdIndex);
 	void RequestPage(const int ViewIdIndex, const int Offset);
-	void OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess);
+	void OnProcessRequestComplete(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess,
+		const int ViewIdIndex);
+	void OnPageDecoded(const bool bDecoded, TArray<FGridlyTableRow>&& TableRows, const int ViewIdIndex,
+		const int ViewIdTotalCount);
 
 public:
 	UFUNCTION(Category = Gridly, BlueprintCallable, meta = (BlueprintInternalUseOnly = true, WorldContext = "WorldContextObject"))
 	static UGridlyTask_ImportDataTableFromGridly* ImportDataTableFromGridly(const UObject* WorldContextObject,
 		UGridlyDataTable* GridlyDataTable);
 
+	/**
+	 * Refreshes a data table in place without hitches, e.g. in a packaged game. Pages are decoded on worker threads and
+	 * only changed rows are written, time-sliced on the game thread. Changed rows are reported through OnRowsChanged on the table
+	 */
+	UFUNCTION(Category = Gridly, BlueprintCallable, meta = (BlueprintInternalUseOnly = true, WorldContext = "WorldContextObject"))
+	static UGridlyTask_ImportDataTableFromGridly* RefreshDataTableFromGridly(const UObject* WorldContextObject,
+		UGridlyDataTable* GridlyDataTable);
+
+	/** Indexed view of the downloaded records, available once the download has completed */
+	const FGridlyDataset& GetDataset() const { return Dataset; }
+
+	/** Copies the indexed records, store the result in a variable rather than calling this per lookup */
+	UFUNCTION(Category = Gridly, BlueprintCallable, meta = (DisplayName = "Get Dataset"))
+	void CopyDataset(FGridlyDataset& OutDataset) const;
+
 public:
 	UPROPERTY(BlueprintAssignable)
 	FImportDataTableFromGridlyDelegate OnSuccess;
@@ -46,23 +71,60 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FImportDataTableFromGridlyDelegate OnFail;
 
+	/**
+	 * Fires once per downloaded page with only the rows of that page, and the share of the records received so far as the
+	 * progress. Prefer this over OnProgress for large views
+	 */
+	UPROPERTY(BlueprintAssignable)
+	FImportDataTableFromGridlyDelegate OnPage;
+
 	FImportDataTableFromGridlySuccessDelegate OnSuccessDelegate;
 	FImportDataTableFromGridlyProgressDelegate OnProgressDelegate;
 	FImportDataTableFromGridlyFailDelegate OnFailDelegate;;
+	FImportDataTableFromGridlyPageNativeDelegate OnPageDelegate;
+
+	/** Fires right before the downloaded rows replace the rows of the table, on the same frame as OnSuccessDelegate or OnFailDelegate */
+	FImportDataTableFromGridlyPreImportDelegate OnPreImportDelegate;
 
 private:
-	FHttpRequestPtr HttpRequest;
+	bool ValidateViewSchema();
+	void OnAllViewsDownloaded();
+	void BroadcastFail(const FGridlyResult& FailResult);
+	void StartRuntimeRefresh();
+	bool TickRuntimeRefresh(float DeltaTime);
+
+	struct FViewDownload
+	{
+		int Offset = 0;
+		int TotalCount = 0;
+		int ReceivedCount = 0;
+	};
+
 	const UObject* WorldContextObject;
 
 	int Limit;
 	int TotalCount;
+	bool bFailed = false;
 
 	TArray<FString> ViewIds;
-	int CurrentViewIdIndex;
-	int CurrentOffset;
+	TArray<FString> ViewColumnIds;
+	bool bHasViewSchema = false;
+	TArray<FViewDownload> ViewDownloads;
+	int NumPendingViews;
 
 	TArray<FGridlyTableRow> GridlyTableRows;
 
+	/** View index of each downloaded row, only tracked when importing from several views */
+	TArray<int32> RowViewIndices;
+	FGridlyDataset Dataset;
+
+	bool bRuntimeRefresh = false;
+	TArray<TSharedPtr<FJsonObject>> RowObjects;
+	TUniquePtr<FGridlyDataTableImporterJSON> RefreshImporter;
+	TArray<FString> RefreshProblems;
+	TArray<FName> ChangedRowNames;
+	int RefreshRowIndex;
+
 	UPROPERTY()
 	UGridlyDataTable* GridlyDataTable;
 };
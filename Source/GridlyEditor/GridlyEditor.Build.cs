@@ -25,11 +25,13 @@ public class GridlyEditor : ModuleRules
 				"Json",
 				"JsonUtilities",
 				"HTTP",
+				"HTTPServer",
 				"Serialization",
 				"Localization",
 				"LocalizationCommandletExecution",
 				"MainFrame",
 				"DesktopPlatform",
+				"WorkspaceMenuStructure",
 				"Gridly"
 			}
 		);
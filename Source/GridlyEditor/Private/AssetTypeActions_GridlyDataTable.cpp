@@ -6,9 +6,12 @@
 #include "DataTableEditorUtils.h"
 #include "DesktopPlatformModule.h"
 #include "GridlyEditor.h"
+#include "GridlyDataTableSnapshot.h"
 #include "GridlyExporter.h"
 #include "GridlyGameSettings.h"
+#include "GridlyProfiling.h"
 #include "GridlyStyle.h"
+#include "GridlySyncEstimate.h"
 #include "GridlyTableRow.h"
 #include "GridlyTask_ImportDataTableFromGridly.h"
 #include "HttpModule.h"
@@ -23,6 +26,7 @@
 #include "EditorStyleSet.h"
 #include "UObject/WeakObjectPtr.h"
 #include "ObjectTools.h"
+#include "ScopedTransaction.h"
 
 #define LOCTEXT_NAMESPACE "AssetTypeActions"
 
@@ -85,6 +89,41 @@ void FAssetTypeActions_GridlyDataTable::GetActions(const TArray<UObject*>& InObj
 			)
 		);
 
+	Section.AddMenuEntry(
+		"DataTable_FullExportToGridly",
+		LOCTEXT("DataTable_FullExportToGridly", "Export All Rows to Gridly"),
+		LOCTEXT("DataTable_FullExportToGridlyTooltip",
+			"Export every row to Gridly, including rows that have not changed since the last sync"),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateSP(this, &FAssetTypeActions_GridlyDataTable::ExecuteFullExportToGridly, Tables),
+			FCanExecuteAction()
+			)
+		);
+
+	Section.AddMenuEntry(
+		"DataTable_RevertGridlyImport",
+		LOCTEXT("DataTable_RevertGridlyImport", "Revert Last Gridly Import"),
+		LOCTEXT("DataTable_RevertGridlyImportTooltip", "Restore the rows from before the last import from Gridly"),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateSP(this, &FAssetTypeActions_GridlyDataTable::ExecuteRevertGridlyImport, Tables),
+			FCanExecuteAction::CreateSP(this, &FAssetTypeActions_GridlyDataTable::CanExecuteRevertGridlyImport, Tables)
+			)
+		);
+
+	Section.AddMenuEntry(
+		"DataTable_EstimateGridlySync",
+		LOCTEXT("DataTable_EstimateGridlySync", "Estimate Sync with Gridly"),
+		LOCTEXT("DataTable_EstimateGridlySyncTooltip",
+			"Estimate the requests, payload and duration of importing and exporting the data table, without changing anything"),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateSP(this, &FAssetTypeActions_GridlyDataTable::ExecuteEstimateGridlySync, Tables),
+			FCanExecuteAction()
+			)
+		);
+
 	Section.AddMenuEntry(
 		"DataTable_ExportAsCSV",
 		LOCTEXT("DataTable_ExportAsCSV", "Export as CSV"),
@@ -190,7 +229,7 @@ void FAssetTypeActions_GridlyDataTable::OpenAssetEditor(const TArray<UObject*>&
 		CommandList->MapAction(FGridlyDataTableCommands::Get().ImportFromGridly,
 			FExecuteAction::CreateRaw(this, &FAssetTypeActions_GridlyDataTable::ImportFromGridly, GridlyDataTable));
 		CommandList->MapAction(FGridlyDataTableCommands::Get().ExportToGridly,
-			FExecuteAction::CreateRaw(this, &FAssetTypeActions_GridlyDataTable::ExportToGridly, GridlyDataTable));
+			FExecuteAction::CreateRaw(this, &FAssetTypeActions_GridlyDataTable::ExportToGridly, GridlyDataTable, false));
 
 		Extender->AddToolBarExtension("DataTableCommands", EExtensionHook::Before, CommandList,
 			FToolBarExtensionDelegate::CreateRaw(this, &FAssetTypeActions_GridlyDataTable::AddToolbarButton));
@@ -213,6 +252,114 @@ void FAssetTypeActions_GridlyDataTable::ExecuteImportFromGridly(TArray<TWeakObje
 	}
 }
 
+void FAssetTypeActions_GridlyDataTable::ExecuteFullExportToGridly(TArray<TWeakObjectPtr<UObject>> Objects)
+{
+	for (auto ObjIt = Objects.CreateConstIterator(); ObjIt; ++ObjIt)
+	{
+		if (UGridlyDataTable* GridlyDataTable = Cast<UGridlyDataTable>((*ObjIt).Get()))
+		{
+			ExportToGridly(GridlyDataTable, true);
+		}
+	}
+}
+
+void FAssetTypeActions_GridlyDataTable::ExecuteRevertGridlyImport(TArray<TWeakObjectPtr<UObject>> Objects)
+{
+	for (auto ObjIt = Objects.CreateConstIterator(); ObjIt; ++ObjIt)
+	{
+		UGridlyDataTable* GridlyDataTable = Cast<UGridlyDataTable>((*ObjIt).Get());
+		TArray<uint8> Backup;
+		if (GridlyDataTable && ImportBackups.RemoveAndCopyValue(GridlyDataTable->GetUniqueID(), Backup))
+		{
+			FDataTableEditorUtils::BroadcastPreChange(GridlyDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+			if (FGridlyDataTableSnapshot::LoadFromMemory(*GridlyDataTable, Backup))
+			{
+				GridlyDataTable->MarkPackageDirty();
+			}
+			else
+			{
+				UE_LOG(LogGridlyEditor, Error, TEXT("Failed to revert the last Gridly import of %s"), *GridlyDataTable->GetName());
+			}
+			FDataTableEditorUtils::BroadcastPostChange(GridlyDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+		}
+	}
+}
+
+bool FAssetTypeActions_GridlyDataTable::CanExecuteRevertGridlyImport(TArray<TWeakObjectPtr<UObject>> Objects) const
+{
+	for (auto ObjIt = Objects.CreateConstIterator(); ObjIt; ++ObjIt)
+	{
+		const UObject* Object = (*ObjIt).Get();
+		if (Object && ImportBackups.Contains(Object->GetUniqueID()))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool CreateExportRequest(const UGridlyDataTable* GridlyDataTable, const TMap<FName, TBitArray<>>& DirtyCells,
+	const size_t StartIndex, TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>& ExportRequest);
+
+void FAssetTypeActions_GridlyDataTable::ExecuteEstimateGridlySync(TArray<TWeakObjectPtr<UObject>> Objects)
+{
+	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+
+	for (auto ObjIt = Objects.CreateConstIterator(); ObjIt; ++ObjIt)
+	{
+		UGridlyDataTable* GridlyDataTable = Cast<UGridlyDataTable>((*ObjIt).Get());
+		if (!GridlyDataTable || GridlyDataTable->ViewId.IsEmpty())
+		{
+			continue;
+		}
+
+		// The export requests are built exactly as for an export, but not sent
+
+		const TSharedRef<FGridlySyncEstimate> Estimate = MakeShared<FGridlySyncEstimate>();
+
+		TMap<FName, TBitArray<>> DirtyCells;
+		if (GridlyDataTable->GetDirtyCells(DirtyCells))
+		{
+			size_t StartIndex = 0;
+			TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+			while (CreateExportRequest(GridlyDataTable, DirtyCells, StartIndex, HttpRequest))
+			{
+				Estimate->ExportRequests++;
+				Estimate->ExportPayloadBytes += HttpRequest->GetContentLength();
+				StartIndex += GameSettings->ExportMaxRecordsPerRequest;
+			}
+			Estimate->ExportRecords = DirtyCells.Num();
+		}
+
+		// An import requests the schema of every view before its pages
+
+		TArray<FString> ViewIds;
+		ViewIds.Add(GridlyDataTable->ViewId);
+		for (const FString& AdditionalViewId : GridlyDataTable->AdditionalViewIds)
+		{
+			if (!AdditionalViewId.IsEmpty())
+			{
+				ViewIds.AddUnique(AdditionalViewId);
+			}
+		}
+		Estimate->ImportRequests += ViewIds.Num();
+
+		const int32 RecordsPerRequest = GameSettings->ImportMaxRecordsPerRequest;
+		const FString TableName = GridlyDataTable->GetName();
+
+		FGridlySyncEstimate::RequestRecordCounts(ViewIds, GameSettings->ImportApiKey,
+			[Estimate, RecordsPerRequest, TableName](const TArray<int32>& RecordCounts)
+			{
+				Estimate->AddImport(RecordCounts, RecordsPerRequest);
+
+				const FString Message = FString::Printf(TEXT("Estimated sync of %s:\n%s"), *TableName, *Estimate->ToString());
+				UE_LOG(LogGridlyEditor, Log, TEXT("%s"), *Message);
+				FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+			});
+	}
+}
+
 void FAssetTypeActions_GridlyDataTable::ExecuteExportAsCSV(TArray<TWeakObjectPtr<UObject>> Objects)
 {
 	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
@@ -240,9 +387,9 @@ void FAssetTypeActions_GridlyDataTable::ExecuteExportAsCSV(TArray<TWeakObjectPtr
 				OutFilenames
 				);
 
-			if (OutFilenames.Num() > 0)
+			if (OutFilenames.Num() > 0 && !FGridlyExporter::ExportToCSVFile(DataTable, OutFilenames[0]))
 			{
-				FFileHelper::SaveStringToFile(DataTable->GetTableAsCSV(), *OutFilenames[0]);
+				UE_LOG(LogGridlyEditor, Error, TEXT("Failed to export %s as CSV to %s"), *DataTable->GetName(), *OutFilenames[0]);
 			}
 		}
 	}
@@ -275,10 +422,9 @@ void FAssetTypeActions_GridlyDataTable::ExecuteExportAsJSON(TArray<TWeakObjectPt
 				OutFilenames
 				);
 
-			if (OutFilenames.Num() > 0)
+			if (OutFilenames.Num() > 0 && !FGridlyExporter::ExportToJSONFile(DataTable, OutFilenames[0]))
 			{
-				FFileHelper::SaveStringToFile(DataTable->GetTableAsJSON(EDataTableExportFlags::UseJsonObjectsForStructs),
-					*OutFilenames[0]);
+				UE_LOG(LogGridlyEditor, Error, TEXT("Failed to export %s as JSON to %s"), *DataTable->GetName(), *OutFilenames[0]);
 			}
 		}
 	}
@@ -308,6 +454,33 @@ void FAssetTypeActions_GridlyDataTable::ImportFromGridly(UGridlyDataTable* DataT
 	UGridlyTask_ImportDataTableFromGridly* Task =
 		UGridlyTask_ImportDataTableFromGridly::ImportDataTableFromGridly(nullptr, GridlyDataTable);
 
+	// The transaction only spans the synchronous replacement of the rows. It is opened right before and closed by whichever of
+	// the callbacks fires, and the editor is notified once when the import has completed
+
+	const TSharedRef<TUniquePtr<FScopedTransaction>> Transaction = MakeShared<TUniquePtr<FScopedTransaction>>();
+	ImportBackups.Remove(GridlyDataTable->GetUniqueID());
+
+	switch (GetDefault<UGridlyGameSettings>()->DataTableImportUndoMode)
+	{
+		case EGridlyDataTableImportUndoMode::Full:
+			Task->OnPreImportDelegate.BindLambda([Transaction]()
+			{
+				*Transaction = MakeUnique<FScopedTransaction>(LOCTEXT("ImportGridlyDataTableTransaction", "Import Data Table from Gridly"));
+			});
+			break;
+		case EGridlyDataTableImportUndoMode::Snapshot:
+		{
+			TArray<uint8>& Backup = ImportBackups.Add(GridlyDataTable->GetUniqueID());
+			if (!FGridlyDataTableSnapshot::SaveToMemory(*GridlyDataTable, Backup))
+			{
+				ImportBackups.Remove(GridlyDataTable->GetUniqueID());
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
 	FDataTableEditorUtils::BroadcastPreChange(GridlyDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
 
 	Task->OnProgressDelegate.BindLambda(
@@ -318,17 +491,20 @@ void FAssetTypeActions_GridlyDataTable::ImportFromGridly(UGridlyDataTable* DataT
 		});
 
 	Task->OnSuccessDelegate.BindLambda(
-		[GridlyDataTable, &SlowTask](const TArray<FGridlyTableRow>& GridlyTableRows) mutable
+		[GridlyDataTable, &SlowTask, Transaction](const TArray<FGridlyTableRow>& GridlyTableRows) mutable
 		{
 			SlowTask.Reset();
+			Transaction->Reset();
 			FDataTableEditorUtils::BroadcastPostChange(GridlyDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+			GridlyDataTable->MarkSynced();
 		});
 
 	Task->OnFailDelegate.BindLambda(
-		[GridlyDataTable, &SlowTask](const TArray<FGridlyTableRow>& GridlyTableRows,
+		[GridlyDataTable, &SlowTask, Transaction](const TArray<FGridlyTableRow>& GridlyTableRows,
 		const FGridlyResult& GridlyResult) mutable
 		{
 			SlowTask.Reset();
+			Transaction->Reset();
 			FDataTableEditorUtils::BroadcastPostChange(GridlyDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
 
 			const FString ErrorMessage = GridlyResult.Message;
@@ -339,20 +515,21 @@ void FAssetTypeActions_GridlyDataTable::ImportFromGridly(UGridlyDataTable* DataT
 	Task->Activate();
 }
 
-bool CreateExportRequest(const UGridlyDataTable* GridlyDataTable,
+bool CreateExportRequest(const UGridlyDataTable* GridlyDataTable, const TMap<FName, TBitArray<>>& DirtyCells,
 	const size_t StartIndex, TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>& ExportRequest)
 {
 	FString JsonString;
 	if (FGridlyExporter::ConvertToJson(GridlyDataTable, JsonString, StartIndex,
-		GetMutableDefault<UGridlyGameSettings>()->ExportMaxRecordsPerRequest))
+		GetMutableDefault<UGridlyGameSettings>()->ExportMaxRecordsPerRequest, &DirtyCells))
 	{
 		const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
 		const FString ApiKey = GameSettings->ExportApiKey;
 		const FString ViewId = GridlyDataTable->ViewId;
 
 		FStringFormatNamedArguments Args;
+		Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
 		Args.Add(TEXT("ViewId"), *ViewId);
-		const FString Url = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/records"), Args);
+		const FString Url = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}/records"), Args);
 
 		const auto HttpRequest = FHttpModule::Get().CreateRequest();
 		HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
@@ -370,8 +547,22 @@ bool CreateExportRequest(const UGridlyDataTable* GridlyDataTable,
 	return false;
 }
 
-void FAssetTypeActions_GridlyDataTable::ExportToGridly(UGridlyDataTable* DataTable)
+void FAssetTypeActions_GridlyDataTable::ExportToGridly(UGridlyDataTable* DataTable, const bool bFullExport)
 {
+	// Only rows and cells that changed since the last export or import are uploaded, unless the full table is exported
+
+	TMap<FName, TBitArray<>> DirtyCells;
+	if (!DataTable->GetDirtyCells(DirtyCells, bFullExport))
+	{
+		const FString Message = bFullExport
+			? TEXT("Nothing to export, the data table has no rows.")
+			: TEXT("Nothing to export, no rows have changed since the last sync with Gridly. "
+				"Use Export All Rows to Gridly to export the whole table.");
+		UE_LOG(LogGridlyEditor, Log, TEXT("%s"), *Message);
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+		return;
+	}
+
 	const FString ConfirmMessage = FString::Printf(
 		TEXT("This may overwrite some of your data on Gridly (view ID %s). Are you sure you wish to export?"), *DataTable->ViewId);
 	const EAppReturnType::Type MessageReturn = FMessageDialog::Open(EAppMsgType::YesNo,
@@ -393,12 +584,15 @@ void FAssetTypeActions_GridlyDataTable::ExportToGridly(UGridlyDataTable* DataTab
 	size_t TotalRequests = 0;
 	size_t StartIndex = 0;
 	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
-	while (CreateExportRequest(GridlyDataTable, StartIndex, HttpRequest))
+	TWeakObjectPtr<UGridlyDataTable> WeakGridlyDataTable(GridlyDataTable);
+	while (CreateExportRequest(GridlyDataTable, DirtyCells, StartIndex, HttpRequest))
 	{
 		HttpRequest->OnProcessRequestComplete().
-		             BindLambda([this, ExportDataTableToGridlySlowTask](FHttpRequestPtr HttpRequest,
+		             BindLambda([this, ExportDataTableToGridlySlowTask, WeakGridlyDataTable](FHttpRequestPtr HttpRequest,
 			             FHttpResponsePtr HttpResponse, bool bSuccess) mutable
 			             {
+				             FGridlyProfiling::OnRequestCompleted(HttpRequest, HttpResponse);
+
 				             if (bSuccess
 				                 && (HttpResponse->GetResponseCode() == EHttpResponseCodes::Ok ||
 				                     HttpResponse->GetResponseCode() == EHttpResponseCodes::Created))
@@ -408,17 +602,28 @@ void FAssetTypeActions_GridlyDataTable::ExportToGridly(UGridlyDataTable* DataTab
 					             TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> NextHttpRequest;
 					             if (this->ExportRequestQueue.Dequeue(NextHttpRequest))
 					             {
+						             FGridlyProfiling::OnRequestStarted(*NextHttpRequest);
 						             NextHttpRequest->ProcessRequest();
 					             }
 					             else
 					             {
 						             ExportDataTableToGridlySlowTask.Reset();
+						             if (WeakGridlyDataTable.IsValid())
+						             {
+							             WeakGridlyDataTable->MarkSynced();
+						             }
 					             }
 				             }
 				             else
 				             {
 					             ExportDataTableToGridlySlowTask.Reset();
-								 this->ExportRequestQueue.Empty();
+
+					             TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> DroppedHttpRequest;
+					             while (this->ExportRequestQueue.Dequeue(DroppedHttpRequest))
+					             {
+						             FGridlyProfiling::OnRequestDropped(*DroppedHttpRequest);
+					             }
+
 					             const FString Content = HttpResponse->GetContentAsString();
 					             const FString ErrorReason =
 						             FString::Printf(TEXT("Error: %d, reason: %s"), HttpResponse->GetResponseCode(), *Content);
@@ -427,6 +632,7 @@ void FAssetTypeActions_GridlyDataTable::ExportToGridly(UGridlyDataTable* DataTab
 				             }
 			             });
 		ExportRequestQueue.Enqueue(HttpRequest);
+		FGridlyProfiling::OnRequestQueued(*HttpRequest);
 		StartIndex += GetMutableDefault<UGridlyGameSettings>()->ExportMaxRecordsPerRequest;
 		TotalRequests++;
 	}
@@ -435,6 +641,7 @@ void FAssetTypeActions_GridlyDataTable::ExportToGridly(UGridlyDataTable* DataTab
 	{
 		ExportDataTableToGridlySlowTask->TotalAmountOfWork = static_cast<float>(TotalRequests);
 		ExportDataTableToGridlySlowTask->MakeDialog();
+		FGridlyProfiling::OnRequestStarted(*HttpRequest);
 		HttpRequest->ProcessRequest();
 	}
 	else
@@ -463,5 +670,6 @@ void FAssetTypeActions_GridlyDataTable::AddToolbarButton(FToolBarBuilder& Builde
 }
 
 TMap<uint32, TSharedPtr<FScopedSlowTask, ESPMode::ThreadSafe>> FAssetTypeActions_GridlyDataTable::ImportSlowTasks;
+TMap<uint32, TArray<uint8>> FAssetTypeActions_GridlyDataTable::ImportBackups;
 
 #undef LOCTEXT_NAMESPACE
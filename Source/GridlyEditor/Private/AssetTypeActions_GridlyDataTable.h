@@ -22,14 +22,22 @@ public:
 
 private:
 	void ExecuteImportFromGridly(TArray<TWeakObjectPtr<UObject>> Objects);
+	void ExecuteFullExportToGridly(TArray<TWeakObjectPtr<UObject>> Objects);
+	void ExecuteRevertGridlyImport(TArray<TWeakObjectPtr<UObject>> Objects);
+	bool CanExecuteRevertGridlyImport(TArray<TWeakObjectPtr<UObject>> Objects) const;
+	void ExecuteEstimateGridlySync(TArray<TWeakObjectPtr<UObject>> Objects);
 	void ExecuteExportAsCSV(TArray<TWeakObjectPtr<UObject>> Objects);
 	void ExecuteExportAsJSON(TArray<TWeakObjectPtr<UObject>> Objects);
 
 private:
 	void ImportFromGridly(UGridlyDataTable* DataTable);
-	void ExportToGridly(UGridlyDataTable* DataTable);
+	/** Exports the rows and cells changed since the last sync, or every row when bFullExport is set */
+	void ExportToGridly(UGridlyDataTable* DataTable, bool bFullExport);
 	void AddToolbarButton(FToolBarBuilder& Builder);
 
 	TQueue<TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>> ExportRequestQueue;
 	static TMap<uint32, TSharedPtr<FScopedSlowTask, ESPMode::ThreadSafe>> ImportSlowTasks;
+
+	/** Rows from before the last import of each table, kept when the import undo mode is Snapshot */
+	static TMap<uint32, TArray<uint8>> ImportBackups;
 };
@@ -0,0 +1,278 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyBenchmark.h"
+
+#include "GridlyCultureConverter.h"
+#include "GridlyDataTable.h"
+#include "GridlyDataTableImporterJSON.h"
+#include "GridlyExporter.h"
+#include "GridlyGameSettings.h"
+#include "GridlyLocalizationServiceProvider.h"
+#include "GridlyLocalizedText.h"
+#include "GridlyLocalizedTextConverter.h"
+#include "GridlySyncEstimate.h"
+#include "JsonObjectConverter.h"
+#include "LocTextHelper.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace GridlyBenchmark
+{
+	/** Share of the records that the CSV diff finds missing locally, so that deletions are estimated too */
+	static const int32 StaleRecordInterval = 100;
+}
+
+const TCHAR* const FGridlyBenchmark::DefaultSizes = TEXT("1000,10000");
+
+double FGridlyBenchmark::FStageResult::GetMedianSeconds() const
+{
+	if (Seconds.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	TArray<double> SortedSeconds = Seconds;
+	SortedSeconds.Sort();
+	const int32 Middle = SortedSeconds.Num() / 2;
+	return SortedSeconds.Num() % 2 == 0 ? (SortedSeconds[Middle - 1] + SortedSeconds[Middle]) * 0.5 : SortedSeconds[Middle];
+}
+
+double FGridlyBenchmark::FStageResult::GetMinSeconds() const
+{
+	return Seconds.Num() > 0 ? FMath::Min(Seconds) : 0.0;
+}
+
+double FGridlyBenchmark::FStageResult::GetAllocationsPerRecord() const
+{
+	return NumRecords > 0 ? static_cast<double>(Allocations.NumAllocations) / NumRecords : 0.0;
+}
+
+FGridlyBenchmark::FGridlyBenchmark(const FGridlySyntheticDataShape& Shape)
+	: SyntheticData(Shape)
+	, RecordsJson(SyntheticData.ToRecordsJson())
+	, DataTableJson(SyntheticData.ToDataTableJson())
+	, CSV(SyntheticData.ToCSV())
+	, PolyglotTextDatas(SyntheticData.ToPolyglotTextDatas())
+	, WorkingDir(FPaths::ProjectIntermediateDir() / TEXT("Gridly") / TEXT("Benchmark"))
+{
+	GridlyDataTable = NewObject<UGridlyDataTable>(GetTransientPackage(), NAME_None, RF_Transient);
+	GridlyDataTable->AddToRoot();
+	GridlyDataTable->RowStruct = FGridlySyntheticRow::StaticStruct();
+}
+
+FGridlyBenchmark::~FGridlyBenchmark()
+{
+	GridlyDataTable->RemoveFromRoot();
+	IFileManager::Get().DeleteDirectory(*WorkingDir, false, true);
+}
+
+const TArray<FString>& FGridlyBenchmark::GetStageNames()
+{
+	static const TArray<FString> StageNames = { TEXT("DecodePage"), TEXT("ConvertCultures"), TEXT("ConvertRows"),
+		TEXT("WritePoFiles"), TEXT("ImportDataTable"), TEXT("SerializeTexts"), TEXT("SerializeDataTable"), TEXT("DiffRecords"),
+		TEXT("GatherTexts") };
+	return StageNames;
+}
+
+bool FGridlyBenchmark::RunStage(const FString& Stage, const int32 Iterations, FStageResult& OutResult, FString& OutError)
+{
+	const int32 NumRecords = SyntheticData.GetTableRows().Num();
+
+	if (Stage == TEXT("DecodePage"))
+	{
+		TArray<FGridlyTableRow> TableRows;
+		OutResult = Measure(Stage, Iterations,
+			[&TableRows]() { TableRows.Reset(); },
+			[this, &TableRows]() { FJsonObjectConverter::JsonArrayStringToUStruct(RecordsJson, &TableRows, 0, 0); });
+	}
+	else if (Stage == TEXT("ConvertCultures"))
+	{
+		const TArray<FString> TargetCultures = FGridlyCultureConverter::GetTargetCultures();
+		const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+
+		OutResult = Measure(Stage, Iterations, []() {},
+			[this, &TargetCultures, GameSettings]()
+			{
+				for (const FGridlyTableRow& TableRow : SyntheticData.GetTableRows())
+				{
+					for (const FGridlyTableCell& Cell : TableRow.Cells)
+					{
+						const int32 PrefixLen = Cell.ColumnId.StartsWith(GameSettings->SourceLanguageColumnIdPrefix)
+							? GameSettings->SourceLanguageColumnIdPrefix.Len()
+							: GameSettings->TargetLanguageColumnIdPrefix.Len();
+						FString Culture;
+						FGridlyCultureConverter::ConvertFromGridly(TargetCultures, Cell.ColumnId.RightChop(PrefixLen), Culture);
+					}
+				}
+			});
+	}
+	else if (Stage == TEXT("ConvertRows"))
+	{
+		TMap<FString, FPolyglotTextData> ConvertedTextDatas;
+		OutResult = Measure(Stage, Iterations,
+			[&ConvertedTextDatas]() { ConvertedTextDatas.Reset(); },
+			[this, &ConvertedTextDatas]()
+			{
+				FGridlyLocalizedTextConverter::TableRowsToPolyglotTextDatas(SyntheticData.GetTableRows(), ConvertedTextDatas);
+			});
+	}
+	else if (Stage == TEXT("WritePoFiles"))
+	{
+		// One .po file per target language, as the download task writes them
+		const TArray<FString> Cultures = SyntheticData.GetCultures();
+		const FString PoDir = WorkingDir / TEXT("Po");
+
+		OutResult = Measure(Stage, Iterations, []() {},
+			[this, &Cultures, &PoDir]()
+			{
+				for (int32 i = 1; i < Cultures.Num(); i++)
+				{
+					FGridlyLocalizedTextConverter::WritePoFile(PolyglotTextDatas, Cultures[i], PoDir / Cultures[i] + TEXT(".po"));
+				}
+			});
+	}
+	else if (Stage == TEXT("ImportDataTable"))
+	{
+		TArray<FString> ImportProblems;
+		OutResult = Measure(Stage, Iterations,
+			[&ImportProblems]() { ImportProblems.Reset(); },
+			[this, &ImportProblems]() { FGridlyDataTableImporterJSON(*GridlyDataTable, DataTableJson, ImportProblems).ReadTable(); });
+	}
+	else if (Stage == TEXT("SerializeTexts"))
+	{
+		FString JsonString;
+		OutResult = Measure(Stage, Iterations,
+			[&JsonString]() { JsonString.Reset(); },
+			[this, &JsonString]() { FGridlyExporter::ConvertToJson(PolyglotTextDatas, true, nullptr, JsonString); });
+	}
+	else if (Stage == TEXT("SerializeDataTable"))
+	{
+		ImportDataTable();
+
+		FString JsonString;
+		OutResult = Measure(Stage, Iterations,
+			[&JsonString]() { JsonString.Reset(); },
+			[this, &JsonString, NumRecords]() { FGridlyExporter::ConvertToJson(GridlyDataTable, JsonString, 0, NumRecords); });
+	}
+	else if (Stage == TEXT("DiffRecords"))
+	{
+		// A dry run estimate is set so that the stale records the diff finds are only counted and never deleted. Every few
+		// records are left out of the local texts, so that the diff finds stale records
+
+		if (!Provider)
+		{
+			Provider = MakeUnique<FGridlyLocalizationServiceProvider>();
+		}
+
+		const TSharedRef<FGridlySyncEstimate> Estimate = MakeShared<FGridlySyncEstimate>();
+
+		OutResult = Measure(Stage, Iterations,
+			[this, Estimate]()
+			{
+				Provider->UERecords.Reset();
+				Provider->GridlyRecords.Reset();
+				for (int32 i = 0; i < PolyglotTextDatas.Num(); i++)
+				{
+					if (i % GridlyBenchmark::StaleRecordInterval != 0)
+					{
+						Provider->UERecords.Add(FGridlyLocalizationServiceProvider::FGridlyTypeRecord(
+							PolyglotTextDatas[i].GetKey(), PolyglotTextDatas[i].GetNamespace()));
+					}
+				}
+				Provider->SetDryRunEstimate(Estimate);
+			},
+			[this]() { Provider->ParseCSVAndCreateRecords(CSV); });
+
+		Provider->SetDryRunEstimate(nullptr);
+		Provider->UERecords.Empty();
+		Provider->GridlyRecords.Empty();
+
+		if (Estimate->DeleteRecords == 0)
+		{
+			OutError = TEXT("The diff found no stale records");
+			return false;
+		}
+	}
+	else if (Stage == TEXT("GatherTexts"))
+	{
+		// The synthetic texts are written as a manifest and archives once, and read back on every run
+
+		const FString LocalizationDir = WorkingDir / TEXT("Localization");
+		if (!bLocalizationWritten)
+		{
+			FText WriteError;
+			if (!SyntheticData.WriteLocalization(LocalizationDir, &WriteError))
+			{
+				OutError = WriteError.ToString();
+				return false;
+			}
+			bLocalizationWritten = true;
+		}
+
+		const TArray<FString> Cultures = SyntheticData.GetCultures();
+		TArray<FPolyglotTextData> GatheredTextDatas;
+		bool bGathered = true;
+
+		OutResult = Measure(Stage, Iterations,
+			[&GatheredTextDatas]() { GatheredTextDatas.Reset(); },
+			[&LocalizationDir, &Cultures, &GatheredTextDatas, &bGathered]()
+			{
+				TSharedPtr<FLocTextHelper> LocTextHelper;
+				bGathered &= FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(LocalizationDir,
+					FGridlySyntheticData::ManifestName, FGridlySyntheticData::ArchiveName, Cultures[0], Cultures, GatheredTextDatas,
+					LocTextHelper);
+			});
+
+		if (!bGathered || GatheredTextDatas.Num() != NumRecords)
+		{
+			OutError = FString::Printf(TEXT("Gathered %d of %d texts"), GatheredTextDatas.Num(), NumRecords);
+			return false;
+		}
+	}
+	else
+	{
+		OutError = FString::Printf(TEXT("Unknown stage %s"), *Stage);
+		return false;
+	}
+
+	return true;
+}
+
+FGridlyBenchmark::FStageResult FGridlyBenchmark::Measure(const FString& Stage, const int32 Iterations,
+	TFunctionRef<void()> Setup, TFunctionRef<void()> Run) const
+{
+	FStageResult Result;
+	Result.Stage = Stage;
+	Result.NumRecords = SyntheticData.GetTableRows().Num();
+	Result.Seconds.Reserve(Iterations);
+
+	// The first run fills caches and allocator pools, and is not counted
+
+	for (int32 i = -1; i < Iterations; i++)
+	{
+		Setup();
+
+		const FGridlyAllocationCount StartAllocations = FGridlyProfiling::GetThreadAllocationCount();
+		const double StartSeconds = FPlatformTime::Seconds();
+		Run();
+		const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+		if (i >= 0)
+		{
+			Result.Seconds.Add(Seconds);
+			Result.Allocations = FGridlyProfiling::GetThreadAllocationCount() - StartAllocations;
+		}
+	}
+
+	return Result;
+}
+
+void FGridlyBenchmark::ImportDataTable()
+{
+	if (GridlyDataTable->GetRowMap().Num() == 0)
+	{
+		TArray<FString> ImportProblems;
+		FGridlyDataTableImporterJSON(*GridlyDataTable, DataTableJson, ImportProblems).ReadTable();
+	}
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridlyProfiling.h"
+#include "GridlySyntheticData.h"
+#include "Internationalization/PolyglotTextData.h"
+
+class FGridlyLocalizationServiceProvider;
+class UGridlyDataTable;
+
+/**
+ * Times the stages of the Gridly pipeline on synthetic records of one size, without any network access or project data.
+ * Driven by the GridlyBenchmark commandlet and by the Gridly.Benchmark automation tests
+ */
+class FGridlyBenchmark
+{
+public:
+	/** Timings of one stage at one record count */
+	struct FStageResult
+	{
+		FString Stage;
+		int32 NumRecords = 0;
+		TArray<double> Seconds;
+
+		/** Allocations of the last run */
+		FGridlyAllocationCount Allocations;
+
+		double GetMedianSeconds() const;
+		double GetMinSeconds() const;
+		double GetAllocationsPerRecord() const;
+	};
+
+	explicit FGridlyBenchmark(const FGridlySyntheticDataShape& Shape);
+	~FGridlyBenchmark();
+
+	/**
+	 * Runs the stage once to warm up, then the given number of times.
+	 * Returns false with the reason in OutError when the stage could not run
+	 */
+	bool RunStage(const FString& Stage, int32 Iterations, FStageResult& OutResult, FString& OutError);
+
+	/** All stages, in the order of a sync */
+	static const TArray<FString>& GetStageNames();
+
+	static const TCHAR* const DefaultSizes;
+	static const int32 DefaultIterations = 5;
+
+private:
+	/** Setup runs untimed before every run */
+	FStageResult Measure(const FString& Stage, int32 Iterations, TFunctionRef<void()> Setup, TFunctionRef<void()> Run) const;
+
+	/** Fills the data table from the synthetic rows, for the stages that read it */
+	void ImportDataTable();
+
+private:
+	FGridlySyntheticData SyntheticData;
+	FString RecordsJson;
+	FString DataTableJson;
+	FString CSV;
+	TArray<FPolyglotTextData> PolyglotTextDatas;
+
+	/** Holds the .po files and the manifest and archives written by the stages */
+	FString WorkingDir;
+	bool bLocalizationWritten = false;
+
+	UGridlyDataTable* GridlyDataTable = nullptr;
+
+	/** Runs the record diff, so that it needs neither the active provider nor its settings */
+	TUniquePtr<FGridlyLocalizationServiceProvider> Provider;
+};
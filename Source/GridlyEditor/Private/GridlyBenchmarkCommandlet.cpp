@@ -0,0 +1,299 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyBenchmarkCommandlet.h"
+
+#include "GridlyProfiling.h"
+#include "GridlySyntheticData.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGridlyBenchmarkCommandlet, Log, All);
+
+namespace GridlyBenchmarkCommandlet
+{
+	/** Slowdown of the median or growth of the allocations against the baseline, in percent, above which a stage counts
+	 * as a regression */
+	static const double DefaultTolerance = 10.0;
+}
+
+int32 UGridlyBenchmarkCommandlet::Main(const FString& Params)
+{
+	LLM_SCOPE_BYTAG(Gridly);
+
+	FGridlyProfiling::EnableAllocationCounting();
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	FString SizesString = FGridlyBenchmark::DefaultSizes;
+	if (const FString* SizesParamVal = ParamVals.Find(FString(TEXT("Sizes"))))
+	{
+		SizesString = *SizesParamVal;
+	}
+
+	TArray<int32> Sizes;
+	TArray<FString> SizeStrings;
+	SizesString.ParseIntoArray(SizeStrings, TEXT(","));
+	for (const FString& SizeString : SizeStrings)
+	{
+		const int32 Size = FCString::Atoi(*SizeString);
+		if (Size > 0)
+		{
+			Sizes.Add(Size);
+		}
+	}
+
+	if (Sizes.Num() == 0)
+	{
+		UE_LOG(LogGridlyBenchmarkCommandlet, Error, TEXT("No valid record counts in -Sizes=%s"), *SizesString);
+		return -1;
+	}
+
+	int32 Iterations = FGridlyBenchmark::DefaultIterations;
+	if (const FString* IterationsParamVal = ParamVals.Find(FString(TEXT("Iterations"))))
+	{
+		Iterations = FMath::Max(1, FCString::Atoi(**IterationsParamVal));
+	}
+
+	// The record count of the shape is set per size below
+	FGridlySyntheticDataShape Shape;
+	Shape.ParseParams(ParamVals, Switches);
+
+	// Optional comma separated list of the stages to run, all stages run by default
+	TArray<FString> StageFilter;
+	if (const FString* StagesParamVal = ParamVals.Find(FString(TEXT("Stages"))))
+	{
+		StagesParamVal->ParseIntoArray(StageFilter, TEXT(","));
+	}
+
+	for (const FString& Stage : StageFilter)
+	{
+		if (!FGridlyBenchmark::GetStageNames().Contains(Stage))
+		{
+			UE_LOG(LogGridlyBenchmarkCommandlet, Error, TEXT("Unknown stage %s in -Stages, the stages are %s"), *Stage,
+				*FString::Join(FGridlyBenchmark::GetStageNames(), TEXT(",")));
+			return -1;
+		}
+	}
+
+	const auto ShouldRunStage = [&StageFilter](const FString& Stage)
+	{
+		return StageFilter.Num() == 0 || StageFilter.Contains(Stage);
+	};
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Gridly") / TEXT("Benchmark.json");
+	if (const FString* OutputParamVal = ParamVals.Find(FString(TEXT("Output"))))
+	{
+		OutputPath = *OutputParamVal;
+	}
+
+	TMap<FString, FBaselineResult> BaselineResults;
+	if (const FString* BaselineParamVal = ParamVals.Find(FString(TEXT("Baseline"))))
+	{
+		if (!ReadBaseline(*BaselineParamVal, BaselineResults))
+		{
+			UE_LOG(LogGridlyBenchmarkCommandlet, Error, TEXT("Failed to read baseline: %s"), **BaselineParamVal);
+			return -1;
+		}
+	}
+
+	double Tolerance = GridlyBenchmarkCommandlet::DefaultTolerance;
+	if (const FString* ToleranceParamVal = ParamVals.Find(FString(TEXT("Tolerance"))))
+	{
+		Tolerance = FCString::Atod(**ToleranceParamVal);
+	}
+
+	TArray<FGridlyBenchmark::FStageResult> Results;
+	int32 NumSkippedStages = 0;
+
+	for (const int32 NumRecords : Sizes)
+	{
+		UE_LOG(LogGridlyBenchmarkCommandlet, Display, TEXT("Generating %d synthetic records"), NumRecords);
+
+		Shape.NumRecords = NumRecords;
+		FGridlyBenchmark Benchmark(Shape);
+
+		for (const FString& Stage : FGridlyBenchmark::GetStageNames())
+		{
+			if (!ShouldRunStage(Stage))
+			{
+				continue;
+			}
+
+			UE_LOG(LogGridlyBenchmarkCommandlet, Display, TEXT("Running %s with %d records"), *Stage, NumRecords);
+
+			FGridlyBenchmark::FStageResult Result;
+			FString Error;
+			if (Benchmark.RunStage(Stage, Iterations, Result, Error))
+			{
+				Results.Add(MoveTemp(Result));
+			}
+			else
+			{
+				UE_LOG(LogGridlyBenchmarkCommandlet, Error, TEXT("Skipped %s with %d records: %s"), *Stage, NumRecords, *Error);
+				NumSkippedStages++;
+			}
+		}
+	}
+
+	// Report
+
+	int32 NumRegressions = 0;
+
+	UE_LOG(LogGridlyBenchmarkCommandlet, Display, TEXT("%-20s %10s %12s %12s %14s %12s %10s %10s"), TEXT("Stage"), TEXT("Records"),
+		TEXT("Median (ms)"), TEXT("Min (ms)"), TEXT("Records/s"), TEXT("Allocs/rec"), TEXT("Change"), TEXT("Allocs"));
+
+	for (const FGridlyBenchmark::FStageResult& Result : Results)
+	{
+		const double MedianSeconds = Result.GetMedianSeconds();
+		const double RecordsPerSecond = MedianSeconds > 0.0 ? Result.NumRecords / MedianSeconds : 0.0;
+		const double AllocationsPerRecord = Result.GetAllocationsPerRecord();
+
+		FString Change = TEXT("-");
+		FString AllocationsChange = TEXT("-");
+		if (const FBaselineResult* BaselineResult = BaselineResults.Find(GetResultKey(Result.Stage, Result.NumRecords)))
+		{
+			const double ChangePercent = BaselineResult->MedianSeconds > 0.0
+				? (MedianSeconds / BaselineResult->MedianSeconds - 1.0) * 100.0
+				: 0.0;
+			Change = FString::Printf(TEXT("%+.1f%%"), ChangePercent);
+
+			if (ChangePercent > Tolerance)
+			{
+				UE_LOG(LogGridlyBenchmarkCommandlet, Warning, TEXT("%s with %d records is %.1f%% slower than the baseline"),
+					*Result.Stage, Result.NumRecords, ChangePercent);
+				NumRegressions++;
+			}
+
+			// Baselines written before allocations were counted have none
+			if (BaselineResult->AllocationsPerRecord >= 0.0)
+			{
+				const double AllocationsChangePercent = BaselineResult->AllocationsPerRecord > 0.0
+					? (AllocationsPerRecord / BaselineResult->AllocationsPerRecord - 1.0) * 100.0
+					: 0.0;
+				AllocationsChange = FString::Printf(TEXT("%+.1f%%"), AllocationsChangePercent);
+
+				if (AllocationsChangePercent > Tolerance)
+				{
+					UE_LOG(LogGridlyBenchmarkCommandlet, Warning, TEXT("%s with %d records allocates %.1f%% more than the baseline"),
+						*Result.Stage, Result.NumRecords, AllocationsChangePercent);
+					NumRegressions++;
+				}
+			}
+		}
+
+		UE_LOG(LogGridlyBenchmarkCommandlet, Display, TEXT("%-20s %10d %12.2f %12.2f %14.0f %12.2f %10s %10s"), *Result.Stage,
+			Result.NumRecords, MedianSeconds * 1000.0, Result.GetMinSeconds() * 1000.0, RecordsPerSecond, AllocationsPerRecord,
+			*Change, *AllocationsChange);
+	}
+
+	if (!WriteResults(Results, BaselineResults, Shape.Seed, OutputPath))
+	{
+		UE_LOG(LogGridlyBenchmarkCommandlet, Error, TEXT("Failed to write benchmark results: %s"), *OutputPath);
+		return -1;
+	}
+
+	UE_LOG(LogGridlyBenchmarkCommandlet, Display, TEXT("Wrote benchmark results: %s"), *OutputPath);
+
+	if (NumSkippedStages > 0)
+	{
+		UE_LOG(LogGridlyBenchmarkCommandlet, Error, TEXT("%d stages were skipped"), NumSkippedStages);
+		return 1;
+	}
+
+	if (NumRegressions > 0)
+	{
+		UE_LOG(LogGridlyBenchmarkCommandlet, Error, TEXT("%d stages regressed by more than %.1f%%"), NumRegressions, Tolerance);
+		return 1;
+	}
+
+	return 0;
+}
+
+bool UGridlyBenchmarkCommandlet::WriteResults(const TArray<FGridlyBenchmark::FStageResult>& Results,
+	const TMap<FString, FBaselineResult>& BaselineResults, const int32 Seed, const FString& FilePath)
+{
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("date"), FDateTime::UtcNow().ToIso8601());
+	JsonObject->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	JsonObject->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	JsonObject->SetNumberField(TEXT("seed"), Seed);
+
+	TArray<TSharedPtr<FJsonValue>> ResultValues;
+	for (const FGridlyBenchmark::FStageResult& Result : Results)
+	{
+		const double MedianSeconds = Result.GetMedianSeconds();
+
+		const TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetStringField(TEXT("stage"), Result.Stage);
+		ResultObject->SetNumberField(TEXT("records"), Result.NumRecords);
+		ResultObject->SetNumberField(TEXT("iterations"), Result.Seconds.Num());
+		ResultObject->SetNumberField(TEXT("medianSeconds"), MedianSeconds);
+		ResultObject->SetNumberField(TEXT("minSeconds"), Result.GetMinSeconds());
+		ResultObject->SetNumberField(TEXT("recordsPerSecond"), MedianSeconds > 0.0 ? Result.NumRecords / MedianSeconds : 0.0);
+		ResultObject->SetNumberField(TEXT("allocationsPerRecord"), Result.GetAllocationsPerRecord());
+		ResultObject->SetNumberField(TEXT("bytesPerRecord"),
+			Result.NumRecords > 0 ? static_cast<double>(Result.Allocations.NumBytes) / Result.NumRecords : 0.0);
+
+		if (const FBaselineResult* BaselineResult = BaselineResults.Find(GetResultKey(Result.Stage, Result.NumRecords)))
+		{
+			ResultObject->SetNumberField(TEXT("baselineMedianSeconds"), BaselineResult->MedianSeconds);
+			if (BaselineResult->AllocationsPerRecord >= 0.0)
+			{
+				ResultObject->SetNumberField(TEXT("baselineAllocationsPerRecord"), BaselineResult->AllocationsPerRecord);
+			}
+		}
+
+		ResultValues.Add(MakeShared<FJsonValueObject>(ResultObject));
+	}
+	JsonObject->SetArrayField(TEXT("results"), ResultValues);
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	return FJsonSerializer::Serialize(JsonObject, JsonWriter) && FFileHelper::SaveStringToFile(JsonString, *FilePath);
+}
+
+bool UGridlyBenchmarkCommandlet::ReadBaseline(const FString& FilePath, TMap<FString, FBaselineResult>& OutBaselineResults)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+	const TArray<TSharedPtr<FJsonValue>>* ResultValues = nullptr;
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid()
+		|| !JsonObject->TryGetArrayField(TEXT("results"), ResultValues))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& ResultValue : *ResultValues)
+	{
+		const TSharedPtr<FJsonObject>* ResultObject = nullptr;
+		FString Stage;
+		int32 NumRecords = 0;
+		FBaselineResult BaselineResult;
+
+		if (ResultValue->TryGetObject(ResultObject) && (*ResultObject)->TryGetStringField(TEXT("stage"), Stage)
+			&& (*ResultObject)->TryGetNumberField(TEXT("records"), NumRecords)
+			&& (*ResultObject)->TryGetNumberField(TEXT("medianSeconds"), BaselineResult.MedianSeconds))
+		{
+			(*ResultObject)->TryGetNumberField(TEXT("allocationsPerRecord"), BaselineResult.AllocationsPerRecord);
+			OutBaselineResults.Add(GetResultKey(Stage, NumRecords), BaselineResult);
+		}
+	}
+
+	return true;
+}
+
+FString UGridlyBenchmarkCommandlet::GetResultKey(const FString& Stage, const int32 NumRecords)
+{
+	return FString::Printf(TEXT("%s/%d"), *Stage, NumRecords);
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GridlyBenchmark.h"
+
+#include "GridlyBenchmarkCommandlet.generated.h"
+
+/**
+ * Times every stage of the Gridly pipeline on synthetic records of fixed sizes, without any network access.
+ * Allocations of every stage are counted as well. Results are written to a JSON file, and compared with a baseline file
+ * to catch regressions. The same stages run as the Gridly.Benchmark automation tests:
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=GridlyBenchmark -Sizes=1000,10000 -Iterations=5 -Baseline=Base.json -Tolerance=10
+ */
+UCLASS()
+class UGridlyBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGridlyBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer)
+		: Super(ObjectInitializer)
+	{
+		IsClient = false;
+		IsEditor = true;
+		IsServer = false;
+		LogToConsole = true;
+	}
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** Median and allocations of one stage and size in an earlier result file */
+	struct FBaselineResult
+	{
+		double MedianSeconds = 0.0;
+		double AllocationsPerRecord = -1.0;
+	};
+
+	/** Writes the results, with the baseline of each stage and size that the baseline file has */
+	static bool WriteResults(const TArray<FGridlyBenchmark::FStageResult>& Results, const TMap<FString, FBaselineResult>& BaselineResults,
+		int32 Seed, const FString& FilePath);
+
+	/** Reads the median and allocations of each stage and size from an earlier result file */
+	static bool ReadBaseline(const FString& FilePath, TMap<FString, FBaselineResult>& OutBaselineResults);
+
+	static FString GetResultKey(const FString& Stage, int32 NumRecords);
+};
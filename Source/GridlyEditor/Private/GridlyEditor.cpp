@@ -5,6 +5,7 @@
 #include "GridlyCommands.h"
 #include "GridlyLocalizationServiceProvider.h"
 #include "GridlyStyle.h"
+#include "SGridlyRequestsPanel.h"
 #include "IAssetTools.h"
 #include "Json.h"
 #include "ToolMenus.h"
@@ -16,6 +17,9 @@
 #include "GridlyDataTable.h"
 #include "Modules/ModuleManager.h"
 #include "AssetToolsModule.h"
+#include "Framework/Docking/TabManager.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 
 
 
@@ -45,6 +49,15 @@ void FGridlyEditorModule::StartupModule()
 	IAssetTools& AssetTools = FModuleManager::GetModuleChecked<FAssetToolsModule>("AssetTools").Get();
 	AssetTools.RegisterAssetTypeActions(MakeShareable(new FAssetTypeActions_GridlyDataTable));
 
+	// Register debug panel
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(SGridlyRequestsPanel::TabName,
+			FOnSpawnTab::CreateStatic(&SGridlyRequestsPanel::SpawnTab))
+		.SetDisplayName(LOCTEXT("GridlyRequestsTabTitle", "Gridly Requests"))
+		.SetTooltipText(LOCTEXT("GridlyRequestsTabTooltip", "Latency of the requests to Gridly, per endpoint and per request"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsDebugCategory())
+		.SetIcon(FSlateIcon(FGridlyStyle::GetStyleSetName(), "Gridly.PluginAction"));
+
 
 
 
@@ -55,6 +68,7 @@ void FGridlyEditorModule::ShutdownModule()
 {
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SGridlyRequestsPanel::TabName);
 	FGridlyStyle::Shutdown();
 	FGridlyCommands::Unregister();
 
@@ -0,0 +1,162 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyExportPlan.h"
+
+#include "DataTableUtils.h"
+#include "GridlyProfiling.h"
+
+namespace GridlyExportPlan
+{
+	static TMap<const UScriptStruct*, TSharedRef<const FGridlyExportPlan>> CachedPlans;
+}
+
+TSharedRef<const FGridlyExportPlan> FGridlyExportPlan::Get(const UScriptStruct* RowStruct)
+{
+	check(IsInGameThread());
+
+	if (const TSharedRef<const FGridlyExportPlan>* CachedPlan = GridlyExportPlan::CachedPlans.Find(RowStruct))
+	{
+		// User defined structs are edited in place, so the plan is only reused while the properties are the same
+
+		if ((*CachedPlan)->Matches(RowStruct))
+		{
+			FGridlyProfiling::AddCacheLookups(1, 0);
+			return *CachedPlan;
+		}
+	}
+
+	FGridlyProfiling::AddCacheLookups(0, 1);
+	return GridlyExportPlan::CachedPlans.Add(RowStruct, MakeShareable(new FGridlyExportPlan(RowStruct)));
+}
+
+FGridlyExportPlan::FGridlyExportPlan(const UScriptStruct* RowStruct)
+{
+	for (TFieldIterator<const FProperty> It(RowStruct); It; ++It)
+	{
+		const FProperty* BaseProp = *It;
+		const int32 PropertyIndex = Properties.Add(BaseProp);
+
+		FGridlyExportColumn Column;
+		Column.Property = BaseProp;
+		Column.ColumnId = DataTableUtils::GetPropertyExportName(BaseProp, EDataTableExportFlags::None);
+		Column.Offset = BaseProp->GetOffset_ForInternal();
+		Column.PropertyIndex = PropertyIndex;
+
+		if (const FEnumProperty* EnumProp = CastField<const FEnumProperty>(BaseProp))
+		{
+			Column.ValueType = EGridlyExportValueType::Enum;
+			Column.NumericProperty = EnumProp->GetUnderlyingProperty();
+			Column.Enum = EnumProp->GetEnum();
+		}
+		else if (const FNumericProperty* NumProp = CastField<const FNumericProperty>(BaseProp))
+		{
+			Column.NumericProperty = NumProp;
+			Column.Enum = NumProp->GetIntPropertyEnum();
+
+			if (NumProp->IsEnum())
+			{
+				Column.ValueType = EGridlyExportValueType::Enum;
+			}
+			else if (NumProp->IsInteger())
+			{
+				Column.ValueType = EGridlyExportValueType::Integer;
+			}
+			else
+			{
+				Column.ValueType = EGridlyExportValueType::Float;
+			}
+		}
+		else if (CastField<const FBoolProperty>(BaseProp))
+		{
+			Column.ValueType = EGridlyExportValueType::Bool;
+		}
+		else if (CastField<const FStrProperty>(BaseProp))
+		{
+			Column.ValueType = EGridlyExportValueType::String;
+		}
+		else if (CastField<const FNameProperty>(BaseProp))
+		{
+			Column.ValueType = EGridlyExportValueType::Name;
+		}
+		else if (CastField<const FTextProperty>(BaseProp))
+		{
+			Column.ValueType = EGridlyExportValueType::Text;
+		}
+		else if (CastField<const FArrayProperty>(BaseProp))
+		{
+			Column.ValueType = EGridlyExportValueType::Array;
+		}
+		else if (CastField<const FSetProperty>(BaseProp))
+		{
+			Column.ValueType = EGridlyExportValueType::Set;
+		}
+
+		if (BaseProp->ArrayDim != 1)
+		{
+			Column.ValueType = EGridlyExportValueType::Other;
+		}
+
+		AllColumns.Add(Column);
+
+		// The _path property maps to the record path rather than to a cell, static arrays are not exported
+
+		if (Column.ColumnId == TEXT("_path"))
+		{
+			PathColumn = MoveTemp(Column);
+		}
+		else if (BaseProp->ArrayDim == 1)
+		{
+			Columns.Add(MoveTemp(Column));
+		}
+	}
+}
+
+bool FGridlyExportPlan::Matches(const UScriptStruct* RowStruct) const
+{
+	int32 PropertyIndex = 0;
+	for (TFieldIterator<const FProperty> It(RowStruct); It; ++It, ++PropertyIndex)
+	{
+		if (!Properties.IsValidIndex(PropertyIndex) || Properties[PropertyIndex] != *It)
+		{
+			return false;
+		}
+	}
+
+	return PropertyIndex == Properties.Num();
+}
+
+FString FGridlyExportPlan::GetValueAsString(const FGridlyExportColumn& Column, const uint8* RowData)
+{
+	const void* Value = Column.GetValuePtr(RowData);
+
+	switch (Column.ValueType)
+	{
+		case EGridlyExportValueType::String:
+			return *static_cast<const FString*>(Value);
+		case EGridlyExportValueType::Name:
+			return static_cast<const FName*>(Value)->ToString();
+		case EGridlyExportValueType::Text:
+		{
+			FString TextString;
+			FTextStringHelper::WriteToBuffer(TextString, *static_cast<const FText*>(Value));
+			return TextString;
+		}
+		case EGridlyExportValueType::Enum:
+		{
+			const int64 EnumValue = Column.NumericProperty->GetSignedIntPropertyValue(Value);
+			if (Column.Enum && Column.Enum->IsValidEnumValue(EnumValue) && EnumValue != Column.Enum->GetMaxEnumValue())
+			{
+				return Column.Enum->GetAuthoredNameStringByValue(EnumValue);
+			}
+			break;
+		}
+		case EGridlyExportValueType::Integer:
+			return LexToString(Column.NumericProperty->GetSignedIntPropertyValue(Value));
+		case EGridlyExportValueType::Bool:
+			return CastFieldChecked<const FBoolProperty>(Column.Property)->GetPropertyValue(Value) ? TEXT("True") : TEXT("False");
+		default:
+			break;
+	}
+
+	return DataTableUtils::GetPropertyValueAsString(Column.Property, RowData, EDataTableExportFlags::None);
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonWriter.h"
+
+enum class EGridlyExportValueType : uint8
+{
+	String,
+	Name,
+	Text,
+	Integer,
+	Float,
+	Enum,
+	Bool,
+	Array,
+	Set,
+	Other
+};
+
+/**
+ * A row struct property resolved for export, with its column ID and the writer to use for its value
+ */
+struct FGridlyExportColumn
+{
+	const FProperty* Property = nullptr;
+	FString ColumnId;
+	int32 Offset = 0;
+
+	/** Index of the property in field iteration order, including properties that are not exported as cells */
+	int32 PropertyIndex = INDEX_NONE;
+
+	EGridlyExportValueType ValueType = EGridlyExportValueType::Other;
+	const FNumericProperty* NumericProperty = nullptr;
+	const UEnum* Enum = nullptr;
+
+	const void* GetValuePtr(const uint8* RowData) const { return RowData + Offset; }
+};
+
+/**
+ * Export columns of a row struct, resolved once and cached per struct so that exporting rows needs no reflection lookups
+ */
+class FGridlyExportPlan
+{
+public:
+	/** Returns the cached plan for the struct, rebuilding it if the struct's properties have changed since */
+	static TSharedRef<const FGridlyExportPlan> Get(const UScriptStruct* RowStruct);
+
+	/** Columns that are exported as cells, which excludes the _path property and static arrays */
+	const TArray<FGridlyExportColumn>& GetColumns() const { return Columns; }
+
+	/** Every property of the struct, for file exports */
+	const TArray<FGridlyExportColumn>& GetAllColumns() const { return AllColumns; }
+
+	const FGridlyExportColumn* GetPathColumn() const { return PathColumn.IsSet() ? &PathColumn.GetValue() : nullptr; }
+
+	/** Returns the value as the same string DataTableUtils::GetPropertyValueAsString would export */
+	static FString GetValueAsString(const FGridlyExportColumn& Column, const uint8* RowData);
+
+	/** Writes the value as a field of the current object. Returns false for containers, which the caller has to write itself */
+	template <class PrintPolicy>
+	static bool WriteValue(TJsonWriter<TCHAR, PrintPolicy>& JsonWriter, const TCHAR* Identifier, const FGridlyExportColumn& Column,
+		const uint8* RowData)
+	{
+		const void* Value = Column.GetValuePtr(RowData);
+
+		switch (Column.ValueType)
+		{
+			case EGridlyExportValueType::String:
+				JsonWriter.WriteValue(Identifier, *static_cast<const FString*>(Value));
+				return true;
+			case EGridlyExportValueType::Integer:
+				JsonWriter.WriteValue(Identifier, Column.NumericProperty->GetSignedIntPropertyValue(Value));
+				return true;
+			case EGridlyExportValueType::Float:
+				JsonWriter.WriteValue(Identifier, Column.NumericProperty->GetFloatingPointPropertyValue(Value));
+				return true;
+			case EGridlyExportValueType::Bool:
+				JsonWriter.WriteValue(Identifier, CastFieldChecked<const FBoolProperty>(Column.Property)->GetPropertyValue(Value));
+				return true;
+			case EGridlyExportValueType::Array:
+			case EGridlyExportValueType::Set:
+				return false;
+			default:
+				JsonWriter.WriteValue(Identifier, GetValueAsString(Column, RowData));
+				return true;
+		}
+	}
+
+private:
+	explicit FGridlyExportPlan(const UScriptStruct* RowStruct);
+
+	bool Matches(const UScriptStruct* RowStruct) const;
+
+	TArray<const FProperty*> Properties;
+	TArray<FGridlyExportColumn> Columns;
+	TArray<FGridlyExportColumn> AllColumns;
+	TOptional<FGridlyExportColumn> PathColumn;
+};
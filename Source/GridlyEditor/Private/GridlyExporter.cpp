@@ -2,19 +2,80 @@
 
 #include "GridlyCultureConverter.h"
 #include "GridlyDataTableImporterJSON.h"
+#include "GridlyExportPlan.h"
 #include "GridlyGameSettings.h"
+#include "GridlyProfiling.h"
+#include "DataTableJSON.h"
+#include "JsonObjectConverter.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
 #include "Internationalization/PolyglotTextData.h"
 #include "LocTextHelper.h"
-#if HS_GRIDLY_ALLOW_ARBITARY_STRUCT_IN_TABLE
-#include "JsonObjectConverter.h"
-#endif
+#include "Policies/PrettyJsonPrintPolicy.h"
+
+namespace GridlyExporter
+{
+	/** Converts to UTF-8 and writes to a file in large blocks, so that file exports never hold more than a block in memory */
+	class FUtf8FileStream
+	{
+	public:
+		explicit FUtf8FileStream(const FString& FilePath) :
+			FileWriter(IFileManager::Get().CreateFileWriter(*FilePath))
+		{
+			Buffer.Reserve(BlockSize);
+		}
+
+		bool IsValid() const { return FileWriter.IsValid(); }
+
+		void WriteBytes(const void* Data, const int32 Num)
+		{
+			Buffer.Append(static_cast<const uint8*>(Data), Num);
+			if (Buffer.Num() >= BlockSize)
+			{
+				Flush();
+			}
+		}
 
+		void Write(const FString& String)
+		{
+			const FTCHARToUTF8 Utf8String(*String, String.Len());
+			WriteBytes(Utf8String.Get(), Utf8String.Length());
+		}
+
+		void Write(const TCHAR* String)
+		{
+			const FTCHARToUTF8 Utf8String(String);
+			WriteBytes(Utf8String.Get(), Utf8String.Length());
+		}
+
+		bool Close()
+		{
+			Flush();
+			return !FileWriter->IsError() && FileWriter->Close();
+		}
+
+	private:
+		void Flush()
+		{
+			FileWriter->Serialize(Buffer.GetData(), Buffer.Num());
+			Buffer.Reset();
+		}
+
+		static constexpr int32 BlockSize = 1024 * 1024;
+
+		TUniquePtr<FArchive> FileWriter;
+		TArray<uint8> Buffer;
+	};
+}
 
-bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTextDatas,
+bool FGridlyExporter::ConvertToJson(TConstArrayView<FPolyglotTextData> PolyglotTextDatas,
 	bool bIncludeTargetTranslations, const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, FString& OutJsonString)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::ConvertToJson");
+	SCOPE_CYCLE_COUNTER(STAT_GridlySerializeExports);
+	GRIDLY_ALLOCATION_SCOPE(SerializeExports);
+
 	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
 	const TArray<FString> TargetCultures = FGridlyCultureConverter::GetTargetCultures();
 
@@ -22,15 +83,43 @@ bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTex
 	const bool bExportNamespace = !bUseCombinedNamespaceKey || GameSettings->bAlsoExportNamespaceColumn;
 	const bool bUsePathAsNamespace = GameSettings->NamespaceColumnId == "path";
 
-	TArray<TSharedPtr<FJsonValue>> Rows;
+	// Language column IDs are resolved once per culture rather than once per text
+
+	TArray<TPair<FString, FString>> TargetColumnIds;
+	if (bIncludeTargetTranslations)
+	{
+		for (const FString& CultureName : TargetCultures)
+		{
+			FString GridlyCulture;
+			if (FGridlyCultureConverter::ConvertToGridly(CultureName, GridlyCulture))
+			{
+				TargetColumnIds.Emplace(CultureName, GameSettings->TargetLanguageColumnIdPrefix + GridlyCulture);
+			}
+		}
+	}
+
+	TMap<FString, FString> SourceColumnIds;
+
+	// Rows are written as they are converted, without building a JSON object for every row and cell first.
+	// Request payloads are condensed, indentation would only add bytes to every request
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJsonString);
 
-	for (int i = 0; i < PolyglotTextDatas.Num(); i++)
+	const auto WriteCell = [&JsonWriter](const FString& ColumnId, const FString& Value)
 	{
-		TSharedPtr<FJsonObject> RowJsonObject = MakeShareable(new FJsonObject);
-		TArray<TSharedPtr<FJsonValue>> CellsJsonArray;
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("columnId"), ColumnId);
+		JsonWriter->WriteValue(TEXT("value"), Value);
+		JsonWriter->WriteObjectEnd();
+	};
 
-		const FString& Key = PolyglotTextDatas[i].GetKey();
-		const FString& Namespace = PolyglotTextDatas[i].GetNamespace();
+	JsonWriter->WriteArrayStart();
+
+	FString LocalizedString;
+	for (const FPolyglotTextData& PolyglotTextData : PolyglotTextDatas)
+	{
+		const FString& Key = PolyglotTextData.GetKey();
+		const FString& Namespace = PolyglotTextData.GetNamespace();
 
 		const FManifestContext* ItemContext = nullptr;
 		if (LocTextHelperPtr.IsValid())
@@ -39,158 +128,146 @@ bool FGridlyExporter::ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTex
 			ItemContext = ManifestEntry ? ManifestEntry->FindContextByKey(Key) : nullptr;
 		}
 
+		JsonWriter->WriteObjectStart();
+
 		// Set record id
 
 		if (bUseCombinedNamespaceKey)
 		{
-			// Use Contains method to check for the substring "blueprints/"
-			if (Namespace.Contains(TEXT("blueprints/"))) {
-				RowJsonObject->SetStringField("id", FString::Printf(TEXT("%s,%s"), TEXT(""), *Key));
-			}
-			else {
-				RowJsonObject->SetStringField("id", FString::Printf(TEXT("%s,%s"), *Namespace, *Key));
-			}
+			// Blueprint texts are exported without their namespace
+			const bool bIsBlueprintNamespace = Namespace.Contains(TEXT("blueprints/"));
+			JsonWriter->WriteValue(TEXT("id"), (bIsBlueprintNamespace ? FString() : Namespace) + TEXT(",") + Key);
 		}
-
 		else
 		{
-			RowJsonObject->SetStringField("id", Key);
+			JsonWriter->WriteValue(TEXT("id"), Key);
 		}
 
 		// Set namespace/path
 
-		if (bExportNamespace)
+		if (bExportNamespace && bUsePathAsNamespace)
 		{
-			if (bUsePathAsNamespace)
-			{
-				RowJsonObject->SetStringField("path", Namespace);
-			}
-			else if (!GameSettings->NamespaceColumnId.IsEmpty())
-			{
-				TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-				CellJsonObject->SetStringField("columnId", GameSettings->NamespaceColumnId);
-				CellJsonObject->SetStringField("value", Namespace);
-				CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
-			}
+			JsonWriter->WriteValue(TEXT("path"), Namespace);
+		}
+
+		JsonWriter->WriteArrayStart(TEXT("cells"));
+
+		if (bExportNamespace && !bUsePathAsNamespace && !GameSettings->NamespaceColumnId.IsEmpty())
+		{
+			WriteCell(GameSettings->NamespaceColumnId, Namespace);
 		}
 
 		// Set source language text
 
 		{
-			const FString NativeCulture = PolyglotTextDatas[i].GetNativeCulture();
-			const FString NativeString = PolyglotTextDatas[i].GetNativeString();
+			const FString& NativeCulture = PolyglotTextData.GetNativeCulture();
 
-			FString GridlyCulture;
-			if (FGridlyCultureConverter::ConvertToGridly(NativeCulture, GridlyCulture))
+			const FString* SourceColumnId = SourceColumnIds.Find(NativeCulture);
+			if (!SourceColumnId)
 			{
-				TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-				CellJsonObject->SetStringField("columnId", GameSettings->SourceLanguageColumnIdPrefix + GridlyCulture);
-				CellJsonObject->SetStringField("value", NativeString);
-				CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
+				FString GridlyCulture;
+				SourceColumnId = &SourceColumnIds.Add(NativeCulture,
+					FGridlyCultureConverter::ConvertToGridly(NativeCulture, GridlyCulture)
+						? GameSettings->SourceLanguageColumnIdPrefix + GridlyCulture
+						: FString());
+			}
+
+			if (!SourceColumnId->IsEmpty())
+			{
+				WriteCell(*SourceColumnId, PolyglotTextData.GetNativeString());
 			}
 
 			// Add context
 
 			if (ItemContext && GameSettings->bExportContext)
-			{				
-				TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-				CellJsonObject->SetStringField("columnId", *GameSettings->ContextColumnId);
-				CellJsonObject->SetStringField("value",
+			{
+				WriteCell(GameSettings->ContextColumnId,
 					ItemContext->SourceLocation.Replace(TEXT(" - line "), TEXT(":"), ESearchCase::CaseSensitive));
-				CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
 			}
 
 			// Add metadata
 
- 			if (ItemContext && GameSettings->bExportMetadata && ItemContext->InfoMetadataObj.IsValid())
+			if (ItemContext && GameSettings->bExportMetadata && ItemContext->InfoMetadataObj.IsValid())
 			{
 				for (const auto& InfoMetaDataPair : ItemContext->InfoMetadataObj->Values)
 				{
-					const FString& KeyName = InfoMetaDataPair.Key;
 					if (const FGridlyColumnInfo* GridlyColumnInfo = GameSettings->MetadataMapping.Find(InfoMetaDataPair.Key))
 					{
-						TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-						CellJsonObject->SetStringField("columnId", *GridlyColumnInfo->Name);
-
 						const TSharedPtr<FLocMetadataValue> Value = InfoMetaDataPair.Value;
 
+						JsonWriter->WriteObjectStart();
+						JsonWriter->WriteValue(TEXT("columnId"), GridlyColumnInfo->Name);
+
 						switch (GridlyColumnInfo->DataType)
 						{
 							case EGridlyColumnDataType::String:
 							{
-								CellJsonObject->SetStringField("value", Value->ToString());
+								JsonWriter->WriteValue(TEXT("value"), Value->ToString());
 							}
 							break;
 							case EGridlyColumnDataType::Number:
 							{
-								CellJsonObject->SetNumberField("value", FCString::Atoi(*Value->ToString()));
+								JsonWriter->WriteValue(TEXT("value"), FCString::Atoi(*Value->ToString()));
 							}
 							break;
 							default:
 								break;
 						}
 
-						CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
+						JsonWriter->WriteObjectEnd();
 					}
 				}
 			}
 
-			if (bIncludeTargetTranslations)
+			for (const TPair<FString, FString>& TargetColumnId : TargetColumnIds)
 			{
-				for (int j = 0; j < TargetCultures.Num(); j++)
+				if (TargetColumnId.Key != NativeCulture && PolyglotTextData.GetLocalizedString(TargetColumnId.Key, LocalizedString))
 				{
-					const FString CultureName = TargetCultures[j];
-					FString LocalizedString;
-
-					if (CultureName != NativeCulture
-					    && PolyglotTextDatas[i].GetLocalizedString(CultureName, LocalizedString)
-					    && FGridlyCultureConverter::ConvertToGridly(CultureName, GridlyCulture))
-					{
-						TSharedPtr<FJsonObject> CellJsonObject = MakeShareable(new FJsonObject);
-						CellJsonObject->SetStringField("columnId", GameSettings->TargetLanguageColumnIdPrefix + GridlyCulture);
-						CellJsonObject->SetStringField("value", LocalizedString);
-						CellsJsonArray.Add(MakeShareable(new FJsonValueObject(CellJsonObject)));
-					}
+					WriteCell(TargetColumnId.Value, LocalizedString);
 				}
 			}
 		}
 
-		// Assign array
-
-		RowJsonObject->SetArrayField("cells", CellsJsonArray);
-
-		Rows.Add(MakeShareable(new FJsonValueObject(RowJsonObject)));
+		JsonWriter->WriteArrayEnd();
+		JsonWriter->WriteObjectEnd();
 	}
 
-	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonStringWriter<>::Create(&OutJsonString);
-	if (FJsonSerializer::Serialize(Rows, JsonWriter))
-	{
-		return true;
-	}
+	JsonWriter->WriteArrayEnd();
 
-	return false;
+	return JsonWriter->Close();
 }
 
 bool FGridlyExporter::ConvertToJson(const UGridlyDataTable* GridlyDataTable, FString& OutJsonString, size_t StartIndex,
-	size_t MaxSize)
+	size_t MaxSize, const TMap<FName, TBitArray<>>* DirtyCells)
 {
-	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
-	const TArray<FString> TargetCultures = FGridlyCultureConverter::GetTargetCultures();
+	GRIDLY_TRACE_SCOPE("Gridly::ConvertDataTableToJson");
+	SCOPE_CYCLE_COUNTER(STAT_GridlySerializeExports);
+	GRIDLY_ALLOCATION_SCOPE(SerializeExports);
 
 	if (!GridlyDataTable->RowStruct)
 	{
 		return false;
 	}
 
-	FString KeyField = GridlyDataTableJSONUtils::GetKeyFieldName(*GridlyDataTable);
+	// Column names, offsets and value writers are resolved once per row struct
+
+	const TSharedRef<const FGridlyExportPlan> ExportPlan = FGridlyExportPlan::Get(GridlyDataTable->RowStruct);
+	const FGridlyExportColumn* PathColumn = ExportPlan->GetPathColumn();
 
-	auto JsonWriter = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutJsonString);
+	auto JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJsonString);
 
 	JsonWriter->WriteArrayStart();
 
 	TArray<FName> Keys;
 	const TMap<FName, uint8*>& RowMap = GridlyDataTable->GetRowMap();
-	RowMap.GenerateKeyArray(Keys);
+	if (DirtyCells)
+	{
+		DirtyCells->GenerateKeyArray(Keys);
+	}
+	else
+	{
+		RowMap.GenerateKeyArray(Keys);
+	}
 
 	if (StartIndex < Keys.Num())
 	{
@@ -198,225 +275,276 @@ bool FGridlyExporter::ConvertToJson(const UGridlyDataTable* GridlyDataTable, FSt
 		for (size_t i = StartIndex; i < EndIndex; i++)
 		{
 			const FName RowName = Keys[i];
-			uint8* RowData = RowMap[RowName];
+			const uint8* RowData = RowMap[RowName];
+			const TBitArray<>* DirtyRowCells = DirtyCells ? DirtyCells->Find(RowName) : nullptr;
 
 			JsonWriter->WriteObjectStart();
 			{
 				// RowName
 				JsonWriter->WriteValue("id", RowName.ToString());
 
-				// Now handle the _path field
-				FString PathValue;
-				bool bPathFound = false;
-
 				// Now the values
 				JsonWriter->WriteArrayStart("cells");
 
-				for (TFieldIterator<const FProperty> It(GridlyDataTable->GetRowStruct()); It; ++It)
+				for (const FGridlyExportColumn& Column : ExportPlan->GetColumns())
 				{
-					const FProperty* BaseProp = *It;
-					check(BaseProp);
-
-					const EDataTableExportFlags DTExportFlags = EDataTableExportFlags::None;
+					// Unchanged cells are left out when only exporting changes
+					if (DirtyRowCells && DirtyRowCells->IsValidIndex(Column.PropertyIndex) && !(*DirtyRowCells)[Column.PropertyIndex])
+					{
+						continue;
+					}
 
-					const FString Identifier = DataTableUtils::GetPropertyExportName(BaseProp, DTExportFlags);
-					const void* Data = BaseProp->ContainerPtrToValuePtr<void>(RowData, 0);
+					JsonWriter->WriteObjectStart();
+					JsonWriter->WriteValue("columnId", Column.ColumnId);
 
-					// Check if the property is _path and handle it separately
-					if (Identifier == "_path")
+					if (!FGridlyExportPlan::WriteValue(*JsonWriter, TEXT("value"), Column, RowData))
 					{
-						PathValue = DataTableUtils::GetPropertyValueAsString(BaseProp, static_cast<uint8*>(RowData), DTExportFlags);
-						bPathFound = true;
-						continue;  // Skip adding _path to the cells array
+						WriteContainerValue(*JsonWriter, Column, RowData);
 					}
 
-					if (BaseProp->ArrayDim == 1)
-					{
-						JsonWriter->WriteObjectStart();
+					JsonWriter->WriteObjectEnd();
+				}
 
-						const FString ExportId = DataTableUtils::GetPropertyExportName(BaseProp, DTExportFlags);
-						JsonWriter->WriteValue("columnId", ExportId);
+				JsonWriter->WriteArrayEnd();
+
+				// The _path property is exported as the record path
+				JsonWriter->WriteValue("path", PathColumn ? FGridlyExportPlan::GetValueAsString(*PathColumn, RowData) : FString());
+			}
+			JsonWriter->WriteObjectEnd();
+		}
+
+		JsonWriter->WriteArrayEnd();
+
+		if (JsonWriter->Close())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FGridlyExporter::WriteContainerValue(TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& JsonWriter,
+	const FGridlyExportColumn& Column, const uint8* RowData)
+{
+	const void* Data = Column.GetValuePtr(RowData);
+	const EDataTableExportFlags DTExportFlags = EDataTableExportFlags::None;
 
-						if (const FEnumProperty* EnumProp = CastField<const FEnumProperty>(BaseProp))
-						{
-							const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(EnumProp,
-								static_cast<uint8*>(RowData), DTExportFlags);
-							JsonWriter->WriteValue("value", PropertyValue);
-						}
-						else if (const FNumericProperty* NumProp = CastField<const FNumericProperty>(BaseProp))
-						{
-							if (NumProp->IsEnum())
-							{
-								const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(BaseProp,
-									static_cast<uint8*>(RowData), DTExportFlags);
-								JsonWriter->WriteValue("value", PropertyValue);
-							}
-							else if (NumProp->IsInteger())
-							{
-								const int64 PropertyValue = NumProp->GetSignedIntPropertyValue(Data);
-								JsonWriter->WriteValue("value", PropertyValue);
-							}
-							else
-							{
-								const double PropertyValue = NumProp->GetFloatingPointPropertyValue(Data);
-								JsonWriter->WriteValue("value", PropertyValue);
-							}
-						}
-						else if (const FBoolProperty* BoolProp = CastField<const FBoolProperty>(BaseProp))
-						{
-							const bool PropertyValue = BoolProp->GetPropertyValue(Data);
-							JsonWriter->WriteValue("value", PropertyValue);
-						}
 // This code will allow you to have arbitary stucts within an array
 #if HS_GRIDLY_ALLOW_ARBITARY_STRUCT_IN_TABLE
-						else if (const FArrayProperty* ArrayProp = CastField<const FArrayProperty>(BaseProp))
-						{
-							FString arrayJson;
-							auto SubJsonWriter = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&arrayJson);
-							SubJsonWriter->WriteArrayStart();
+	if (const FArrayProperty* ArrayProp = CastField<const FArrayProperty>(Column.Property))
+	{
+		FString arrayJson;
+		auto SubJsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&arrayJson);
+		SubJsonWriter->WriteArrayStart();
 
-							FScriptArrayHelper ArrayHelper(ArrayProp, Data);
-							for (int32 ArrayIndex = 0; ArrayIndex < ArrayHelper.Num(); ++ArrayIndex)
-							{
-								void* ArrayData = ArrayHelper.GetRawPtr(ArrayIndex);
-
-								if (const FEnumProperty* innerEnumProp = CastField<const FEnumProperty>(ArrayProp->Inner))
-								{
-									// TODO
-									checkNoEntry();
-								}
-								else if (const FNumericProperty* innerNumProp = CastField<const FNumericProperty>(ArrayProp->Inner))
-								{
-									// TODO
-									checkNoEntry();
-								}
-								else if (const FBoolProperty* innerBoolProp = CastField<const FBoolProperty>(ArrayProp->Inner))
-								{
-									// TODO
-									checkNoEntry();
-								}
-								else if (const FStructProperty* innerStructProp = CastField<const FStructProperty>(ArrayProp->Inner))
-								{					
-									FString objAsJson;
-									FJsonObjectConverter::UStructToFormattedJsonObjectString<TCHAR, TPrettyJsonPrintPolicy>(innerStructProp->Struct, ArrayData, objAsJson);
-									SubJsonWriter->WriteRawJSONValue(objAsJson);
-								}
-								else
-								{
-									// TODO
-									checkNoEntry();
-								}
-							}
-							
-							SubJsonWriter->WriteArrayEnd();
-							if (SubJsonWriter->Close())
-							{
-								JsonWriter->WriteValue("value", arrayJson);
-							}
-						}
+		FScriptArrayHelper ArrayHelper(ArrayProp, Data);
+		for (int32 ArrayIndex = 0; ArrayIndex < ArrayHelper.Num(); ++ArrayIndex)
+		{
+			void* ArrayData = ArrayHelper.GetRawPtr(ArrayIndex);
+
+			if (const FEnumProperty* innerEnumProp = CastField<const FEnumProperty>(ArrayProp->Inner))
+			{
+				// TODO
+				checkNoEntry();
+			}
+			else if (const FNumericProperty* innerNumProp = CastField<const FNumericProperty>(ArrayProp->Inner))
+			{
+				// TODO
+				checkNoEntry();
+			}
+			else if (const FBoolProperty* innerBoolProp = CastField<const FBoolProperty>(ArrayProp->Inner))
+			{
+				// TODO
+				checkNoEntry();
+			}
+			else if (const FStructProperty* innerStructProp = CastField<const FStructProperty>(ArrayProp->Inner))
+			{					
+				FString objAsJson;
+				FJsonObjectConverter::UStructToFormattedJsonObjectString<TCHAR, TCondensedJsonPrintPolicy>(innerStructProp->Struct, ArrayData, objAsJson);
+				SubJsonWriter->WriteRawJSONValue(objAsJson);
+			}
+			else
+			{
+				// TODO
+				checkNoEntry();
+			}
+		}
+		
+		SubJsonWriter->WriteArrayEnd();
+		if (SubJsonWriter->Close())
+		{
+			JsonWriter.WriteValue("value", arrayJson);
+		}
+		return;
+	}
 #endif //HS_GRIDLY_ALLOW_ARBITARY_STRUCT_IN_TABLE
 // This code will allow you to read multioptions from Gridly into a Set Property						
 #if HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
-						else if (const FSetProperty* SetProp = CastField<const FSetProperty>(BaseProp))
-						{
-							FString setJson;
-							auto SubJsonWriter = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&setJson);
-							SubJsonWriter->WriteArrayStart();
-
-							FScriptSetHelper SetHelper(SetProp, Data);
-							
-							for (FScriptSetHelper::FIterator SetIter = SetHelper.CreateIterator(); SetIter; ++SetIter)
-							{
-								uint8* SetData = SetHelper.GetElementPtr(SetIter);
-
-								if (const FEnumProperty* innerEnumProp = CastField<const FEnumProperty>(SetProp->ElementProp))
-								{
-									// TODO
-									checkNoEntry();	
-								}
-								else if (const FNumericProperty* innerNumProp = CastField<const FNumericProperty>(SetProp->ElementProp))
-								{
-									if (innerNumProp->IsEnum())
-									{
-										const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(innerNumProp, SetData, DTExportFlags);
-										SubJsonWriter->WriteValue(PropertyValue);
-									}
-									else if (innerNumProp->IsInteger())
-									{
-										const int64 PropertyValue = innerNumProp->GetSignedIntPropertyValue(SetData);
-										SubJsonWriter->WriteValue(PropertyValue);
-									}
-									else
-									{
-										const double PropertyValue = innerNumProp->GetFloatingPointPropertyValue(SetData);
-										SubJsonWriter->WriteValue(PropertyValue);
-									}
-								}
-								else if (const FBoolProperty* innerBoolProp = CastField<const FBoolProperty>(SetProp->ElementProp))
-								{
-									// TODO
-									checkNoEntry();
-								}
-								else if (const FStructProperty* innerStructProp = CastField<const FStructProperty>(SetProp->ElementProp))
-								{
-									// Untested, but should work.  If you hit this, try uncommenting out the checkNoEntry and checking the result is as you'd expect
-									checkNoEntry(); 
-									FString objAsJson;
-									FJsonObjectConverter::UStructToFormattedJsonObjectString<TCHAR, TPrettyJsonPrintPolicy>(innerStructProp->Struct, SetData, objAsJson);
-									SubJsonWriter->WriteRawJSONValue(objAsJson);
-								}
-								else
-								{
-									// Untested, but should work.  If you hit this, try uncommenting out the checkNoEntry and checking the result is as you'd expect
-									checkNoEntry();
-									const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(innerStructProp, SetData, DTExportFlags);
-									SubJsonWriter->WriteValue(PropertyValue);
-								}
-							}
+	if (const FSetProperty* SetProp = CastField<const FSetProperty>(Column.Property))
+	{
+		FString setJson;
+		auto SubJsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&setJson);
+		SubJsonWriter->WriteArrayStart();
 
-							SubJsonWriter->WriteArrayEnd();
-							if (SubJsonWriter->Close())
-							{
-								JsonWriter->WriteRawJSONValue(TEXT("value"), setJson);
-							}
-						}
-#endif //HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
-						else
-						{
-							const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(BaseProp,
-								static_cast<uint8*>(RowData), DTExportFlags);
-							JsonWriter->WriteValue("value", PropertyValue);
-						}
+		FScriptSetHelper SetHelper(SetProp, Data);
+		
+		for (FScriptSetHelper::FIterator SetIter = SetHelper.CreateIterator(); SetIter; ++SetIter)
+		{
+			uint8* SetData = SetHelper.GetElementPtr(SetIter);
 
-						JsonWriter->WriteObjectEnd();
-					}
+			if (const FEnumProperty* innerEnumProp = CastField<const FEnumProperty>(SetProp->ElementProp))
+			{
+				// TODO
+				checkNoEntry();	
+			}
+			else if (const FNumericProperty* innerNumProp = CastField<const FNumericProperty>(SetProp->ElementProp))
+			{
+				if (innerNumProp->IsEnum())
+				{
+					const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(innerNumProp, SetData, DTExportFlags);
+					SubJsonWriter->WriteValue(PropertyValue);
 				}
-
-				JsonWriter->WriteArrayEnd();
-				
-				// Now add the path if it was found
-				if (bPathFound)
+				else if (innerNumProp->IsInteger())
 				{
-					JsonWriter->WriteValue("path", *PathValue);  // Explicitly convert FString to TCHAR*
+					const int64 PropertyValue = innerNumProp->GetSignedIntPropertyValue(SetData);
+					SubJsonWriter->WriteValue(PropertyValue);
 				}
 				else
 				{
-					JsonWriter->WriteValue("path", TEXT(""));  // Correctly pass an empty TCHAR* string
+					const double PropertyValue = innerNumProp->GetFloatingPointPropertyValue(SetData);
+					SubJsonWriter->WriteValue(PropertyValue);
 				}
-
-				
 			}
-			JsonWriter->WriteObjectEnd();
+			else if (const FBoolProperty* innerBoolProp = CastField<const FBoolProperty>(SetProp->ElementProp))
+			{
+				// TODO
+				checkNoEntry();
+			}
+			else if (const FStructProperty* innerStructProp = CastField<const FStructProperty>(SetProp->ElementProp))
+			{
+				// Untested, but should work.  If you hit this, try uncommenting out the checkNoEntry and checking the result is as you'd expect
+				checkNoEntry(); 
+				FString objAsJson;
+				FJsonObjectConverter::UStructToFormattedJsonObjectString<TCHAR, TCondensedJsonPrintPolicy>(innerStructProp->Struct, SetData, objAsJson);
+				SubJsonWriter->WriteRawJSONValue(objAsJson);
+			}
+			else
+			{
+				// Untested, but should work.  If you hit this, try uncommenting out the checkNoEntry and checking the result is as you'd expect
+				checkNoEntry();
+				const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(innerStructProp, SetData, DTExportFlags);
+				SubJsonWriter->WriteValue(PropertyValue);
+			}
 		}
 
-		JsonWriter->WriteArrayEnd();
+		SubJsonWriter->WriteArrayEnd();
+		if (SubJsonWriter->Close())
+		{
+			JsonWriter.WriteRawJSONValue(TEXT("value"), setJson);
+		}
+		return;
+	}
+#endif //HS_GRIDLY_ALLOW_SET_PROPERTYTYPE_IN_TABLE
 
-		if (JsonWriter->Close())
+	JsonWriter.WriteValue("value", FGridlyExportPlan::GetValueAsString(Column, RowData));
+}
+
+bool FGridlyExporter::ExportToCSVFile(const UDataTable* DataTable, const FString& FilePath)
+{
+	if (!DataTable->RowStruct)
+	{
+		return false;
+	}
+
+	GridlyExporter::FUtf8FileStream FileStream(FilePath);
+	if (!FileStream.IsValid())
+	{
+		return false;
+	}
+
+	const TSharedRef<const FGridlyExportPlan> ExportPlan = FGridlyExportPlan::Get(DataTable->RowStruct);
+
+	// Byte order mark, so that spreadsheet applications detect UTF-8
+
+	static const uint8 Utf8Bom[] = {0xEF, 0xBB, 0xBF};
+	FileStream.WriteBytes(Utf8Bom, UE_ARRAY_COUNT(Utf8Bom));
+
+	// Header
+
+	FString Line = DataTable->ImportKeyField.IsEmpty() ? FString(TEXT("---")) : DataTable->ImportKeyField;
+	for (const FGridlyExportColumn& Column : ExportPlan->GetAllColumns())
+	{
+		Line += TEXT(",");
+		Line += Column.ColumnId;
+	}
+	Line += TEXT("\n");
+	FileStream.Write(Line);
+
+	// Rows, the line buffer is reused so that its allocation grows to the widest row only once
+
+	for (const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		Line.Reset();
+		Line += Row.Key.ToString();
+
+		for (const FGridlyExportColumn& Column : ExportPlan->GetAllColumns())
 		{
-			return true;
+			Line += TEXT(",\"");
+			Line += FGridlyExportPlan::GetValueAsString(Column, Row.Value).Replace(TEXT("\""), TEXT("\"\""));
+			Line += TEXT("\"");
 		}
+
+		Line += TEXT("\n");
+		FileStream.Write(Line);
 	}
 
-	return false;
+	return FileStream.Close();
 }
 
+bool FGridlyExporter::ExportToJSONFile(const UDataTable* DataTable, const FString& FilePath)
+{
+	if (!DataTable->RowStruct)
+	{
+		return false;
+	}
+
+	GridlyExporter::FUtf8FileStream FileStream(FilePath);
+	if (!FileStream.IsValid())
+	{
+		return false;
+	}
+
+	const FString KeyField = GridlyDataTableJSONUtils::GetKeyFieldName(*DataTable);
+
+	// Each row is written as its own pretty printed object, so only one row is held in memory at a time. Values go through the
+	// engine's JSON exporter, so that the file has the same keys as GetTableAsJSON and can be imported again
+
+	FileStream.Write(TEXT("["));
+
+	FString RowJson;
+	bool bFirstRow = true;
+
+	for (const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		RowJson.Reset();
+
+		const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> JsonWriter =
+			TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&RowJson, 1);
+
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(KeyField, Row.Key.ToString());
+		FDataTableExporterJSON(EDataTableExportFlags::UseJsonObjectsForStructs, JsonWriter).WriteRow(DataTable->RowStruct, Row.Value,
+			&KeyField);
+		JsonWriter->WriteObjectEnd();
+		JsonWriter->Close();
+
+		FileStream.Write(bFirstRow ? TEXT("\n\t") : TEXT(",\n\t"));
+		FileStream.Write(RowJson);
+		bFirstRow = false;
+	}
+
+	FileStream.Write(TEXT("\n]"));
+
+	return FileStream.Close();
+}
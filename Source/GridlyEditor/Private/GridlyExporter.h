@@ -3,13 +3,28 @@
 #pragma once
 
 #include "GridlyDataTable.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
 
 class FLocTextHelper;
+struct FGridlyExportColumn;
 
 class FGridlyExporter
 {
 public:
-	static bool ConvertToJson(const TArray<FPolyglotTextData>& PolyglotTextDatas, bool bIncludeTargetTranslations,
+	static bool ConvertToJson(TConstArrayView<FPolyglotTextData> PolyglotTextDatas, bool bIncludeTargetTranslations,
 		const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, FString& OutJsonString);
-	static bool ConvertToJson(const UGridlyDataTable* GridlyDataTable, FString& OutJsonString, size_t StartIndex, size_t MaxSize);
+	/** When DirtyCells is set, only those rows and the cells with their bit set are converted */
+	static bool ConvertToJson(const UGridlyDataTable* GridlyDataTable, FString& OutJsonString, size_t StartIndex, size_t MaxSize,
+		const TMap<FName, TBitArray<>>* DirtyCells = nullptr);
+
+	/** Streams the table to a UTF-8 CSV file in the same layout as UDataTable::GetTableAsCSV, one row at a time */
+	static bool ExportToCSVFile(const UDataTable* DataTable, const FString& FilePath);
+
+	/** Streams the table to a UTF-8 JSON file in the same layout as UDataTable::GetTableAsJSON, one row at a time */
+	static bool ExportToJSONFile(const UDataTable* DataTable, const FString& FilePath);
+
+private:
+	static void WriteContainerValue(TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& JsonWriter, const FGridlyExportColumn& Column,
+		const uint8* RowData);
 };
@@ -0,0 +1,190 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyGenerateDataCommandlet.h"
+
+#include "GridlyDataTable.h"
+#include "GridlyDataTableImporterJSON.h"
+#include "GridlyProfiling.h"
+#include "GridlySyntheticData.h"
+#include "Algo/Find.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGridlyGenerateDataCommandlet, Log, All);
+
+namespace GridlyGenerateDataCommandlet
+{
+	static const int32 DefaultPageSize = 1000;
+
+	static const TCHAR* const AllOutputs[] = { TEXT("Records"), TEXT("CSV"), TEXT("DataTable"), TEXT("Localization") };
+}
+
+int32 UGridlyGenerateDataCommandlet::Main(const FString& Params)
+{
+	LLM_SCOPE_BYTAG(Gridly);
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	FGridlySyntheticDataShape Shape;
+	Shape.ParseParams(ParamVals, Switches);
+
+	FString OutputDir = FPaths::ProjectSavedDir() / TEXT("Gridly/Synthetic");
+	if (const FString* OutputDirParamVal = ParamVals.Find(FString(TEXT("OutputDir"))))
+	{
+		OutputDir = *OutputDirParamVal;
+	}
+
+	int32 PageSize = GridlyGenerateDataCommandlet::DefaultPageSize;
+	if (const FString* PageSizeParamVal = ParamVals.Find(FString(TEXT("PageSize"))))
+	{
+		PageSize = FMath::Max(1, FCString::Atoi(**PageSizeParamVal));
+	}
+
+	// Optional comma separated list of the outputs to write, all outputs are written by default
+	TArray<FString> OutputFilter;
+	if (const FString* OutputsParamVal = ParamVals.Find(FString(TEXT("Outputs"))))
+	{
+		OutputsParamVal->ParseIntoArray(OutputFilter, TEXT(","));
+		for (const FString& Output : OutputFilter)
+		{
+			if (!Algo::FindByPredicate(GridlyGenerateDataCommandlet::AllOutputs,
+				[&Output](const TCHAR* Name) { return Output.Equals(Name, ESearchCase::IgnoreCase); }))
+			{
+				UE_LOG(LogGridlyGenerateDataCommandlet, Warning, TEXT("Unknown output %s"), *Output);
+			}
+		}
+	}
+
+	const auto ShouldWrite = [&OutputFilter](const TCHAR* Output)
+	{
+		return OutputFilter.Num() == 0 || OutputFilter.Contains(Output);
+	};
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	const FGridlySyntheticData SyntheticData(Shape);
+
+	UE_LOG(LogGridlyGenerateDataCommandlet, Display, TEXT("Generated %d records with %d languages in %.2f s"),
+		SyntheticData.GetTableRows().Num(), SyntheticData.GetGridlyCultures().Num(), FPlatformTime::Seconds() - StartSeconds);
+
+	bool bSuccess = true;
+
+	if (ShouldWrite(TEXT("Records")))
+	{
+		bSuccess &= WriteRecordPages(SyntheticData, PageSize, OutputDir / TEXT("Records"));
+	}
+
+	if (ShouldWrite(TEXT("CSV")))
+	{
+		const FString FilePath = OutputDir / TEXT("Export.csv");
+		bSuccess &= FFileHelper::SaveStringToFile(SyntheticData.ToCSV(), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8);
+		UE_LOG(LogGridlyGenerateDataCommandlet, Display, TEXT("Wrote %s"), *FilePath);
+	}
+
+	if (ShouldWrite(TEXT("DataTable")))
+	{
+		const FString FilePath = OutputDir / TEXT("DataTable.json");
+		bSuccess &= FFileHelper::SaveStringToFile(SyntheticData.ToDataTableJson(), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8);
+		UE_LOG(LogGridlyGenerateDataCommandlet, Display, TEXT("Wrote %s"), *FilePath);
+	}
+
+	if (ShouldWrite(TEXT("Localization")))
+	{
+		const FString LocalizationDir = OutputDir / TEXT("Localization");
+		FText WriteError;
+		if (SyntheticData.WriteLocalization(LocalizationDir, &WriteError))
+		{
+			UE_LOG(LogGridlyGenerateDataCommandlet, Display, TEXT("Wrote a manifest and %d archives to %s"),
+				SyntheticData.GetGridlyCultures().Num(), *LocalizationDir);
+		}
+		else
+		{
+			UE_LOG(LogGridlyGenerateDataCommandlet, Error, TEXT("%s"), *WriteError.ToString());
+			bSuccess = false;
+		}
+	}
+
+	if (const FString* DataTableAssetParamVal = ParamVals.Find(FString(TEXT("DataTableAsset"))))
+	{
+		bSuccess &= SaveDataTableAsset(SyntheticData, *DataTableAssetParamVal);
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogGridlyGenerateDataCommandlet, Error, TEXT("Failed to write all outputs to %s"), *OutputDir);
+		return 1;
+	}
+
+	UE_LOG(LogGridlyGenerateDataCommandlet, Display, TEXT("Done in %.2f s"), FPlatformTime::Seconds() - StartSeconds);
+
+	return 0;
+}
+
+bool UGridlyGenerateDataCommandlet::WriteRecordPages(const FGridlySyntheticData& SyntheticData, const int32 PageSize,
+	const FString& OutputDir)
+{
+	// Pages of an earlier, larger dataset would otherwise be left behind
+	IFileManager::Get().DeleteDirectory(*OutputDir, false, true);
+
+	const int32 NumRecords = SyntheticData.GetTableRows().Num();
+	int32 NumPages = 0;
+
+	for (int32 StartIndex = 0; StartIndex < NumRecords; StartIndex += PageSize)
+	{
+		const FString FilePath = OutputDir / FString::Printf(TEXT("Page_%05d.json"), NumPages++);
+		if (!FFileHelper::SaveStringToFile(SyntheticData.ToRecordsJson(StartIndex, PageSize), *FilePath,
+			FFileHelper::EEncodingOptions::ForceUTF8))
+		{
+			UE_LOG(LogGridlyGenerateDataCommandlet, Error, TEXT("Failed to write %s"), *FilePath);
+			return false;
+		}
+	}
+
+	UE_LOG(LogGridlyGenerateDataCommandlet, Display, TEXT("Wrote %d record pages to %s"), NumPages, *OutputDir);
+
+	return true;
+}
+
+bool UGridlyGenerateDataCommandlet::SaveDataTableAsset(const FGridlySyntheticData& SyntheticData, const FString& PackageName)
+{
+	FText PackageNameError;
+	if (!FPackageName::IsValidLongPackageName(PackageName, false, &PackageNameError))
+	{
+		UE_LOG(LogGridlyGenerateDataCommandlet, Error, TEXT("%s"), *PackageNameError.ToString());
+		return false;
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	UGridlyDataTable* GridlyDataTable = NewObject<UGridlyDataTable>(Package, *FPackageName::GetShortName(PackageName),
+		RF_Public | RF_Standalone);
+	GridlyDataTable->RowStruct = FGridlySyntheticRow::StaticStruct();
+
+	TArray<FString> ImportProblems;
+	FGridlyDataTableImporterJSON(*GridlyDataTable, SyntheticData.ToDataTableJson(), ImportProblems).ReadTable();
+	for (const FString& ImportProblem : ImportProblems)
+	{
+		UE_LOG(LogGridlyGenerateDataCommandlet, Warning, TEXT("%s"), *ImportProblem);
+	}
+
+	Package->MarkPackageDirty();
+
+	const FString FilePath = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!UPackage::SavePackage(Package, GridlyDataTable, *FilePath, SaveArgs))
+	{
+		UE_LOG(LogGridlyGenerateDataCommandlet, Error, TEXT("Failed to save %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogGridlyGenerateDataCommandlet, Display, TEXT("Saved %s with %d rows"), *PackageName, GridlyDataTable->GetRowMap().Num());
+
+	return true;
+}
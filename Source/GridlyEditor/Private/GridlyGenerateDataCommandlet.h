@@ -0,0 +1,40 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "GridlyGenerateDataCommandlet.generated.h"
+
+class FGridlySyntheticData;
+
+/**
+ * Writes a synthetic Gridly view of any shape to disk: record pages as returned by the Gridly API, the CSV export of the view,
+ * data table rows, a localization manifest with one archive per culture and, optionally, a Gridly data table asset:
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=GridlyGenerateData -Records=300000 -Languages=30 -DialogueRatio=0.2 -PathDepth=4
+ */
+UCLASS()
+class UGridlyGenerateDataCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGridlyGenerateDataCommandlet(const FObjectInitializer& ObjectInitializer)
+		: Super(ObjectInitializer)
+	{
+		IsClient = false;
+		IsEditor = true;
+		IsServer = false;
+		LogToConsole = true;
+	}
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	static bool WriteRecordPages(const FGridlySyntheticData& SyntheticData, int32 PageSize, const FString& OutputDir);
+	static bool SaveDataTableAsset(const FGridlySyntheticData& SyntheticData, const FString& PackageName);
+};
@@ -2,6 +2,9 @@
 
 #include "GridlyImportExportCommandlet.h"
 #include "GridlyLocalizationServiceProvider.h"
+#include "GridlyProfiling.h"
+#include "GridlySyncEstimate.h"
+#include "GridlySyncReport.h"
 #include "Modules/ModuleManager.h"
 #include "ILocalizationServiceModule.h"
 #include "LocalizationModule.h"
@@ -10,6 +13,9 @@
 #include "HttpModule.h"
 #include "HttpManager.h"
 #include "LocalizationConfigurationScript.h"
+#include "GridlyGameSettings.h"
+#include "Containers/Ticker.h"
+#include "Misc/FileHelper.h"
 
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Package.h"
@@ -17,6 +23,15 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogGridlyImportExportCommandlet, Log, All);
 
+namespace GridlyImportExportCommandlet
+{
+	/** Interval at which the HTTP manager is ticked while requests are outstanding */
+	static const float HttpTickInterval = 0.005f;
+
+	/** Longest wait between reads of an idle child process pipe */
+	static const float MaxPipeReadInterval = 0.05f;
+}
+
 #define LOCTEXT_NAMESPACE "GridlyImportExportCommandlet"
 
 /**
@@ -24,6 +39,9 @@ DEFINE_LOG_CATEGORY_STATIC(LogGridlyImportExportCommandlet, Log, All);
 */
 int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 {
+	// Everything the commandlet allocates is for the sync
+	LLM_SCOPE_BYTAG(Gridly);
+
 	TArray<FString> Tokens;
 	TArray<FString> Switches;
 	TMap<FString, FString> ParamVals;
@@ -80,117 +98,358 @@ int32 UGridlyImportExportCommandlet::Main(const FString& Params)
 		return -1;
 	}
 
+	// Number of targets that are processed at the same time. Exports are always sent one target at a time, since all
+	// targets export to the same view and the provider keeps the state of one export only
+	int32 MaxParallelTargets = 1;
+	if (const FString* ParallelParamVal = ParamVals.Find(FString(TEXT("Parallel"))))
+	{
+		MaxParallelTargets = FMath::Max(1, FCString::Atoi(**ParallelParamVal));
+	}
+
+	// Texts can be split into shards by namespace and key, to sync one target on several machines. Each shard uploads its
+	// texts and writes the .po files of its texts, which a final run with -MergeShards=N combines and imports
+	Shard = FGridlyShard();
+	if (const FString* ShardParamVal = ParamVals.Find(FString(TEXT("Shard"))))
+	{
+		if (!FGridlyShard::Parse(*ShardParamVal, Shard))
+		{
+			UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("Invalid shard %s, expected Index/Count such as 0/4."), **ShardParamVal);
+			return -1;
+		}
+	}
+	GridlyProvider->SetShard(Shard);
+
+	int32 NumShardsToMerge = 0;
+	if (const FString* MergeShardsParamVal = ParamVals.Find(FString(TEXT("MergeShards"))))
+	{
+		NumShardsToMerge = FCString::Atoi(**MergeShardsParamVal);
+		if (NumShardsToMerge < 1 || Shard.IsSharded())
+		{
+			UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("Invalid shard count %s, or -MergeShards used with -Shard."),
+				**MergeShardsParamVal);
+			return -1;
+		}
+
+		if (bDoExport)
+		{
+			UE_LOG(LogGridlyImportExportCommandlet, Display, TEXT("Skipping export while merging shards, each shard has exported its texts."));
+			bDoExport = false;
+		}
+	}
+
+	ShardDir = FPaths::ProjectSavedDir() / TEXT("Gridly") / TEXT("Shards");
+	if (const FString* ShardDirParamVal = ParamVals.Find(FString(TEXT("ShardDir"))))
+	{
+		ShardDir = *ShardDirParamVal;
+	}
+
+	// A dry run downloads and uploads nothing, it only estimates the requests, payload and duration of the sync
+	const bool bDryRun = Switches.Contains(TEXT("DryRun"));
+
+	// Optional JSON report of the time, traffic and records of every stage, started once all parameters are valid
+	FString ReportPath;
+	TUniquePtr<FGridlySyncReport> Report;
+	if (const FString* ReportParamVal = ParamVals.Find(FString(TEXT("Report"))))
+	{
+		ReportPath = *ReportParamVal;
+		Report = MakeUnique<FGridlySyncReport>();
+		Report->Start();
+	}
+
+	Jobs.Reset();
 	const TArray<ULocalizationTarget*> LocalizationTargets = ULocalizationSettings::GetGameTargetSet()->TargetObjects;
-	//ULocalizationTarget* FirstLocTarget = LocalizationTargets.Num() > 0 ? LocalizationTargets[0]: nullptr;
 	for (ULocalizationTarget* LocTarget : LocalizationTargets)
 	{
-		// Do something with LocTarget
 		if (LocTarget != nullptr)
 		{
-			if (bDoImport)
+			FGridlyTargetJob& Job = Jobs.AddDefaulted_GetRef();
+			Job.Target = LocTarget;
+
+			if (bDryRun)
+			{
+				Job.Estimate = MakeShared<FGridlySyncEstimate>();
+			}
+		}
+
+		if (ExportAllGameTargetPtr && *ExportAllGameTargetPtr == "false") {
+			break;
+		}
+	}
+
+	// All targets import from the same views, so their sizes are only read once
+
+	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	TArray<int32> ImportRecordCounts;
+
+	if (bDryRun && bDoImport)
+	{
+		TArray<FString> ImportViewIds;
+		for (const FString& ViewId : GameSettings->ImportFromViewIds)
+		{
+			if (!ViewId.IsEmpty())
+			{
+				ImportViewIds.Add(ViewId);
+			}
+		}
+
+		bool bHasRecordCounts = false;
+		FGridlySyncEstimate::RequestRecordCounts(ImportViewIds, GameSettings->ImportApiKey,
+			[&ImportRecordCounts, &bHasRecordCounts](const TArray<int32>& RecordCounts)
+			{
+				ImportRecordCounts = RecordCounts;
+				bHasRecordCounts = true;
+			});
+
+		TickHttpUntil([&bHasRecordCounts]() { return bHasRecordCounts; });
+	}
+
+	FHttpManager& HttpManager = FHttpModule::Get().GetHttpManager();
+	double LastTickTime = FPlatformTime::Seconds();
+	float WaitInterval = 0.f;
+
+	for (;;)
+	{
+		int32 NumActiveJobs = 0;
+		bool bWaitingForHttp = false;
+		bool bReceivedOutput = false;
+		bool bExportInProgress = Jobs.ContainsByPredicate([](const FGridlyTargetJob& Job)
+		{
+			return Job.Stage == FGridlyTargetJob::EStage::Exporting;
+		});
+
+		for (int32 JobIndex = 0; JobIndex < Jobs.Num(); JobIndex++)
+		{
+			FGridlyTargetJob& Job = Jobs[JobIndex];
+
+			if (Job.Stage == FGridlyTargetJob::EStage::Pending && NumActiveJobs < MaxParallelTargets)
 			{
-				// List all cultures (even the native one in case some native translations have been modified in Gridly) to download
-				TArray<FString> Cultures;
-				for (int ItCulture = 0; ItCulture < LocTarget->Settings.SupportedCulturesStatistics.Num(); ItCulture++)
+				UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("Processing target %s"), *Job.Target->Settings.Name);
+
+				if (bDoImport && NumShardsToMerge > 0)
 				{
-					if (ItCulture != LocTarget->Settings.NativeCultureIndex)
+					if (MergeShards(Job, NumShardsToMerge))
+					{
+						StartImport(Job);
+
+						if (Report && Job.Stage == FGridlyTargetJob::EStage::Importing)
+						{
+							Report->BeginStage(Job.Target->Settings.Name, TEXT("import"));
+						}
+					}
+					else
 					{
-						const FCultureStatistics CultureStats = LocTarget->Settings.SupportedCulturesStatistics[ItCulture];
-						Cultures.Add(CultureStats.CultureName);
+						Job.Stage = FGridlyTargetJob::EStage::Imported;
 					}
 				}
+				else if (bDoImport && bDryRun)
+				{
+					// Every culture but the native one downloads all import views
+					const FLocalizationTargetSettings& TargetSettings = Job.Target->Settings;
+					const int32 NumCultures = TargetSettings.SupportedCulturesStatistics.Num() -
+						(TargetSettings.SupportedCulturesStatistics.IsValidIndex(TargetSettings.NativeCultureIndex) ? 1 : 0);
 
-				// Download cultures from Gridly
-				CulturesToDownload.Append(Cultures);
-				for (const FString& CultureName : Cultures)
+					Job.Estimate->AddImport(ImportRecordCounts, GameSettings->ImportMaxRecordsPerRequest, NumCultures);
+					Job.Stage = FGridlyTargetJob::EStage::Imported;
+				}
+				else if (bDoImport)
 				{
-					ILocalizationServiceProvider& Provider = ILocalizationServiceModule::Get().GetProvider();
-					TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe> DownloadTargetFileOp =
-						ILocalizationServiceOperation::Create<FDownloadLocalizationTargetFile>();
-					DownloadTargetFileOp->SetInTargetGuid(LocTarget->Settings.Guid);
-					DownloadTargetFileOp->SetInLocale(CultureName);
-
-					FString Path = FPaths::ProjectSavedDir() / "Temp" / "Game" / LocTarget->Settings.Name / CultureName /
-						LocTarget->Settings.Name + ".po";
-					FPaths::MakePathRelativeTo(Path, *FPaths::ProjectDir());
-					DownloadTargetFileOp->SetInRelativeOutputFilePathAndName(Path);
-
-					auto OperationCompleteDelegate = FLocalizationServiceOperationComplete::CreateUObject(this,
-						&UGridlyImportExportCommandlet::OnDownloadComplete, false);
-
-					Provider.Execute(DownloadTargetFileOp, TArray<FLocalizationServiceTranslationIdentifier>(),
-						ELocalizationServiceOperationConcurrency::Synchronous, OperationCompleteDelegate);
+					StartDownloads(JobIndex);
 				}
-
-				// Wait for all downloads
-				while (CulturesToDownload.Num())
+				else
 				{
-					FPlatformProcess::Sleep(0.4f);
-					FHttpModule::Get().GetHttpManager().Tick(-1.f);
+					Job.Stage = FGridlyTargetJob::EStage::WaitingForExport;
 				}
+			}
 
-				// Run task to import po files, it will be done on the base folder and import all po files data generated after downloading data from gridly
-				if (CulturesToDownload.Num() == 0 && DownloadedFiles.Num() > 0)
+			if (Job.Stage == FGridlyTargetJob::EStage::Downloading && Job.CulturesToDownload.Num() == 0)
+			{
+				if (Report)
 				{
-					const FString& DlPoFile = DownloadedFiles[0]; // retrieve first po file to deduce the base folder
-					const FString TargetName = FPaths::GetBaseFilename(DlPoFile);
-					const auto Target = ILocalizationModule::Get().GetLocalizationTargetByName(TargetName, false);
-
-					const FString DirectoryPath = FPaths::GetPath(DlPoFile);
-					const FString DownloadBasePath = FPaths::GetPath(DirectoryPath);
+					Report->EndStage(Job.Target->Settings.Name, TEXT("fetch"));
+				}
 
-					// Create commandlet task to Import texts
-					// Note that we could simply "Import all PO files" using a call to PortableObjectPipeline::ImportAll(...), though
-					//		using tasks we are able to easily add/remove call to existing localization functionalities
-					TArray<LocalizationCommandletExecution::FTask> Tasks;
-					const bool ShouldUseProjectFile = !Target->IsMemberOfEngineTargetSet();
+				if (Shard.IsSharded())
+				{
+					// A shard only holds some of the texts, which are imported once all shards are merged
+					UE_LOG(LogGridlyImportExportCommandlet, Display, TEXT("Downloaded shard %s of %s to %s"), *Shard.ToString(),
+						*Job.Target->Settings.Name, *ShardDir);
+					Job.DownloadedFiles.Empty();
+					Job.Stage = FGridlyTargetJob::EStage::Imported;
+				}
+				else
+				{
+					StartImport(Job);
+				}
 
-					const FString ImportScriptPath = LocalizationConfigurationScript::GetImportTextConfigPath(Target, TOptional<FString>());
-					LocalizationConfigurationScript::GenerateImportTextConfigFile(Target, TOptional<FString>(), DownloadBasePath).WriteWithSCC(ImportScriptPath);
-					Tasks.Add(LocalizationCommandletExecution::FTask(LOCTEXT("ImportTaskName", "Import Translations"), ImportScriptPath, ShouldUseProjectFile));
+				if (Report && Job.Stage == FGridlyTargetJob::EStage::Importing)
+				{
+					Report->BeginStage(Job.Target->Settings.Name, TEXT("import"));
+				}
+			}
 
-					const FString ReportScriptPath = LocalizationConfigurationScript::GetWordCountReportConfigPath(Target);
-					LocalizationConfigurationScript::GenerateWordCountReportConfigFile(Target).WriteWithSCC(ReportScriptPath);
-					Tasks.Add(LocalizationCommandletExecution::FTask(LOCTEXT("ReportTaskName", "Generate Reports"), ReportScriptPath, ShouldUseProjectFile));
+			if (Job.Stage == FGridlyTargetJob::EStage::Importing)
+			{
+				bReceivedOutput |= PumpImport(Job);
 
-					// Function will block until all tasks have been run
-					BlockingRunLocCommandletTask(Tasks);
+				if (Report && Job.Stage == FGridlyTargetJob::EStage::Imported)
+				{
+					Report->EndStage(Job.Target->Settings.Name, TEXT("import"));
 				}
+			}
 
-				// Cleanup
-				CulturesToDownload.Empty();
-				DownloadedFiles.Empty();
+			if (Job.Stage == FGridlyTargetJob::EStage::Imported)
+			{
+				Job.Stage = bDoExport ? FGridlyTargetJob::EStage::WaitingForExport : FGridlyTargetJob::EStage::Done;
 			}
 
-			if (bDoExport)
+			if (Job.Stage == FGridlyTargetJob::EStage::WaitingForExport && !bExportInProgress && !GridlyProvider->HasRequestsPending())
 			{
 				FHttpRequestCompleteDelegate ReqDelegate = GridlyProvider->CreateExportNativeCultureDelegate();
 				const FText SlowTaskText = LOCTEXT("ExportNativeCultureForTargetToGridlyText", "Exporting native culture for target to Gridly");
 
-				GridlyProvider->ExportForTargetToGridly(LocTarget, ReqDelegate, SlowTaskText);
+				if (Report)
+				{
+					Report->BeginStage(Job.Target->Settings.Name, TEXT("serialize"));
+				}
+
+				GridlyProvider->SetDryRunEstimate(Job.Estimate);
+				GridlyProvider->ExportForTargetToGridly(Job.Target, ReqDelegate, SlowTaskText);
+				Job.Stage = FGridlyTargetJob::EStage::Exporting;
+				bExportInProgress = true;
 
-				// Wait for Http requests
-				while (GridlyProvider->HasRequestsPending())
+				if (Report)
 				{
-					FPlatformProcess::Sleep(0.4f);
-					FHttpModule::Get().GetHttpManager().Tick(-1.f);
+					Report->EndStage(Job.Target->Settings.Name, TEXT("serialize"));
+					Report->BeginStage(Job.Target->Settings.Name, TEXT("upload"));
+				}
+			}
+			else if (Job.Stage == FGridlyTargetJob::EStage::Exporting && !GridlyProvider->HasRequestsPending())
+			{
+				Job.Stage = FGridlyTargetJob::EStage::Done;
+				bExportInProgress = false;
+
+				if (Report)
+				{
+					Report->EndStage(Job.Target->Settings.Name, TEXT("upload"));
 				}
 			}
-		}
 
+			if (Job.Stage != FGridlyTargetJob::EStage::Pending && Job.Stage != FGridlyTargetJob::EStage::Done)
+			{
+				NumActiveJobs++;
+				bWaitingForHttp |= Job.Stage == FGridlyTargetJob::EStage::Downloading || Job.Stage == FGridlyTargetJob::EStage::Exporting;
+			}
+		}
 
-		if (ExportAllGameTargetPtr && *ExportAllGameTargetPtr == "false") {
+		if (NumActiveJobs == 0)
+		{
 			break;
 		}
+
+		// Completion delegates are dispatched from the HTTP manager tick on this thread, so the tick runs at a tight interval
+		// while requests are outstanding. The download tasks delay their page requests on the core ticker, which is ticked
+		// along, so the delays of all jobs run at the same time. Pipes cannot be read blocking, so idle child processes are polled
+		// less and less often
+
+		if (bWaitingForHttp)
+		{
+			WaitInterval = GridlyImportExportCommandlet::HttpTickInterval;
+		}
+		else
+		{
+			WaitInterval = bReceivedOutput
+				? 0.f
+				: FMath::Min(FMath::Max(WaitInterval * 2.f, 0.001f), GridlyImportExportCommandlet::MaxPipeReadInterval);
+		}
+		FPlatformProcess::SleepNoStats(WaitInterval);
+
+		const double TickTime = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(TickTime - LastTickTime));
+		HttpManager.Tick(static_cast<float>(TickTime - LastTickTime));
+		LastTickTime = TickTime;
+	}
+
+	if (bDryRun)
+	{
+		FGridlySyncEstimate TotalEstimate;
+		for (const FGridlyTargetJob& Job : Jobs)
+		{
+			UE_LOG(LogGridlyImportExportCommandlet, Display, TEXT("Estimated sync of %s:\n%s"), *Job.Target->Settings.Name,
+				*Job.Estimate->ToString());
+			TotalEstimate.Append(*Job.Estimate);
+		}
+
+		UE_LOG(LogGridlyImportExportCommandlet, Display, TEXT("Estimated sync of all targets:\n%s"), *TotalEstimate.ToString());
+	}
+
+	Jobs.Empty();
+
+	if (Report)
+	{
+		// Records deleted by the sync after the last upload are requested from completion callbacks, so they are
+		// only covered once every request seen by the report has completed
+
+		TickHttpUntil([&Report]() { return Report->GetNumRequestsInFlight() == 0; });
+
+		Report->Stop();
+		Report->WriteToFile(ReportPath, MaxParallelTargets);
 	}
+
 	return 0;
 }
 
-void UGridlyImportExportCommandlet::OnDownloadComplete(const FLocalizationServiceOperationRef& Operation, ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet)
+void UGridlyImportExportCommandlet::StartDownloads(const int32 JobIndex)
+{
+	FGridlyTargetJob& Job = Jobs[JobIndex];
+	ULocalizationTarget* LocTarget = Job.Target;
+	Job.Stage = FGridlyTargetJob::EStage::Downloading;
+
+	if (FGridlySyncReport* Report = FGridlySyncReport::GetActive())
+	{
+		Report->BeginStage(LocTarget->Settings.Name, TEXT("fetch"));
+	}
+
+	// List all cultures (even the native one in case some native translations have been modified in Gridly) to download
+	TArray<FString> Cultures;
+	for (int ItCulture = 0; ItCulture < LocTarget->Settings.SupportedCulturesStatistics.Num(); ItCulture++)
+	{
+		if (ItCulture != LocTarget->Settings.NativeCultureIndex)
+		{
+			const FCultureStatistics CultureStats = LocTarget->Settings.SupportedCulturesStatistics[ItCulture];
+			Cultures.Add(CultureStats.CultureName);
+		}
+	}
+
+	// Download cultures from Gridly
+	Job.CulturesToDownload.Append(Cultures);
+	for (const FString& CultureName : Cultures)
+	{
+		ILocalizationServiceProvider& Provider = ILocalizationServiceModule::Get().GetProvider();
+		TSharedRef<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe> DownloadTargetFileOp =
+			ILocalizationServiceOperation::Create<FDownloadLocalizationTargetFile>();
+		DownloadTargetFileOp->SetInTargetGuid(LocTarget->Settings.Guid);
+		DownloadTargetFileOp->SetInLocale(CultureName);
+
+		FString Path = Shard.IsSharded()
+			? GetShardFilePath(Shard.Index, LocTarget, CultureName)
+			: FPaths::ProjectSavedDir() / "Temp" / "Game" / LocTarget->Settings.Name / CultureName / LocTarget->Settings.Name + ".po";
+		FPaths::MakePathRelativeTo(Path, *FPaths::ProjectDir());
+		DownloadTargetFileOp->SetInRelativeOutputFilePathAndName(Path);
+
+		auto OperationCompleteDelegate = FLocalizationServiceOperationComplete::CreateUObject(this,
+			&UGridlyImportExportCommandlet::OnDownloadComplete, false, JobIndex);
+
+		Provider.Execute(DownloadTargetFileOp, TArray<FLocalizationServiceTranslationIdentifier>(),
+			ELocalizationServiceOperationConcurrency::Synchronous, OperationCompleteDelegate);
+	}
+}
+
+void UGridlyImportExportCommandlet::OnDownloadComplete(const FLocalizationServiceOperationRef& Operation, ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet, int32 JobIndex)
 {
 	// do like in FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly
 	TSharedPtr<FDownloadLocalizationTargetFile, ESPMode::ThreadSafe> DownloadLocalizationTargetOp = StaticCastSharedRef<FDownloadLocalizationTargetFile>(Operation);
-	CulturesToDownload.Remove(DownloadLocalizationTargetOp->GetInLocale());
+	FGridlyTargetJob& Job = Jobs[JobIndex];
+	Job.CulturesToDownload.Remove(DownloadLocalizationTargetOp->GetInLocale());
 
 	if (Result != ELocalizationServiceOperationCommandResult::Succeeded)
 	{
@@ -198,59 +457,180 @@ void UGridlyImportExportCommandlet::OnDownloadComplete(const FLocalizationServic
 		UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("%s"), *ErrorMessage.ToString());
 	}
 
-	const FString TargetName = FPaths::GetBaseFilename(DownloadLocalizationTargetOp->GetInRelativeOutputFilePathAndName());
-
-	const auto Target = ILocalizationModule::Get().GetLocalizationTargetByName(TargetName, false);
 	const FString AbsoluteFilePathAndName = FPaths::ConvertRelativePathToFull(
 		FPaths::ProjectDir() / DownloadLocalizationTargetOp->GetInRelativeOutputFilePathAndName());
 
-	DownloadedFiles.Add(AbsoluteFilePathAndName);
+	Job.DownloadedFiles.Add(AbsoluteFilePathAndName);
 }
 
-void UGridlyImportExportCommandlet::BlockingRunLocCommandletTask(const TArray<LocalizationCommandletExecution::FTask>& Tasks)
+void UGridlyImportExportCommandlet::StartImport(FGridlyTargetJob& Job)
 {
-	for (const LocalizationCommandletExecution::FTask& LocTask : Tasks)
+	Job.Stage = FGridlyTargetJob::EStage::Imported;
+
+	// Run task to import po files, it will be done on the base folder and import all po files data generated after downloading data from gridly
+	if (Job.DownloadedFiles.Num() > 0)
 	{
-		TSharedPtr<FLocalizationCommandletProcess> CommandletProcess = FLocalizationCommandletProcess::Execute(LocTask.ScriptPath, LocTask.ShouldUseProjectFile);
+		const FString& DlPoFile = Job.DownloadedFiles[0]; // retrieve first po file to deduce the base folder
+		const FString TargetName = FPaths::GetBaseFilename(DlPoFile);
+		const auto Target = ILocalizationModule::Get().GetLocalizationTargetByName(TargetName, false);
 
-		if (CommandletProcess.IsValid())
-		{
-			UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("=== Starting Task [%s] ==="), *LocTask.Name.ToString());
+		const FString DirectoryPath = FPaths::GetPath(DlPoFile);
+		const FString DownloadBasePath = FPaths::GetPath(DirectoryPath);
 
-			FProcHandle CurrentProcessHandle = CommandletProcess->GetHandle();
-			int32 ReturnCode = INDEX_NONE;
+		// Create commandlet task to Import texts
+		// Note that we could simply "Import all PO files" using a call to PortableObjectPipeline::ImportAll(...), though
+		//		using tasks we are able to easily add/remove call to existing localization functionalities
+		const bool ShouldUseProjectFile = !Target->IsMemberOfEngineTargetSet();
 
-			// This loop is the same than FCommandletLogPump::Run(), and it's used when SLocalizationCommandletExecutor widget runs localization commandlet tasks
-			for (;;)
-			{
-				// Read from pipe.
-				const FString PipeString = FPlatformProcess::ReadPipe(CommandletProcess->GetReadPipe());
+		const FString ImportScriptPath = LocalizationConfigurationScript::GetImportTextConfigPath(Target, TOptional<FString>());
+		LocalizationConfigurationScript::GenerateImportTextConfigFile(Target, TOptional<FString>(), DownloadBasePath).WriteWithSCC(ImportScriptPath);
+		Job.LocTasks.Add(LocalizationCommandletExecution::FTask(LOCTEXT("ImportTaskName", "Import Translations"), ImportScriptPath, ShouldUseProjectFile));
 
-				// Process buffer.
-				if (!PipeString.IsEmpty())
-				{
-					UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("%s"), *PipeString);
-				}
+		const FString ReportScriptPath = LocalizationConfigurationScript::GetWordCountReportConfigPath(Target);
+		LocalizationConfigurationScript::GenerateWordCountReportConfigFile(Target).WriteWithSCC(ReportScriptPath);
+		Job.LocTasks.Add(LocalizationCommandletExecution::FTask(LOCTEXT("ReportTaskName", "Generate Reports"), ReportScriptPath, ShouldUseProjectFile));
 
-				// If the process isn't running and there's no data in the pipe, we're done.
-				if (!FPlatformProcess::IsProcRunning(CurrentProcessHandle) && PipeString.IsEmpty())
-				{
-					break;
-				}
+		Job.LocTaskIndex = 0;
+		Job.Stage = FGridlyTargetJob::EStage::Importing;
+	}
+
+	// Cleanup
+	Job.CulturesToDownload.Empty();
+	Job.DownloadedFiles.Empty();
+}
+
+FString UGridlyImportExportCommandlet::GetShardFilePath(const int32 ShardIndex, const ULocalizationTarget* Target,
+	const FString& CultureName) const
+{
+	// The file keeps the name of the target, since the import deduces the target from it
+	return ShardDir / FString::Printf(TEXT("Shard%d"), ShardIndex) / Target->Settings.Name / CultureName / Target->Settings.Name + TEXT(".po");
+}
+
+bool UGridlyImportExportCommandlet::MergeShards(FGridlyTargetJob& Job, const int32 NumShards)
+{
+	ULocalizationTarget* LocTarget = Job.Target;
 
-				// Sleep.
-				FPlatformProcess::Sleep(0.0f);
+	for (int ItCulture = 0; ItCulture < LocTarget->Settings.SupportedCulturesStatistics.Num(); ItCulture++)
+	{
+		if (ItCulture == LocTarget->Settings.NativeCultureIndex)
+		{
+			continue;
+		}
+
+		// The shards hold disjoint entries written without a header, so they combine by concatenation
+
+		const FString& CultureName = LocTarget->Settings.SupportedCulturesStatistics[ItCulture].CultureName;
+		FString MergedContent;
+
+		for (int32 ShardIndex = 0; ShardIndex < NumShards; ShardIndex++)
+		{
+			const FString ShardFilePath = GetShardFilePath(ShardIndex, LocTarget, CultureName);
+
+			FString ShardContent;
+			if (!FFileHelper::LoadFileToString(ShardContent, *ShardFilePath))
+			{
+				UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("Missing shard %d/%d of %s: %s"), ShardIndex, NumShards,
+					*LocTarget->Settings.Name, *ShardFilePath);
+				Job.DownloadedFiles.Empty();
+				return false;
 			}
 
-			if (CurrentProcessHandle.IsValid() && FPlatformProcess::GetProcReturnCode(CurrentProcessHandle, &ReturnCode))
+			MergedContent += ShardContent;
+			if (!MergedContent.IsEmpty() && !MergedContent.EndsWith(TEXT("\n")))
 			{
-				UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("===> Task [%s] returned : %d"), *LocTask.Name.ToString(), ReturnCode);
+				MergedContent += LINE_TERMINATOR;
 			}
 		}
+
+		const FString FilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / "Temp" / "Game" /
+			LocTarget->Settings.Name / CultureName / LocTarget->Settings.Name + ".po");
+
+		if (!FFileHelper::SaveStringToFile(MergedContent, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogGridlyImportExportCommandlet, Error, TEXT("Failed to write merged shards of %s: %s"),
+				*LocTarget->Settings.Name, *FilePath);
+			Job.DownloadedFiles.Empty();
+			return false;
+		}
+
+		Job.DownloadedFiles.Add(FilePath);
+	}
+
+	UE_LOG(LogGridlyImportExportCommandlet, Display, TEXT("Merged %d shards of %s"), NumShards, *LocTarget->Settings.Name);
+	return true;
+}
+
+bool UGridlyImportExportCommandlet::PumpImport(FGridlyTargetJob& Job)
+{
+	// The tasks of a target run one after another, while the tasks of other targets may run at the same time
+
+	while (!Job.CommandletProcess.IsValid())
+	{
+		if (Job.LocTaskIndex >= Job.LocTasks.Num())
+		{
+			Job.LocTasks.Empty();
+			Job.Stage = FGridlyTargetJob::EStage::Imported;
+			return false;
+		}
+
+		const LocalizationCommandletExecution::FTask& LocTask = Job.LocTasks[Job.LocTaskIndex];
+		Job.CommandletProcess = FLocalizationCommandletProcess::Execute(LocTask.ScriptPath, LocTask.ShouldUseProjectFile);
+
+		if (Job.CommandletProcess.IsValid())
+		{
+			UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("=== Starting Task [%s] ==="), *LocTask.Name.ToString());
+		}
 		else
 		{
 			UE_LOG(LogGridlyImportExportCommandlet, Warning, TEXT("Failed to start Task [%s] !"), *LocTask.Name.ToString());
+			Job.LocTaskIndex++;
+		}
+	}
+
+	const LocalizationCommandletExecution::FTask& LocTask = Job.LocTasks[Job.LocTaskIndex];
+	FProcHandle CurrentProcessHandle = Job.CommandletProcess->GetHandle();
+
+	// This is the same than one iteration of FCommandletLogPump::Run(), and it's used when SLocalizationCommandletExecutor widget runs localization commandlet tasks
+
+	// Read from pipe.
+	const FString PipeString = FPlatformProcess::ReadPipe(Job.CommandletProcess->GetReadPipe());
+
+	// Process buffer.
+	if (!PipeString.IsEmpty())
+	{
+		UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("[%s] %s"), *Job.Target->Settings.Name, *PipeString);
+		return true;
+	}
+
+	// If the process isn't running and there's no data in the pipe, we're done.
+	if (!FPlatformProcess::IsProcRunning(CurrentProcessHandle))
+	{
+		int32 ReturnCode = INDEX_NONE;
+		if (CurrentProcessHandle.IsValid() && FPlatformProcess::GetProcReturnCode(CurrentProcessHandle, &ReturnCode))
+		{
+			UE_LOG(LogGridlyImportExportCommandlet, Log, TEXT("===> Task [%s] returned : %d"), *LocTask.Name.ToString(), ReturnCode);
 		}
+
+		Job.CommandletProcess.Reset();
+		Job.LocTaskIndex++;
+	}
+
+	return false;
+}
+
+void UGridlyImportExportCommandlet::TickHttpUntil(TFunctionRef<bool()> IsDone)
+{
+	FHttpManager& HttpManager = FHttpModule::Get().GetHttpManager();
+	double LastTickTime = FPlatformTime::Seconds();
+
+	while (!IsDone())
+	{
+		FPlatformProcess::SleepNoStats(GridlyImportExportCommandlet::HttpTickInterval);
+
+		const double TickTime = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(TickTime - LastTickTime));
+		HttpManager.Tick(static_cast<float>(TickTime - LastTickTime));
+		LastTickTime = TickTime;
 	}
 }
 
@@ -7,8 +7,12 @@
 #include "Commandlets/GatherTextCommandletBase.h"
 #include "LocalizationCommandletExecution.h"
 #include "ILocalizationServiceProvider.h"
+#include "GridlyShard.h"
 #include "GridlyImportExportCommandlet.generated.h"
 
+class ULocalizationTarget;
+struct FGridlySyncEstimate;
+
 /**
  *	GridlyImportExportCommandlet: Commandlet to Export Native Texts to Gridy and Import translations from Gridly.
  */
@@ -27,10 +31,53 @@ public:
 	//~ End UCommandlet Interface
 
 private:
-	TArray<FString> CulturesToDownload;
-	TArray<FString> DownloadedFiles;
+	/** Progress of the import and export of one localization target */
+	struct FGridlyTargetJob
+	{
+		enum class EStage : uint8
+		{
+			Pending,
+			Downloading,
+			Importing,
+			Imported,
+			WaitingForExport,
+			Exporting,
+			Done
+		};
+
+		ULocalizationTarget* Target = nullptr;
+		EStage Stage = EStage::Pending;
+
+		TArray<FString> CulturesToDownload;
+		TArray<FString> DownloadedFiles;
+
+		TArray<LocalizationCommandletExecution::FTask> LocTasks;
+		int32 LocTaskIndex = 0;
+		TSharedPtr<FLocalizationCommandletProcess> CommandletProcess;
+
+		/** Set for a dry run, which only estimates the import and export of the target */
+		TSharedPtr<FGridlySyncEstimate> Estimate;
+	};
+
+	TArray<FGridlyTargetJob> Jobs;
+
+	/** Shard of the texts that this instance syncs, and the folder that the .po files of each shard are written to */
+	FGridlyShard Shard;
+	FString ShardDir;
 
 private:
-	void OnDownloadComplete(const FLocalizationServiceOperationRef& Operation, ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet);
-	void BlockingRunLocCommandletTask(const TArray<LocalizationCommandletExecution::FTask>& LocTasks);
+	void StartDownloads(const int32 JobIndex);
+	void OnDownloadComplete(const FLocalizationServiceOperationRef& Operation, ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet, int32 JobIndex);
+	void StartImport(FGridlyTargetJob& Job);
+
+	FString GetShardFilePath(int32 ShardIndex, const ULocalizationTarget* Target, const FString& CultureName) const;
+
+	/** Combines the .po files downloaded by each shard into the files that are imported, returns false if any is missing */
+	bool MergeShards(FGridlyTargetJob& Job, int32 NumShards);
+
+	/** Runs the localization commandlet tasks of the job, returns true if the running child process wrote output */
+	bool PumpImport(FGridlyTargetJob& Job);
+
+	/** Ticks the HTTP manager until the condition is met, for requests whose completion delegates the commandlet waits for */
+	static void TickHttpUntil(TFunctionRef<bool()> IsDone);
 };
\ No newline at end of file
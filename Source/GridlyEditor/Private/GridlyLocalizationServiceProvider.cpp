@@ -7,7 +7,10 @@
 #include "GridlyGameSettings.h"
 #include "GridlyLocalizedText.h"
 #include "GridlyLocalizedTextConverter.h"
+#include "GridlyProfiling.h"
 #include "GridlyStyle.h"
+#include "GridlySyncEstimate.h"
+#include "GridlySyncReport.h"
 #include "GridlyTask_DownloadLocalizedTexts.h"
 #include "HttpModule.h"
 #include "ILocalizationServiceModule.h"
@@ -19,9 +22,9 @@
 #include "Internationalization/Culture.h"
 #include "Misc/FeedbackContext.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonSerializer.h"
 #include "Styling/AppStyle.h"
-#include <filesystem>
 
 
 
@@ -50,6 +53,7 @@ public:
 	TSharedPtr<FUICommandInfo> ImportAllCulturesForTargetFromGridly;
 	TSharedPtr<FUICommandInfo> ExportNativeCultureForTargetToGridly;
 	TSharedPtr<FUICommandInfo> ExportTranslationsForTargetToGridly;
+	TSharedPtr<FUICommandInfo> EstimateSyncForTargetWithGridly;
 
 	/** Initialize commands */
 	virtual void RegisterCommands() override;
@@ -64,6 +68,9 @@ void FGridlyLocalizationTargetEditorCommands::RegisterCommands()
 		"Exports native culture and source text of this target to Gridly.", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(ExportTranslationsForTargetToGridly, "Export All to Gridly",
 		"Exports source text and all translations of this target to Gridly.", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(EstimateSyncForTargetWithGridly, "Estimate Sync",
+		"Estimates the requests, payload and duration of importing and exporting this target, without sending any changes to Gridly.",
+		EUserInterfaceActionType::Button, FInputChord());
 }
 
 FGridlyLocalizationServiceProvider::FGridlyLocalizationServiceProvider()
@@ -140,7 +147,30 @@ ELocalizationServiceOperationCommandResult::Type FGridlyLocalizationServiceProvi
 			const FString AbsoluteFilePathAndName = FPaths::ConvertRelativePathToFull(
 				FPaths::ProjectDir() / DownloadOperation->GetInRelativeOutputFilePathAndName());
 
-			bool writeProc = FGridlyLocalizedTextConverter::WritePoFile(PolyglotTextDatas, TargetCulture, AbsoluteFilePathAndName);
+			const double WriteStartTime = FPlatformTime::Seconds();
+			bool writeProc;
+			int32 NumWrittenRecords = PolyglotTextDatas.Num();
+			if (Shard.IsSharded())
+			{
+				const TArray<FPolyglotTextData> ShardPolyglotTextDatas = PolyglotTextDatas.FilterByPredicate(
+					[this](const FPolyglotTextData& PolyglotTextData)
+					{
+						return Shard.Contains(PolyglotTextData.GetNamespace(), PolyglotTextData.GetKey());
+					});
+				writeProc = FGridlyLocalizedTextConverter::WritePoFile(ShardPolyglotTextDatas, TargetCulture, AbsoluteFilePathAndName);
+				NumWrittenRecords = ShardPolyglotTextDatas.Num();
+			}
+			else
+			{
+				writeProc = FGridlyLocalizedTextConverter::WritePoFile(PolyglotTextDatas, TargetCulture, AbsoluteFilePathAndName);
+			}
+
+			if (FGridlySyncReport* Report = FGridlySyncReport::GetActive())
+			{
+				const FString TargetName = FPaths::GetBaseFilename(AbsoluteFilePathAndName);
+				Report->AddStageTime(TargetName, TEXT("write"), FPlatformTime::Seconds() - WriteStartTime);
+				Report->AddRecords(TargetName, TEXT("write"), NumWrittenRecords);
+			}
 			// Callback for successful write
 			InOperationCompleteDelegate.Execute(DownloadOperation, ELocalizationServiceOperationCommandResult::Succeeded);
 			/*
@@ -248,6 +278,14 @@ void FGridlyLocalizationServiceProvider::AddTargetToolbarButtons(FToolBarBuilder
 			FGridlyLocalizationTargetEditorCommands::Get().ExportTranslationsForTargetToGridly, NAME_None,
 			TAttribute<FText>(), TAttribute<FText>(), FSlateIcon(FGridlyStyle::GetStyleSetName(),
 				"Gridly.ExportAllAction"));
+
+		CommandList->MapAction(FGridlyLocalizationTargetEditorCommands::Get().EstimateSyncForTargetWithGridly,
+			FExecuteAction::CreateRaw(this, &FGridlyLocalizationServiceProvider::EstimateSyncForTargetWithGridly,
+				LocalizationTarget, bIsTargetSet));
+		ToolbarBuilder.AddToolBarButton(
+			FGridlyLocalizationTargetEditorCommands::Get().EstimateSyncForTargetWithGridly, NAME_None,
+			TAttribute<FText>(), TAttribute<FText>(), FSlateIcon(FGridlyStyle::GetStyleSetName(),
+				"Gridly.PluginAction"));
 	}
 }
 #endif	  // LOCALIZATION_SERVICES_WITH_SLATE
@@ -375,7 +413,7 @@ void FGridlyLocalizationServiceProvider::OnImportCultureForTargetFromGridly(cons
 	}
 }
 
-TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateExportRequest(const TArray<FPolyglotTextData>& PolyglotTextDatas,
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateExportRequest(TConstArrayView<FPolyglotTextData> PolyglotTextDatas,
 	const TSharedPtr<FLocTextHelper>& LocTextHelperPtr, bool bIncludeTargetTranslations)
 {
 	FString JsonString;
@@ -387,8 +425,9 @@ TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateExportRequest(const TArray<F
 	const FString ViewId = GameSettings->ExportViewId;
 
 	FStringFormatNamedArguments Args;
+	Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
 	Args.Add(TEXT("ViewId"), *ViewId);
-	const FString Url = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/records"), Args);
+	const FString Url = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}/records"), Args);
 
 	auto HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
@@ -428,6 +467,9 @@ void FGridlyLocalizationServiceProvider::ExportNativeCultureForTargetToGridly(
 
 void FGridlyLocalizationServiceProvider::OnExportNativeCultureForTargetToGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::OnExportResponse");
+	FGridlyProfiling::OnRequestCompleted(HttpRequestPtr, HttpResponsePtr);
+
 	UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
 
 	const bool bSyncRecords = GameSettings->bSyncRecords;
@@ -436,18 +478,27 @@ void FGridlyLocalizationServiceProvider::OnExportNativeCultureForTargetToGridly(
 		if (HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok || HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Created)
 		{
 			// Success: process the response and log the result
-			const FString Content = HttpResponsePtr->GetContentAsString();
-			const auto JsonStringReader = TJsonReaderFactory<TCHAR>::Create(Content);
 			TArray<TSharedPtr<FJsonValue>> JsonValueArray;
-			FJsonSerializer::Deserialize(JsonStringReader, JsonValueArray);
+			{
+				FGridlyProfiling::FDecodeScope DecodeScope(HttpRequestPtr);
+				const FString Content = HttpResponsePtr->GetContentAsString();
+				const auto JsonStringReader = TJsonReaderFactory<TCHAR>::Create(Content);
+				FJsonSerializer::Deserialize(JsonStringReader, JsonValueArray);
+			}
 			ExportForTargetEntriesUpdated += JsonValueArray.Num();
 
+			if (FGridlySyncReport* Report = FGridlySyncReport::GetActive())
+			{
+				Report->AddRecords(TEXT("upload"), JsonValueArray.Num());
+			}
+
 			// Continue processing or log success...
 
 			// Check if more requests are pending
 			TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> NextRequest;
 			if (ExportFromTargetRequestQueue.Dequeue(NextRequest))
 			{
+				FGridlyProfiling::OnRequestStarted(*NextRequest);
 				NextRequest->ProcessRequest();
 			}
 			else
@@ -460,7 +511,7 @@ void FGridlyLocalizationServiceProvider::OnExportNativeCultureForTargetToGridly(
 				if (!IsRunningCommandlet())
 				{
 					FString Message = FString::Printf(TEXT("Number of entries updated: %llu"),
-						ExportForTargetEntriesUpdated);  // Include deleted records
+						static_cast<uint64>(ExportForTargetEntriesUpdated));  // Include deleted records
 
 					UE_LOG(LogGridlyEditor, Log, TEXT("%s"), *Message);
 					FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
@@ -531,15 +582,21 @@ void FGridlyLocalizationServiceProvider::ExportTranslationsForTargetToGridly(TWe
 
 void FGridlyLocalizationServiceProvider::OnExportTranslationsForTargetToGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::OnExportResponse");
+	FGridlyProfiling::OnRequestCompleted(HttpRequestPtr, HttpResponsePtr);
+
 	if (bSuccess)
 	{
 		if (HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok || HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Created)
 		{
 			// Success: process the response
-			const FString Content = HttpResponsePtr->GetContentAsString();
-			const auto JsonStringReader = TJsonReaderFactory<TCHAR>::Create(Content);
 			TArray<TSharedPtr<FJsonValue>> JsonValueArray;
-			FJsonSerializer::Deserialize(JsonStringReader, JsonValueArray);
+			{
+				FGridlyProfiling::FDecodeScope DecodeScope(HttpRequestPtr);
+				const FString Content = HttpResponsePtr->GetContentAsString();
+				const auto JsonStringReader = TJsonReaderFactory<TCHAR>::Create(Content);
+				FJsonSerializer::Deserialize(JsonStringReader, JsonValueArray);
+			}
 			ExportForTargetEntriesUpdated += JsonValueArray.Num();
 
 			// Continue processing or log success...
@@ -548,12 +605,13 @@ void FGridlyLocalizationServiceProvider::OnExportTranslationsForTargetToGridly(F
 			TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> NextRequest;
 			if (ExportFromTargetRequestQueue.Dequeue(NextRequest))
 			{
+				FGridlyProfiling::OnRequestStarted(*NextRequest);
 				NextRequest->ProcessRequest();
 			}
 			else
 			{
 				// All export operations completed
-				const FString Message = FString::Printf(TEXT("Number of entries updated: %llu"), ExportForTargetEntriesUpdated);
+				const FString Message = FString::Printf(TEXT("Number of entries updated: %llu"), static_cast<uint64>(ExportForTargetEntriesUpdated));
 				UE_LOG(LogGridlyEditor, Log, TEXT("%s"), *Message);
 
 				if (!IsRunningCommandlet())
@@ -600,6 +658,8 @@ void FGridlyLocalizationServiceProvider::OnExportTranslationsForTargetToGridly(F
 
 void FGridlyLocalizationServiceProvider::ExportForTargetToGridly(ULocalizationTarget* InLocalizationTarget, FHttpRequestCompleteDelegate& ReqDelegate, const FText& SlowTaskText, bool bIncTargetTranslation)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::ExportForTarget");
+
 	TArray<FPolyglotTextData> PolyglotTextDatas;
 	TSharedPtr<FLocTextHelper> LocTextHelperPtr;
 	UERecords.Empty();
@@ -608,29 +668,56 @@ void FGridlyLocalizationServiceProvider::ExportForTargetToGridly(ULocalizationTa
 
 	if (FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(InLocalizationTarget, PolyglotTextDatas, LocTextHelperPtr))
 	{
+		if (Shard.IsSharded())
+		{
+			const int32 NumTexts = PolyglotTextDatas.Num();
+			PolyglotTextDatas.RemoveAll([this](const FPolyglotTextData& PolyglotTextData)
+			{
+				return !Shard.Contains(PolyglotTextData.GetNamespace(), PolyglotTextData.GetKey());
+			});
+			UE_LOG(LogGridlyEditor, Log, TEXT("Exporting %d of %d texts in shard %s"), PolyglotTextDatas.Num(), NumTexts,
+				*Shard.ToString());
+		}
+
 		size_t TotalRequests = 0;
 
-		while (PolyglotTextDatas.Num() > 0)
+		// Chunks are views into the gathered texts, which are neither copied nor shifted down after every request
+		const int32 MaxChunkSize = FMath::Max(1, GetMutableDefault<UGridlyGameSettings>()->ExportMaxRecordsPerRequest);
+		UERecords.Reserve(PolyglotTextDatas.Num());
+
+		for (int32 ChunkStart = 0; ChunkStart < PolyglotTextDatas.Num(); ChunkStart += MaxChunkSize)
 		{
-			const size_t ChunkSize = FMath::Min(GetMutableDefault<UGridlyGameSettings>()->ExportMaxRecordsPerRequest, PolyglotTextDatas.Num());
-			const TArray<FPolyglotTextData> ChunkPolyglotTextDatas(PolyglotTextDatas.GetData(), ChunkSize);
-			PolyglotTextDatas.RemoveAt(0, ChunkSize);
+			const TConstArrayView<FPolyglotTextData> ChunkPolyglotTextDatas =
+				MakeArrayView(PolyglotTextDatas).Slice(ChunkStart, FMath::Min(MaxChunkSize, PolyglotTextDatas.Num() - ChunkStart));
 			const auto HttpRequest = CreateExportRequest(ChunkPolyglotTextDatas, LocTextHelperPtr, bIncTargetTranslation);
-			HttpRequest->OnProcessRequestComplete() = ReqDelegate;
-			ExportFromTargetRequestQueue.Enqueue(HttpRequest);
-			for (int i = 0; i < ChunkPolyglotTextDatas.Num(); i++)
+			if (DryRunEstimate)
 			{
-				const FString& Key = ChunkPolyglotTextDatas[i].GetKey();  // Access the correct array
-				const FString& Namespace = ChunkPolyglotTextDatas[i].GetNamespace();  // Access the correct array
-				
-				UERecords.Add(FGridlyTypeRecord(Key, Namespace));
+				DryRunEstimate->ExportRequests++;
+				DryRunEstimate->ExportRecords += ChunkPolyglotTextDatas.Num();
+				DryRunEstimate->ExportPayloadBytes += HttpRequest->GetContentLength();
 			}
+			else
+			{
+				HttpRequest->OnProcessRequestComplete() = ReqDelegate;
+				ExportFromTargetRequestQueue.Enqueue(HttpRequest);
+				FGridlyProfiling::OnRequestQueued(*HttpRequest);
+			}
+			for (const FPolyglotTextData& PolyglotTextData : ChunkPolyglotTextDatas)
+			{
+				UERecords.Emplace(PolyglotTextData.GetKey(), PolyglotTextData.GetNamespace());
+			}
+			FGridlyProfiling::AddRecords(ChunkPolyglotTextDatas.Num());
 
 			TotalRequests++;
 		}
 
 		ExportForTargetEntriesUpdated = 0;
 
+		if (FGridlySyncReport* Report = FGridlySyncReport::GetActive())
+		{
+			Report->AddRecords(InLocalizationTarget->Settings.Name, TEXT("serialize"), UERecords.Num());
+		}
+
 		TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
 		if (ExportFromTargetRequestQueue.Dequeue(HttpRequest))
 		{
@@ -641,14 +728,31 @@ void FGridlyLocalizationServiceProvider::ExportForTargetToGridly(ULocalizationTa
 			}
 
 			bExportRequestInProgress = true;
+			FGridlyProfiling::OnRequestStarted(*HttpRequest);
 			HttpRequest->ProcessRequest();
 		}
 	}
+
+	if (DryRunEstimate)
+	{
+		// The records a sync would delete are found the same way as after an upload, from a fetch of the view that changes nothing
+
+		DryRunTargetName = InLocalizationTarget->Settings.Name;
+		if (bIncTargetTranslation || GetMutableDefault<UGridlyGameSettings>()->bSyncRecords)
+		{
+			bDryRunRequestInProgress = true;
+			FetchGridlyCSV();
+		}
+		else
+		{
+			FinishDryRun();
+		}
+	}
 }
 
 bool FGridlyLocalizationServiceProvider::HasRequestsPending() const
 {
-	return !ExportFromTargetRequestQueue.IsEmpty() || bExportRequestInProgress;
+	return !ExportFromTargetRequestQueue.IsEmpty() || bExportRequestInProgress || bDryRunRequestInProgress;
 }
 
 FHttpRequestCompleteDelegate FGridlyLocalizationServiceProvider::CreateExportNativeCultureDelegate()
@@ -663,8 +767,9 @@ void FGridlyLocalizationServiceProvider::FetchGridlyCSV()
 	const FString ViewId = GameSettings->ExportViewId;
 	// URL for fetching the CSV from Gridly
 	FStringFormatNamedArguments Args;
+	Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
 	Args.Add(TEXT("ViewId"), *ViewId);
-	const FString GridlyURL = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/export"), Args);
+	const FString GridlyURL = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}/export"), Args);
 
 	// Create the HTTP request
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
@@ -679,27 +784,52 @@ void FGridlyLocalizationServiceProvider::FetchGridlyCSV()
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &FGridlyLocalizationServiceProvider::OnGridlyCSVResponseReceived);
 
 	// Send the request
+	FGridlyProfiling::OnRequestStarted(*HttpRequest);
 	HttpRequest->ProcessRequest();
 }
 
 void FGridlyLocalizationServiceProvider::OnGridlyCSVResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::OnCSVResponse");
+	FGridlyProfiling::OnRequestCompleted(Request, Response);
+
+	const bool bIsDryRun = bDryRunRequestInProgress;
+	bDryRunRequestInProgress = false;
+
 	if (!bWasSuccessful || !Response.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to fetch Gridly CSV"));
+		if (bIsDryRun)
+		{
+			FinishDryRun();
+		}
 		return;
 	}
 
-	// Retrieve the response content (CSV data)
-	FString CSVContent = Response->GetContentAsString();
+	// Parsing and diffing the records counts as decoding the response
+	{
+		FGridlyProfiling::FDecodeScope DecodeScope(Request);
+
+		// Retrieve the response content (CSV data)
+		FString CSVContent = Response->GetContentAsString();
 
-	// Parse the CSV data to extract records
-	ParseCSVAndCreateRecords(CSVContent);
+		// Parse the CSV data to extract records
+		ParseCSVAndCreateRecords(CSVContent);
+	}
+
+	if (bIsDryRun)
+	{
+		FinishDryRun();
+	}
 }
 
 
 void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString& CSVContent)
 {
+	GRIDLY_TRACE_SCOPE("Gridly::ParseCSV");
+	SCOPE_CYCLE_COUNTER(STAT_GridlyDiffRecords);
+	GRIDLY_ALLOCATION_SCOPE(DiffRecords);
+
 	const TCHAR QuoteChar = TEXT('"');
 	const TCHAR Delimiter = TEXT(',');
 
@@ -748,7 +878,7 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 			else if (Char == Delimiter)
 			{
 				Fields.Add(CurrentField);
-				CurrentField.Empty();
+				CurrentField.Reset();
 			}
 			else if (Char == '\n' || Char == '\r')
 			{
@@ -756,7 +886,7 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 				if (Fields.Num() > 0 || !CurrentField.IsEmpty())
 				{
 					Fields.Add(CurrentField);
-					CurrentField.Empty();
+					CurrentField.Reset();
 				}
 
 				if (!bFoundHeader)
@@ -776,7 +906,10 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 					}
 
 					bFoundHeader = true;
-					Fields.Empty();
+					Fields.Reset();
+
+					// Only the header is needed from this pass
+					break;
 				}
 			}
 			else
@@ -795,8 +928,8 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 
 	// Second pass: parse the actual records
 	bInsideQuotes = false;
-	Fields.Empty();
-	CurrentField.Empty();
+	Fields.Reset();
+	CurrentField.Reset();
 	for (int32 i = 0; i < CSVContent.Len(); ++i)
 	{
 		TCHAR Char = CSVContent[i];
@@ -829,30 +962,31 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 			else if (Char == Delimiter)
 			{
 				Fields.Add(CurrentField);
-				CurrentField.Empty();
+				CurrentField.Reset();
 			}
 			else if (Char == '\n' || Char == '\r')
 			{
 				if (Fields.Num() > 0 || !CurrentField.IsEmpty())
 				{
 					Fields.Add(CurrentField);
-					CurrentField.Empty();
+					CurrentField.Reset();
 				}
 
 				if (Fields.Num() > FMath::Max(RecordIdColumnIndex, PathColumnIndex))
 				{
-					FString RecordId = Fields[RecordIdColumnIndex].TrimQuotes();
-					FString Path = Fields[PathColumnIndex].TrimQuotes();
-
+					FString RecordId = MoveTemp(Fields[RecordIdColumnIndex]);
+					FString Path = MoveTemp(Fields[PathColumnIndex]);
+					RecordId.TrimQuotesInline();
+					Path.TrimQuotesInline();
 
-					FGridlyTypeRecord NewRecord(RemoveNamespaceFromKey(RecordId), Path);
+					FGridlyTypeRecord NewRecord(RemoveNamespaceFromKey(RecordId), MoveTemp(Path));
 
 					if (NewRecord.Id != "Record ID") {
-						GridlyRecords.Add(NewRecord);
+						GridlyRecords.Add(MoveTemp(NewRecord));
 					}
 				}
 
-				Fields.Empty();
+				Fields.Reset();
 			}
 			else
 			{
@@ -867,32 +1001,45 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 		Fields.Add(CurrentField);
 		if (Fields.Num() > FMath::Max(RecordIdColumnIndex, PathColumnIndex))
 		{
-			FString RecordId = Fields[RecordIdColumnIndex].TrimQuotes();
-			FString Path = Fields[PathColumnIndex].TrimQuotes();
-
+			FString RecordId = MoveTemp(Fields[RecordIdColumnIndex]);
+			FString Path = MoveTemp(Fields[PathColumnIndex]);
+			RecordId.TrimQuotesInline();
+			Path.TrimQuotesInline();
 
-			FGridlyTypeRecord NewRecord(RemoveNamespaceFromKey(RecordId), Path);
+			FGridlyTypeRecord NewRecord(RemoveNamespaceFromKey(RecordId), MoveTemp(Path));
 
 			if (NewRecord.Id != "Record ID") {
-				GridlyRecords.Add(NewRecord);
+				GridlyRecords.Add(MoveTemp(NewRecord));
 			}
 		}
 	}
 
-	for (const FGridlyTypeRecord& Record : UERecords)
+	// Records of other shards are left to the machines that export them, since their texts are not in UERecords
+
+	if (Shard.IsSharded())
 	{
-		UE_LOG(LogTemp, Log, TEXT("UE Record ID: %s, Path: %s"), *Record.Id, *Record.Path);
+		GridlyRecords.RemoveAll([this](const FGridlyTypeRecord& Record)
+		{
+			return !Shard.Contains(Record.Path, Record.Id);
+		});
 	}
-	
 
-	// Log or further process the GridlyRecords array
-	for (const FGridlyTypeRecord& Record : GridlyRecords)
+	if (UE_LOG_ACTIVE(LogGridlyLocalizationServiceProvider, Verbose))
 	{
-		UE_LOG(LogTemp, Log, TEXT("Gridly Record ID: %s, Path: %s"), *Record.Id, *Record.Path);
+		for (const FGridlyTypeRecord& Record : UERecords)
+		{
+			UE_LOG(LogGridlyLocalizationServiceProvider, Verbose, TEXT("UE Record ID: %s, Path: %s"), *Record.Id, *Record.Path);
+		}
+
+		for (const FGridlyTypeRecord& Record : GridlyRecords)
+		{
+			UE_LOG(LogGridlyLocalizationServiceProvider, Verbose, TEXT("Gridly Record ID: %s, Path: %s"), *Record.Id, *Record.Path);
+		}
 	}
 
 	TArray<FString> RecordsToDelete;
-	
+
+	GRIDLY_TRACE_SCOPE("Gridly::DiffRecords");
 
 	for (const FGridlyTypeRecord& GridlyRecord : GridlyRecords)
 	{
@@ -916,7 +1063,7 @@ void FGridlyLocalizationServiceProvider::ParseCSVAndCreateRecords(const FString&
 		// Only handle deletion if the path was found, but the ID was not found for that path
 		if (PathFoundInUE && !RecordIdFoundInUE)
 		{
-			UE_LOG(LogGridlyLocalizationServiceProvider, Log, TEXT("No match found for GridlyRecord: ID = %s, Path = %s. Adding to delete list."), *GridlyRecord.Id, *GridlyRecord.Path);
+			UE_LOG(LogGridlyLocalizationServiceProvider, Verbose, TEXT("No match found for GridlyRecord: ID = %s, Path = %s. Adding to delete list."), *GridlyRecord.Id, *GridlyRecord.Path);
 
 			// If the path is empty, we only add the record ID
 			if (GridlyRecord.Path.Len() == 0)
@@ -969,43 +1116,44 @@ void FGridlyLocalizationServiceProvider::DeleteRecordsFromGridly(const TArray<FS
 
 	for (int32 BatchIndex = 0; BatchIndex < TotalBatches; BatchIndex++)
 	{
-		// Create a new array for each batch
-		TArray<FString> BatchRecords;
-
-		int32 StartIndex = BatchIndex * MaxRecordsPerRequest;
-		int32 EndIndex = FMath::Min(StartIndex + MaxRecordsPerRequest, TotalRecords); // Ensure not to exceed total records
-
-		// Manually append the batch records
-		for (int32 i = StartIndex; i < EndIndex; ++i)
-		{
-			BatchRecords.Add(RecordsToDelete[i]);
-		}
+		// Each batch is a view into the records to delete
+		const int32 StartIndex = BatchIndex * MaxRecordsPerRequest;
+		const TConstArrayView<FString> BatchRecords =
+			MakeArrayView(RecordsToDelete).Slice(StartIndex, FMath::Min(MaxRecordsPerRequest, TotalRecords - StartIndex));
 
 		// Convert the batch to JSON and send the request
 		FString JsonPayload;
-		TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-		TArray<TSharedPtr<FJsonValue>> JsonIds;
-
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonPayload);
+		Writer->WriteObjectStart();
+		Writer->WriteArrayStart(TEXT("ids"));
 		for (const FString& RecordId : BatchRecords)
 		{
-			JsonIds.Add(MakeShared<FJsonValueString>(RecordId));
+			Writer->WriteValue(RecordId);
 		}
-
-		JsonObject->SetArrayField(TEXT("ids"), JsonIds);
-
-		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
 
 		// Log the JSON payload for debugging
 		UE_LOG(LogGridlyLocalizationServiceProvider, Log, TEXT("JSON Payload: %s"), *JsonPayload);
 
+		if (DryRunEstimate)
+		{
+			DryRunEstimate->DeleteRequests++;
+			DryRunEstimate->DeleteRecords += BatchRecords.Num();
+			DryRunEstimate->DeletePayloadBytes += FTCHARToUTF8(*JsonPayload).Length();
+			continue;
+		}
+
 		const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
 		const FString ApiKey = GameSettings->ExportApiKey;
 		const FString ViewId = GameSettings->ExportViewId;
 
 		FStringFormatNamedArguments Args;
+		Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
 		Args.Add(TEXT("ViewId"), *ViewId);
-		const FString Url = FString::Format(TEXT("https://api.gridly.com/v1/views/{ViewId}/records"), Args);
+		const FString Url = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}/records"), Args);
 
 		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 		HttpRequest->SetVerb(TEXT("DELETE"));
@@ -1017,17 +1165,25 @@ void FGridlyLocalizationServiceProvider::DeleteRecordsFromGridly(const TArray<FS
 		// Bind the response handler for each batch
 		HttpRequest->OnProcessRequestComplete().BindRaw(this, &FGridlyLocalizationServiceProvider::OnDeleteRecordsResponse);
 
+		FGridlyProfiling::OnRequestStarted(*HttpRequest);
 		HttpRequest->ProcessRequest();
 
 		// Track the number of records requested for deletion
 		ExportForTargetEntriesDeleted += BatchRecords.Num();
 
+		if (FGridlySyncReport* Report = FGridlySyncReport::GetActive())
+		{
+			Report->AddRecords(TEXT("sync-delete"), BatchRecords.Num());
+		}
+
 		UE_LOG(LogGridlyLocalizationServiceProvider, Log, TEXT("Delete request sent for %d records."), BatchRecords.Num());
 	}
 }
 
 void FGridlyLocalizationServiceProvider::OnDeleteRecordsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
+	FGridlyProfiling::OnRequestCompleted(Request, Response);
+
 	if (!Request.IsValid() || !Response.IsValid())
 	{
 		UE_LOG(LogGridlyLocalizationServiceProvider, Error, TEXT("Invalid HTTP request or response."));
@@ -1046,7 +1202,7 @@ void FGridlyLocalizationServiceProvider::OnDeleteRecordsResponse(FHttpRequestPtr
 		if (CompletedBatches == TotalBatchesToProcess && !IsRunningCommandlet())
 		{
 			// Prepare and show a success message dialog
-			FString Message = FString::Printf(TEXT("Number of entries deleted: %llu"), ExportForTargetEntriesDeleted);
+			FString Message = FString::Printf(TEXT("Number of entries deleted: %llu"), static_cast<uint64>(ExportForTargetEntriesDeleted));
 
 			UE_LOG(LogGridlyEditor, Log, TEXT("%s"), *Message);
 			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
@@ -1073,6 +1229,72 @@ void FGridlyLocalizationServiceProvider::OnDeleteRecordsResponse(FHttpRequestPtr
 
 
 
+void FGridlyLocalizationServiceProvider::EstimateSyncForTargetWithGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget,
+	bool bIsTargetSet)
+{
+	check(LocalizationTarget.IsValid());
+
+	if (bIsTargetSet)
+	{
+		return;
+	}
+
+	if (HasRequestsPending())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("GridlySyncInProgress", "A sync with Gridly is already in progress."));
+		return;
+	}
+
+	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	const int32 RecordsPerRequest = GameSettings->ImportMaxRecordsPerRequest;
+
+	TArray<FString> ViewIds;
+	for (const FString& ViewId : GameSettings->ImportFromViewIds)
+	{
+		if (!ViewId.IsEmpty())
+		{
+			ViewIds.Add(ViewId);
+		}
+	}
+
+	// Every culture but the native one downloads all import views
+
+	const FLocalizationTargetSettings& TargetSettings = LocalizationTarget->Settings;
+	const int32 NumCultures = TargetSettings.SupportedCulturesStatistics.Num() -
+		(TargetSettings.SupportedCulturesStatistics.IsValidIndex(TargetSettings.NativeCultureIndex) ? 1 : 0);
+
+	bDryRunRequestInProgress = true;
+	FGridlySyncEstimate::RequestRecordCounts(ViewIds, GameSettings->ImportApiKey,
+		[this, LocalizationTarget, RecordsPerRequest, NumCultures](const TArray<int32>& RecordCounts)
+		{
+			bDryRunRequestInProgress = false;
+
+			if (LocalizationTarget.IsValid())
+			{
+				const TSharedRef<FGridlySyncEstimate> Estimate = MakeShared<FGridlySyncEstimate>();
+				Estimate->AddImport(RecordCounts, RecordsPerRequest, NumCultures);
+				SetDryRunEstimate(Estimate);
+
+				FHttpRequestCompleteDelegate ReqDelegate;
+				ExportForTargetToGridly(LocalizationTarget.Get(), ReqDelegate, FText::GetEmpty());
+			}
+		});
+}
+
+void FGridlyLocalizationServiceProvider::FinishDryRun()
+{
+	// The commandlet reports the estimates of all targets once it is done
+
+	if (!IsRunningCommandlet())
+	{
+		const FString Message = FString::Printf(TEXT("Estimated sync of %s:\n%s"), *DryRunTargetName, *DryRunEstimate->ToString());
+		UE_LOG(LogGridlyEditor, Log, TEXT("%s"), *Message);
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+	}
+
+	DryRunEstimate.Reset();
+}
+
 FString FGridlyLocalizationServiceProvider::RemoveNamespaceFromKey(FString& InputString)
 {
 
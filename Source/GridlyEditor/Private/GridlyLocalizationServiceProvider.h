@@ -7,15 +7,15 @@
 #include "ILocalizationServiceOperation.h"
 #include "ILocalizationServiceProvider.h"
 #include "ILocalizationServiceState.h"
+#include "GridlyShard.h"
 #include "Interfaces/IHttpRequest.h"
-#include <string>
-#include <fstream>
-#include <iostream>
 
+struct FGridlySyncEstimate;
 
 class FGridlyLocalizationServiceProvider final : public ILocalizationServiceProvider
 {
-
+	/** Runs the record diff on synthetic records */
+	friend class FGridlyBenchmark;
 
 	class FGridlyTypeRecord
 	{
@@ -23,8 +23,8 @@ class FGridlyLocalizationServiceProvider final : public ILocalizationServiceProv
 		FString Id;
 		FString Path;
 
-		FGridlyTypeRecord(const FString& InId, const FString& InPath)
-			: Id(InId), Path(InPath)
+		FGridlyTypeRecord(FString InId, FString InPath)
+			: Id(MoveTemp(InId)), Path(MoveTemp(InPath))
 		{}
 	};
 public:
@@ -73,6 +73,12 @@ public:
 
 	void ExportForTargetToGridly(ULocalizationTarget* LocalizationTarget, FHttpRequestCompleteDelegate& ReqDelegate, const FText& SlowTaskText, bool bIncTargetTranslation = false);
 
+	/** While set, the next export only fills in the estimate: nothing is uploaded, and records to delete are found with a read-only fetch */
+	void SetDryRunEstimate(const TSharedPtr<FGridlySyncEstimate>& InEstimate) { DryRunEstimate = InEstimate; }
+
+	/** Limits downloads, uploads and deletions to the texts of one shard */
+	void SetShard(const FGridlyShard& InShard) { Shard = InShard; }
+
 	// New functions for fetching and parsing CSV from Gridly
 	void FetchGridlyCSV(); // Fetches the CSV data from Gridly
 	void OnGridlyCSVResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful); // Callback for when the CSV is received
@@ -80,7 +86,6 @@ public:
 
 private:
 	// Import
-	bool IsFileNotEmpty(const std::string& filePath);
 	void ImportAllCulturesForTargetFromGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet);
 	void OnImportCultureForTargetFromGridly(const FLocalizationServiceOperationRef& Operation,
 		ELocalizationServiceOperationCommandResult::Type Result, bool bIsTargetSet);
@@ -105,8 +110,18 @@ private:
 	void ExportTranslationsForTargetToGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet);
 	void OnExportTranslationsForTargetToGridly(FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr, bool bSuccess);
 
+	// Dry run
+
+	void EstimateSyncForTargetWithGridly(TWeakObjectPtr<ULocalizationTarget> LocalizationTarget, bool bIsTargetSet);
+	void FinishDryRun();
+
+	TSharedPtr<FGridlySyncEstimate> DryRunEstimate;
+	FString DryRunTargetName;
+	bool bDryRunRequestInProgress = false;
+
 	TArray<FGridlyTypeRecord> GridlyRecords; // List to store the records from Gridly
 	TArray<FGridlyTypeRecord> UERecords;
+	FGridlyShard Shard;
 	FString RemoveNamespaceFromKey(FString& InputString);
 	
 	void DeleteRecordsFromGridly(const TArray<FString>& RecordsToDelete);
@@ -5,6 +5,7 @@
 
 #include "GridlyCultureConverter.h"
 #include "GridlyEditor.h"
+#include "GridlyProfiling.h"
 #include "LocalizationConfigurationScript.h"
 #include "LocTextHelper.h"
 #include "Internationalization/PolyglotTextData.h"
@@ -17,7 +18,7 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 
 	// Get native culture.
 	const int NativeCultureIndex = LocalizationTarget->Settings.NativeCultureIndex;
-	FString NativeCulture = LocalizationTarget->Settings.SupportedCulturesStatistics[NativeCultureIndex].CultureName;
+	const FString NativeCulture = LocalizationTarget->Settings.SupportedCulturesStatistics[NativeCultureIndex].CultureName;
 
 	// Get source path.
 	FString SourcePath;
@@ -67,7 +68,15 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 		DestinationPath = FPaths::Combine(*FPaths::ProjectDir(), *DestinationPath);
 	}
 
-	const TArray<FString> CulturesToGenerate = FGridlyCultureConverter::GetTargetCultures();
+	return GetAllTextAsPolyglotTextDatas(SourcePath, ManifestName, ArchiveName, NativeCulture,
+		FGridlyCultureConverter::GetTargetCultures(), OutPolyglotTextDatas, LocTextHelper);
+}
+
+bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(const FString& SourcePath, const FString& ManifestName,
+	const FString& ArchiveName, const FString& NativeCulture, const TArray<FString>& CulturesToGenerate,
+	TArray<FPolyglotTextData>& OutPolyglotTextDatas, TSharedPtr<FLocTextHelper>& LocTextHelper)
+{
+	GRIDLY_TRACE_SCOPE("Gridly::GatherTexts");
 
 	// Load the manifest and all archives
 	LocTextHelper = MakeShareable(new FLocTextHelper(SourcePath, ManifestName, ArchiveName, NativeCulture, CulturesToGenerate, nullptr));
@@ -124,22 +133,28 @@ bool FGridlyLocalizedText::GetAllTextAsPolyglotTextDatas(ULocalizationTarget* Lo
 
 
 
+	// Translations are matched to the first text with the same key
+	TMap<FString, int32> TextIndicesByKey;
+	TextIndicesByKey.Reserve(OutPolyglotTextDatas.Num());
+	for (int32 i = 0; i < OutPolyglotTextDatas.Num(); i++)
+	{
+		if (!TextIndicesByKey.Contains(OutPolyglotTextDatas[i].GetKey()))
+		{
+			TextIndicesByKey.Add(OutPolyglotTextDatas[i].GetKey(), i);
+		}
+	}
+
 	for (int i = 0; i < CulturesToGenerate.Num(); i++)
 	{
 		const FString CultureName = CulturesToGenerate[i];
 		if (CultureName != NativeCulture)
 		{
 			LocTextHelper->EnumerateTranslations(CultureName,
-				[&CultureName, &OutPolyglotTextDatas](TSharedRef<FArchiveEntry> InManifestEntry)
+				[&CultureName, &OutPolyglotTextDatas, &TextIndicesByKey](TSharedRef<FArchiveEntry> InManifestEntry)
 				{
-					FPolyglotTextData* PolyglotTextData = OutPolyglotTextDatas.FindByPredicate(
-						[&InManifestEntry](const FPolyglotTextData& PolyglotTextData)
-						{
-							return PolyglotTextData.GetKey() == InManifestEntry->Key.GetString();
-						});
-					if (PolyglotTextData)
+					if (const int32* TextIndex = TextIndicesByKey.Find(InManifestEntry->Key.GetString()))
 					{
-						PolyglotTextData->AddLocalizedString(CultureName, InManifestEntry->Translation.Text);
+						OutPolyglotTextDatas[*TextIndex].AddLocalizedString(CultureName, InManifestEntry->Translation.Text);
 					}
 					return true;
 				}, true);
@@ -12,4 +12,9 @@ class FGridlyLocalizedText
 public:
 	static bool GetAllTextAsPolyglotTextDatas(ULocalizationTarget* LocalizationTarget,
 		TArray<FPolyglotTextData>& OutPolyglotTextDatas, TSharedPtr<FLocTextHelper>& LocTextHelper);
+
+	/** Reads the texts of the manifest and archives under SourcePath, which need not belong to a localization target */
+	static bool GetAllTextAsPolyglotTextDatas(const FString& SourcePath, const FString& ManifestName, const FString& ArchiveName,
+		const FString& NativeCulture, const TArray<FString>& CulturesToGenerate, TArray<FPolyglotTextData>& OutPolyglotTextDatas,
+		TSharedPtr<FLocTextHelper>& LocTextHelper);
 };
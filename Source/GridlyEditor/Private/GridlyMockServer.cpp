@@ -0,0 +1,424 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyMockServer.h"
+
+#include "GridlyEditor.h"
+#include "GridlySyntheticData.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "JsonObjectConverter.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace GridlyMockServer
+{
+	static const TCHAR* const ViewsPath = TEXT("/v1/views");
+
+	/** HTTP status that the Gridly API answers with when the rate limit of the API key is exceeded */
+	static const int32 TooManyRequestsCode = 429;
+
+	static FString GetBodyAsString(const FHttpServerRequest& Request)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	static FString MakeMessageJson(const FString& Message)
+	{
+		return FString::Printf(TEXT("{\"message\":\"%s\"}"), *Message.ReplaceCharWithEscapedChar());
+	}
+}
+
+void FGridlyMockServer::FView::Reindex()
+{
+	RecordIndices.Reset();
+	RecordIndices.Reserve(Records.Num());
+
+	for (int32 i = 0; i < Records.Num(); i++)
+	{
+		RecordIndices.Add(Records[i].Id, i);
+	}
+}
+
+FGridlyMockServer::FGridlyMockServer(const FGridlyMockServerOptions& InOptions)
+	: Options(InOptions)
+	, Random(InOptions.Seed)
+{
+}
+
+FGridlyMockServer::~FGridlyMockServer()
+{
+	Stop();
+}
+
+bool FGridlyMockServer::Start()
+{
+	if (IsRunning())
+	{
+		return true;
+	}
+
+	FHttpServerModule& HttpServerModule = FHttpServerModule::Get();
+
+	Router = HttpServerModule.GetHttpRouter(Options.Port, true);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogGridlyEditor, Error, TEXT("Failed to start the Gridly mock server on port %u"), Options.Port);
+		return false;
+	}
+
+	// One route for all views, the view ID and endpoint are read from the rest of the path
+
+	RouteHandle = Router->BindRoute(FHttpPath(GridlyMockServer::ViewsPath),
+		EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST | EHttpServerRequestVerbs::VERB_PATCH
+		| EHttpServerRequestVerbs::VERB_DELETE,
+		FHttpRequestHandler::CreateRaw(this, &FGridlyMockServer::HandleRequest));
+
+	if (!RouteHandle.IsValid())
+	{
+		UE_LOG(LogGridlyEditor, Error, TEXT("Failed to bind the Gridly mock server route on port %u"), Options.Port);
+		Router.Reset();
+		return false;
+	}
+
+	HttpServerModule.StartAllListeners();
+
+	UE_LOG(LogGridlyEditor, Display, TEXT("Gridly mock server listening on %s"), *GetBaseUrl());
+	return true;
+}
+
+void FGridlyMockServer::Stop()
+{
+	for (const TPair<int64, FTSTicker::FDelegateHandle>& PendingResponse : PendingResponses)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingResponse.Value);
+	}
+	PendingResponses.Reset();
+
+	if (Router.IsValid() && RouteHandle.IsValid())
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+
+	RouteHandle.Reset();
+	Router.Reset();
+}
+
+FString FGridlyMockServer::GetBaseUrl() const
+{
+	return FString::Printf(TEXT("http://localhost:%u"), Options.Port);
+}
+
+void FGridlyMockServer::SetViewRecords(const FString& ViewId, TArray<FGridlyTableRow> Records)
+{
+	FView& View = Views.FindOrAdd(ViewId);
+	View.Records = MoveTemp(Records);
+	View.Reindex();
+}
+
+const TArray<FGridlyTableRow>* FGridlyMockServer::GetViewRecords(const FString& ViewId) const
+{
+	const FView* View = Views.Find(ViewId);
+	return View ? &View->Records : nullptr;
+}
+
+bool FGridlyMockServer::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	NumRequests++;
+
+	const FString Body = GridlyMockServer::GetBodyAsString(Request);
+
+	if (ShouldRejectRequest())
+	{
+		NumTooManyRequests++;
+
+		TUniquePtr<FHttpServerResponse> Response =
+			MakeJsonResponse(GridlyMockServer::MakeMessageJson(TEXT("Too many requests")), GridlyMockServer::TooManyRequestsCode);
+		Response->Headers.Add(TEXT("Retry-After"), { TEXT("1") });
+		Respond(MoveTemp(Response), Request.Body.Num(), OnComplete);
+		return true;
+	}
+
+	// Paths are /v1/views/{viewId}, /v1/views/{viewId}/records and /v1/views/{viewId}/export. The router already made the
+	// path relative to the route
+
+	TArray<FString> Segments;
+	Request.RelativePath.GetPath().ParseIntoArray(Segments, TEXT("/"));
+
+	TUniquePtr<FHttpServerResponse> Response;
+
+	if (Segments.Num() == 1 && Request.Verb == EHttpServerRequestVerbs::VERB_GET)
+	{
+		Response = GetView(Segments[0]);
+	}
+	else if (Segments.Num() == 2 && Segments[1] == TEXT("records"))
+	{
+		switch (Request.Verb)
+		{
+		case EHttpServerRequestVerbs::VERB_GET:
+			Response = ListRecords(Segments[0], Request);
+			break;
+		case EHttpServerRequestVerbs::VERB_POST:
+		case EHttpServerRequestVerbs::VERB_PATCH:
+			Response = UpsertRecords(Segments[0], Body);
+			break;
+		case EHttpServerRequestVerbs::VERB_DELETE:
+			Response = DeleteRecords(Segments[0], Body);
+			break;
+		default:
+			break;
+		}
+	}
+	else if (Segments.Num() == 2 && Segments[1] == TEXT("export") && Request.Verb == EHttpServerRequestVerbs::VERB_GET)
+	{
+		Response = ExportView(Segments[0]);
+	}
+
+	if (!Response)
+	{
+		Response = MakeJsonResponse(GridlyMockServer::MakeMessageJson(TEXT("Not found")),
+			static_cast<int32>(EHttpServerResponseCodes::NotFound));
+	}
+
+	Respond(MoveTemp(Response), Request.Body.Num(), OnComplete);
+	return true;
+}
+
+TUniquePtr<FHttpServerResponse> FGridlyMockServer::GetView(const FString& ViewId) const
+{
+	const FView* View = Views.Find(ViewId);
+	if (!View)
+	{
+		return nullptr;
+	}
+
+	TArray<FString> ColumnIds;
+	for (const FGridlyTableRow& Record : View->Records)
+	{
+		for (const FGridlyTableCell& Cell : Record.Cells)
+		{
+			ColumnIds.AddUnique(Cell.ColumnId);
+		}
+	}
+
+	const TSharedRef<FJsonObject> ViewObject = MakeShared<FJsonObject>();
+	ViewObject->SetStringField(TEXT("id"), ViewId);
+	ViewObject->SetStringField(TEXT("name"), ViewId);
+
+	TArray<TSharedPtr<FJsonValue>> ColumnValues;
+	for (const FString& ColumnId : ColumnIds)
+	{
+		const TSharedRef<FJsonObject> ColumnObject = MakeShared<FJsonObject>();
+		ColumnObject->SetStringField(TEXT("id"), ColumnId);
+		ColumnObject->SetStringField(TEXT("name"), ColumnId);
+		ColumnValues.Add(MakeShared<FJsonValueObject>(ColumnObject));
+	}
+	ViewObject->SetArrayField(TEXT("columns"), ColumnValues);
+
+	FString Json;
+	FJsonSerializer::Serialize(ViewObject, TJsonWriterFactory<>::Create(&Json));
+	return MakeJsonResponse(Json, static_cast<int32>(EHttpServerResponseCodes::Ok));
+}
+
+TUniquePtr<FHttpServerResponse> FGridlyMockServer::ListRecords(const FString& ViewId, const FHttpServerRequest& Request) const
+{
+	const FView* View = Views.Find(ViewId);
+	if (!View)
+	{
+		return nullptr;
+	}
+
+	// Pagination is a JSON object in the page query parameter, e.g. page={"offset":0,"limit":1000}
+
+	int32 Offset = 0;
+	int32 Limit = Options.MaxPageSize;
+
+	if (const FString* PageParam = Request.QueryParams.Find(TEXT("page")))
+	{
+		TSharedPtr<FJsonObject> PageObject;
+		if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FGenericPlatformHttp::UrlDecode(*PageParam)), PageObject)
+			&& PageObject.IsValid())
+		{
+			PageObject->TryGetNumberField(TEXT("offset"), Offset);
+			PageObject->TryGetNumberField(TEXT("limit"), Limit);
+		}
+	}
+
+	Offset = FMath::Clamp(Offset, 0, View->Records.Num());
+	Limit = FMath::Clamp(Limit, 0, FMath::Max(1, Options.MaxPageSize));
+
+	TUniquePtr<FHttpServerResponse> Response = MakeJsonResponse(
+		FGridlySyntheticData::WriteRecordsJson(View->Records, Offset, Limit), static_cast<int32>(EHttpServerResponseCodes::Ok));
+	Response->Headers.Add(TEXT("X-Total-Count"), { FString::FromInt(View->Records.Num()) });
+	return Response;
+}
+
+TUniquePtr<FHttpServerResponse> FGridlyMockServer::UpsertRecords(const FString& ViewId, const FString& Body)
+{
+	TArray<FGridlyTableRow> Records;
+	if (!FJsonObjectConverter::JsonArrayStringToUStruct(Body, &Records, 0, 0))
+	{
+		return MakeJsonResponse(GridlyMockServer::MakeMessageJson(TEXT("Invalid records")),
+			static_cast<int32>(EHttpServerResponseCodes::BadRequest));
+	}
+
+	// Existing records keep the cells that the request does not send, like records updated on Gridly
+
+	FView& View = Views.FindOrAdd(ViewId);
+
+	for (FGridlyTableRow& Record : Records)
+	{
+		if (const int32* RecordIndex = View.RecordIndices.Find(Record.Id))
+		{
+			FGridlyTableRow& ExistingRecord = View.Records[*RecordIndex];
+			if (!Record.Path.IsEmpty())
+			{
+				ExistingRecord.Path = MoveTemp(Record.Path);
+			}
+
+			for (FGridlyTableCell& Cell : Record.Cells)
+			{
+				FGridlyTableCell* ExistingCell = ExistingRecord.Cells.FindByPredicate([&Cell](const FGridlyTableCell& Other)
+				{
+					return Other.ColumnId == Cell.ColumnId;
+				});
+
+				if (ExistingCell)
+				{
+					ExistingCell->Value = MoveTemp(Cell.Value);
+				}
+				else
+				{
+					ExistingRecord.Cells.Add(MoveTemp(Cell));
+				}
+			}
+		}
+		else
+		{
+			View.RecordIndices.Add(Record.Id, View.Records.Num());
+			View.Records.Add(MoveTemp(Record));
+		}
+	}
+
+	return MakeJsonResponse(TEXT("[]"), static_cast<int32>(EHttpServerResponseCodes::Created));
+}
+
+TUniquePtr<FHttpServerResponse> FGridlyMockServer::DeleteRecords(const FString& ViewId, const FString& Body)
+{
+	FView* View = Views.Find(ViewId);
+	if (!View)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> BodyObject;
+	const TArray<TSharedPtr<FJsonValue>>* IdValues = nullptr;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Body), BodyObject) || !BodyObject.IsValid()
+		|| !BodyObject->TryGetArrayField(TEXT("ids"), IdValues))
+	{
+		return MakeJsonResponse(GridlyMockServer::MakeMessageJson(TEXT("Invalid record IDs")),
+			static_cast<int32>(EHttpServerResponseCodes::BadRequest));
+	}
+
+	// The provider sends the IDs of records with a path as "{path},{id}"
+
+	TSet<FString> Ids;
+	for (const TSharedPtr<FJsonValue>& IdValue : *IdValues)
+	{
+		Ids.Add(IdValue->AsString());
+	}
+
+	const int32 NumRemoved = View->Records.RemoveAll([&Ids](const FGridlyTableRow& Record)
+	{
+		return Ids.Contains(Record.Id) || Ids.Contains(Record.Path + TEXT(",") + Record.Id);
+	});
+
+	if (NumRemoved > 0)
+	{
+		View->Reindex();
+	}
+
+	return MakeJsonResponse(FString(), static_cast<int32>(EHttpServerResponseCodes::NoContent));
+}
+
+TUniquePtr<FHttpServerResponse> FGridlyMockServer::ExportView(const FString& ViewId) const
+{
+	const FView* View = Views.Find(ViewId);
+	if (!View)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(FGridlySyntheticData::WriteCSV(View->Records),
+		TEXT("text/csv"));
+	Response->Code = EHttpServerResponseCodes::Ok;
+	return Response;
+}
+
+bool FGridlyMockServer::ShouldRejectRequest()
+{
+	if (Options.TooManyRequestsRatio > 0.0f && Random.FRand() < Options.TooManyRequestsRatio)
+	{
+		return true;
+	}
+
+	if (Options.MaxRequestsPerSecond > 0)
+	{
+		const double NowSeconds = FPlatformTime::Seconds();
+		RecentRequestSeconds.RemoveAll([NowSeconds](const double Seconds)
+		{
+			return NowSeconds - Seconds >= 1.0;
+		});
+
+		// Rejected requests count towards the limit too, as they do on Gridly
+		RecentRequestSeconds.Add(NowSeconds);
+		return RecentRequestSeconds.Num() > Options.MaxRequestsPerSecond;
+	}
+
+	return false;
+}
+
+void FGridlyMockServer::Respond(TUniquePtr<FHttpServerResponse> Response, const int64 NumRequestBytes,
+	const FHttpResultCallback& OnComplete)
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+	double CompleteSeconds = NowSeconds + Options.LatencySeconds;
+
+	if (Options.BandwidthBytesPerSecond > 0)
+	{
+		const double TransferSeconds = double(NumRequestBytes + Response->Body.Num()) / Options.BandwidthBytesPerSecond;
+		LinkFreeSeconds = FMath::Max(LinkFreeSeconds, CompleteSeconds) + TransferSeconds;
+		CompleteSeconds = LinkFreeSeconds;
+	}
+
+	const double DelaySeconds = CompleteSeconds - NowSeconds;
+	if (DelaySeconds <= 0.0)
+	{
+		OnComplete(MoveTemp(Response));
+		return;
+	}
+
+	// Ticker delegates must be copyable, so the response is shared with the delegate until it is sent
+
+	const int64 ResponseId = NextResponseId++;
+	const TSharedRef<TUniquePtr<FHttpServerResponse>> PendingResponse = MakeShared<TUniquePtr<FHttpServerResponse>>(MoveTemp(Response));
+
+	PendingResponses.Add(ResponseId, FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[this, ResponseId, PendingResponse, OnComplete](float)
+		{
+			PendingResponses.Remove(ResponseId);
+			OnComplete(MoveTemp(*PendingResponse));
+			return false;
+		}), DelaySeconds));
+}
+
+TUniquePtr<FHttpServerResponse> FGridlyMockServer::MakeJsonResponse(const FString& Json, const int32 Code)
+{
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Json, TEXT("application/json"));
+	Response->Code = static_cast<EHttpServerResponseCodes>(Code);
+	return Response;
+}
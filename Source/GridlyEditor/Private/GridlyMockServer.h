@@ -0,0 +1,114 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GridlyTableRow.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+#include "Containers/Ticker.h"
+#include "Math/RandomStream.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+struct FHttpServerResponse;
+
+/**
+ * Network conditions and limits of the mock server
+ */
+struct FGridlyMockServerOptions
+{
+	uint32 Port = 8090;
+
+	/** Delay before every response */
+	double LatencySeconds = 0.0;
+
+	/** Bytes per second shared by all requests and responses, 0 for unlimited */
+	int64 BandwidthBytesPerSecond = 0;
+
+	/** Requests per second above which requests are answered with 429 Too Many Requests, 0 for unlimited */
+	int32 MaxRequestsPerSecond = 0;
+
+	/** Share of the requests that are answered with 429 Too Many Requests at random */
+	float TooManyRequestsRatio = 0.0f;
+
+	/** Largest number of records returned per page, regardless of the requested limit */
+	int32 MaxPageSize = 1000;
+
+	/** Seed of the random 429 responses */
+	int32 Seed = 0;
+};
+
+/**
+ * In-memory stand-in for the parts of the Gridly API that the plugin uses: the view schema, listing, upserting and deleting
+ * records, and the CSV export of a view. Runs on the engine's HTTP server, ticked on the game thread, so that syncs can be
+ * tested and measured without a Gridly account by pointing ApiBaseUrl at it
+ */
+class FGridlyMockServer
+{
+public:
+	explicit FGridlyMockServer(const FGridlyMockServerOptions& InOptions);
+	~FGridlyMockServer();
+
+	/** Starts listening, returns false if the port could not be bound */
+	bool Start();
+	void Stop();
+
+	bool IsRunning() const { return RouteHandle.IsValid(); }
+	FString GetBaseUrl() const;
+
+	/** Replaces the records of a view, creating it if needed. Views are also created by the first upsert to them */
+	void SetViewRecords(const FString& ViewId, TArray<FGridlyTableRow> Records);
+	const TArray<FGridlyTableRow>* GetViewRecords(const FString& ViewId) const;
+
+	int32 GetNumRequests() const { return NumRequests; }
+	int32 GetNumTooManyRequests() const { return NumTooManyRequests; }
+
+private:
+	struct FView
+	{
+		TArray<FGridlyTableRow> Records;
+		TMap<FString, int32> RecordIndices;
+
+		void Reindex();
+	};
+
+	bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	TUniquePtr<FHttpServerResponse> GetView(const FString& ViewId) const;
+	TUniquePtr<FHttpServerResponse> ListRecords(const FString& ViewId, const FHttpServerRequest& Request) const;
+	TUniquePtr<FHttpServerResponse> UpsertRecords(const FString& ViewId, const FString& Body);
+	TUniquePtr<FHttpServerResponse> DeleteRecords(const FString& ViewId, const FString& Body);
+	TUniquePtr<FHttpServerResponse> ExportView(const FString& ViewId) const;
+
+	/** Whether the request goes over the rate limit, or is picked for a random 429 */
+	bool ShouldRejectRequest();
+
+	/** Completes the request once the latency and the transfer of both bodies at the shared bandwidth have passed */
+	void Respond(TUniquePtr<FHttpServerResponse> Response, int64 NumRequestBytes, const FHttpResultCallback& OnComplete);
+
+	static TUniquePtr<FHttpServerResponse> MakeJsonResponse(const FString& Json, int32 Code);
+
+private:
+	FGridlyMockServerOptions Options;
+	FRandomStream Random;
+
+	TMap<FString, FView> Views;
+
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+
+	/** Responses that wait for their latency and bandwidth delay, removed when sent or when the server stops */
+	TMap<int64, FTSTicker::FDelegateHandle> PendingResponses;
+	int64 NextResponseId = 0;
+
+	/** Time at which the simulated link has sent all responses so far */
+	double LinkFreeSeconds = 0.0;
+
+	/** Arrival times of the requests of the last second, for the rate limit */
+	TArray<double> RecentRequestSeconds;
+
+	int32 NumRequests = 0;
+	int32 NumTooManyRequests = 0;
+};
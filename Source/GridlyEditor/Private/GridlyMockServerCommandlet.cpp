@@ -0,0 +1,125 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyMockServerCommandlet.h"
+
+#include "GridlyMockServer.h"
+#include "GridlyProfiling.h"
+#include "GridlySyntheticData.h"
+#include "Containers/Ticker.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGridlyMockServerCommandlet, Log, All);
+
+namespace GridlyMockServerCommandlet
+{
+	/** Interval at which the HTTP server is ticked */
+	static const float TickInterval = 0.001f;
+
+	/** Interval between logs of the number of requests served */
+	static const double StatusInterval = 10.0;
+}
+
+int32 UGridlyMockServerCommandlet::Main(const FString& Params)
+{
+	LLM_SCOPE_BYTAG(Gridly);
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	FGridlyMockServerOptions Options;
+	if (const FString* PortParamVal = ParamVals.Find(FString(TEXT("Port"))))
+	{
+		Options.Port = FCString::Atoi(**PortParamVal);
+	}
+	if (const FString* LatencyParamVal = ParamVals.Find(FString(TEXT("LatencyMs"))))
+	{
+		Options.LatencySeconds = FMath::Max(0.0, FCString::Atod(**LatencyParamVal) / 1000.0);
+	}
+	if (const FString* BandwidthParamVal = ParamVals.Find(FString(TEXT("BandwidthKBps"))))
+	{
+		Options.BandwidthBytesPerSecond = FMath::Max<int64>(0, FCString::Atoi64(**BandwidthParamVal) * 1024);
+	}
+	if (const FString* RateLimitParamVal = ParamVals.Find(FString(TEXT("MaxRequestsPerSecond"))))
+	{
+		Options.MaxRequestsPerSecond = FMath::Max(0, FCString::Atoi(**RateLimitParamVal));
+	}
+	if (const FString* TooManyRequestsParamVal = ParamVals.Find(FString(TEXT("TooManyRequestsPercent"))))
+	{
+		Options.TooManyRequestsRatio = FMath::Clamp(FCString::Atof(**TooManyRequestsParamVal) / 100.0f, 0.0f, 1.0f);
+	}
+	if (const FString* PageSizeParamVal = ParamVals.Find(FString(TEXT("MaxPageSize"))))
+	{
+		Options.MaxPageSize = FMath::Max(1, FCString::Atoi(**PageSizeParamVal));
+	}
+
+	// The record count of the shape is set per view below
+	FGridlySyntheticDataShape Shape;
+	Shape.ParseParams(ParamVals, Switches);
+	Options.Seed = Shape.Seed;
+
+	double DurationSeconds = 0.0;
+	if (const FString* DurationParamVal = ParamVals.Find(FString(TEXT("Duration"))))
+	{
+		DurationSeconds = FCString::Atod(**DurationParamVal);
+	}
+
+	FGridlyMockServer MockServer(Options);
+
+	// Views are given as ViewId:NumRecords, filled with synthetic records. Views without a record count start empty, e.g. to
+	// export into
+
+	FString ViewsString = TEXT("view:1000");
+	if (const FString* ViewsParamVal = ParamVals.Find(FString(TEXT("Views"))))
+	{
+		ViewsString = *ViewsParamVal;
+	}
+
+	TArray<FString> ViewStrings;
+	ViewsString.ParseIntoArray(ViewStrings, TEXT(","));
+	for (const FString& ViewString : ViewStrings)
+	{
+		FString ViewId = ViewString;
+		FString NumRecordsString;
+		ViewString.Split(TEXT(":"), &ViewId, &NumRecordsString);
+
+		Shape.NumRecords = FMath::Max(0, FCString::Atoi(*NumRecordsString));
+		MockServer.SetViewRecords(ViewId, FGridlySyntheticData(Shape).GetTableRows());
+
+		UE_LOG(LogGridlyMockServerCommandlet, Display, TEXT("View %s: %d records"), *ViewId, Shape.NumRecords);
+	}
+
+	if (!MockServer.Start())
+	{
+		return -1;
+	}
+
+	UE_LOG(LogGridlyMockServerCommandlet, Display, TEXT("Run other processes with -GridlyApiUrl=%s to sync with the mock server"),
+		*MockServer.GetBaseUrl());
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	double LastTickSeconds = StartSeconds;
+	double LastStatusSeconds = StartSeconds;
+
+	while (!IsEngineExitRequested() && (DurationSeconds <= 0.0 || LastTickSeconds - StartSeconds < DurationSeconds))
+	{
+		const double NowSeconds = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(NowSeconds - LastTickSeconds);
+		LastTickSeconds = NowSeconds;
+
+		if (NowSeconds - LastStatusSeconds >= GridlyMockServerCommandlet::StatusInterval)
+		{
+			UE_LOG(LogGridlyMockServerCommandlet, Display, TEXT("%d requests served, %d answered with 429"),
+				MockServer.GetNumRequests(), MockServer.GetNumTooManyRequests());
+			LastStatusSeconds = NowSeconds;
+		}
+
+		FPlatformProcess::Sleep(GridlyMockServerCommandlet::TickInterval);
+	}
+
+	UE_LOG(LogGridlyMockServerCommandlet, Display, TEXT("Stopping after %d requests, %d answered with 429"),
+		MockServer.GetNumRequests(), MockServer.GetNumTooManyRequests());
+
+	MockServer.Stop();
+	return 0;
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "GridlyMockServerCommandlet.generated.h"
+
+/**
+ * Serves synthetic views from a local mock of the Gridly API until the process is stopped, or for -Duration seconds.
+ * Other processes sync with it when run with -GridlyApiUrl=http://localhost:<Port>:
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=GridlyMockServer -Port=8090 -Views=Import:100000,Export:0 -LatencyMs=80
+ */
+UCLASS()
+class UGridlyMockServerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGridlyMockServerCommandlet(const FObjectInitializer& ObjectInitializer)
+		: Super(ObjectInitializer)
+	{
+		IsClient = false;
+		IsEditor = true;
+		IsServer = false;
+		LogToConsole = true;
+	}
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,35 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyShard.h"
+
+bool FGridlyShard::Contains(const FString& Namespace, const FString& Key) const
+{
+	if (!IsSharded())
+	{
+		return true;
+	}
+
+	const FString NamespaceKey = Namespace + TEXT("/") + Key;
+	return FCrc::StrCrc32(*NamespaceKey) % static_cast<uint32>(Count) == static_cast<uint32>(Index);
+}
+
+bool FGridlyShard::Parse(const FString& String, FGridlyShard& OutShard)
+{
+	FString IndexString;
+	FString CountString;
+	if (!String.Split(TEXT("/"), &IndexString, &CountString) || !IndexString.IsNumeric() || !CountString.IsNumeric())
+	{
+		return false;
+	}
+
+	const int32 ShardIndex = FCString::Atoi(*IndexString);
+	const int32 ShardCount = FCString::Atoi(*CountString);
+	if (ShardCount < 1 || ShardIndex < 0 || ShardIndex >= ShardCount)
+	{
+		return false;
+	}
+
+	OutShard.Index = ShardIndex;
+	OutShard.Count = ShardCount;
+	return true;
+}
@@ -0,0 +1,24 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One of several disjoint parts of the texts of a target, so that a sync can be spread over several machines. Texts are assigned
+ * by a CRC of namespace and key, which is the same on every machine and platform
+ */
+struct FGridlyShard
+{
+	int32 Index = 0;
+	int32 Count = 1;
+
+	bool IsSharded() const { return Count > 1; }
+
+	bool Contains(const FString& Namespace, const FString& Key) const;
+
+	/** Parses a shard written as "Index/Count", e.g. "0/4" for the first of four shards */
+	static bool Parse(const FString& String, FGridlyShard& OutShard);
+
+	FString ToString() const { return FString::Printf(TEXT("%d/%d"), Index, Count); }
+};
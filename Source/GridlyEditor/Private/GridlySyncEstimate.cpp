@@ -0,0 +1,124 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlySyncEstimate.h"
+
+#include "GridlyEditor.h"
+#include "GridlyGameSettings.h"
+#include "GridlyProfiling.h"
+#include "HttpModule.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Interfaces/IHttpResponse.h"
+
+namespace GridlySyncEstimate
+{
+	/** Interval between page requests of the import tasks */
+	static const double RequestInterval = 1.0;
+
+	struct FRecordCountRequests
+	{
+		TArray<int32> RecordCounts;
+		int32 NumPending = 0;
+		TFunction<void(const TArray<int32>&)> OnComplete;
+	};
+}
+
+void FGridlySyncEstimate::AddImport(const TArray<int32>& RecordCounts, const int32 RecordsPerRequest, const int32 NumDownloads)
+{
+	const int32 Limit = FMath::Max(1, RecordsPerRequest);
+
+	for (const int32 RecordCount : RecordCounts)
+	{
+		if (RecordCount != INDEX_NONE)
+		{
+			// An empty view still takes one request to find out that it is empty
+			ImportRequests += FMath::Max(1, FMath::DivideAndRoundUp(RecordCount, Limit)) * NumDownloads;
+			ImportRecords += RecordCount * NumDownloads;
+		}
+	}
+}
+
+void FGridlySyncEstimate::Append(const FGridlySyncEstimate& Other)
+{
+	ImportRequests += Other.ImportRequests;
+	ImportRecords += Other.ImportRecords;
+	ExportRequests += Other.ExportRequests;
+	ExportRecords += Other.ExportRecords;
+	ExportPayloadBytes += Other.ExportPayloadBytes;
+	DeleteRequests += Other.DeleteRequests;
+	DeleteRecords += Other.DeleteRecords;
+	DeletePayloadBytes += Other.DeletePayloadBytes;
+}
+
+double FGridlySyncEstimate::GetEstimatedSeconds() const
+{
+	return GetNumRequests() * GridlySyncEstimate::RequestInterval;
+}
+
+FString FGridlySyncEstimate::ToString() const
+{
+	return FString::Printf(TEXT("Import: %d requests, %d records\n"
+		"Export: %d requests, %d records, %lld bytes\n"
+		"Delete: %d requests, %d records, %lld bytes\n"
+		"Total: %d requests, %lld bytes, about %s at one request per second"),
+		ImportRequests, ImportRecords,
+		ExportRequests, ExportRecords, ExportPayloadBytes,
+		DeleteRequests, DeleteRecords, DeletePayloadBytes,
+		GetNumRequests(), GetPayloadBytes(), *FTimespan::FromSeconds(GetEstimatedSeconds()).ToString(TEXT("%h:%m:%s")));
+}
+
+void FGridlySyncEstimate::RequestRecordCounts(const TArray<FString>& ViewIds, const FString& ApiKey,
+	TFunction<void(const TArray<int32>& RecordCounts)> OnComplete)
+{
+	const TSharedRef<GridlySyncEstimate::FRecordCountRequests> Requests = MakeShared<GridlySyncEstimate::FRecordCountRequests>();
+	Requests->RecordCounts.Init(INDEX_NONE, ViewIds.Num());
+	Requests->NumPending = ViewIds.Num();
+	Requests->OnComplete = MoveTemp(OnComplete);
+
+	if (ViewIds.Num() == 0)
+	{
+		Requests->OnComplete(Requests->RecordCounts);
+		return;
+	}
+
+	const FString PaginationSettings = FGenericPlatformHttp::UrlEncode(TEXT("{\"offset\":0,\"limit\":1}"));
+
+	for (int32 ViewIndex = 0; ViewIndex < ViewIds.Num(); ViewIndex++)
+	{
+		FStringFormatNamedArguments Args;
+		Args.Add(TEXT("ApiBaseUrl"), UGridlyGameSettings::GetApiBaseUrl());
+		Args.Add(TEXT("ViewId"), *ViewIds[ViewIndex]);
+		Args.Add(TEXT("PaginationSettings"), *PaginationSettings);
+		const FString Url = FString::Format(TEXT("{ApiBaseUrl}/v1/views/{ViewId}/records?page={PaginationSettings}"),
+			Args);
+
+		const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
+		HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
+		HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("ApiKey %s"), *ApiKey));
+		HttpRequest->SetVerb(TEXT("GET"));
+		HttpRequest->SetURL(Url);
+
+		HttpRequest->OnProcessRequestComplete().BindLambda(
+			[Requests, ViewIndex, ViewId = ViewIds[ViewIndex]](FHttpRequestPtr HttpRequestPtr, FHttpResponsePtr HttpResponsePtr,
+				bool bSuccess)
+			{
+				FGridlyProfiling::OnRequestCompleted(HttpRequestPtr, HttpResponsePtr);
+
+				if (bSuccess && HttpResponsePtr.IsValid() && HttpResponsePtr->GetResponseCode() == EHttpResponseCodes::Ok)
+				{
+					Requests->RecordCounts[ViewIndex] = FCString::Atoi(*HttpResponsePtr->GetHeader(TEXT("X-Total-Count")));
+				}
+				else
+				{
+					UE_LOG(LogGridlyEditor, Warning, TEXT("Failed to read the number of records of view ID: %s"), *ViewId);
+				}
+
+				if (--Requests->NumPending == 0)
+				{
+					Requests->OnComplete(Requests->RecordCounts);
+				}
+			});
+
+		FGridlyProfiling::OnRequestStarted(*HttpRequest);
+		HttpRequest->ProcessRequest();
+	}
+}
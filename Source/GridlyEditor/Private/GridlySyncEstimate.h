@@ -0,0 +1,44 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Requests, payload and records that a sync would send to Gridly, computed by a dry run that only sends read requests.
+ * Lets heavy syncs be scheduled before they use up the request quota of the API key
+ */
+struct FGridlySyncEstimate
+{
+	int32 ImportRequests = 0;
+	int32 ImportRecords = 0;
+
+	int32 ExportRequests = 0;
+	int32 ExportRecords = 0;
+	int64 ExportPayloadBytes = 0;
+
+	int32 DeleteRequests = 0;
+	int32 DeleteRecords = 0;
+	int64 DeletePayloadBytes = 0;
+
+	/** Adds the pages that downloading the views would take, given their record counts from RequestRecordCounts */
+	void AddImport(const TArray<int32>& RecordCounts, int32 RecordsPerRequest, int32 NumDownloads = 1);
+
+	void Append(const FGridlySyncEstimate& Other);
+
+	int32 GetNumRequests() const { return ImportRequests + ExportRequests + DeleteRequests; }
+	int64 GetPayloadBytes() const { return ExportPayloadBytes + DeletePayloadBytes; }
+
+	/** Duration of the requests at the throttle of the import tasks, which is assumed for every request */
+	double GetEstimatedSeconds() const;
+
+	/** Multi-line summary for logs and message dialogs */
+	FString ToString() const;
+
+	/**
+	 * Reads the number of records of each view from the X-Total-Count header of a single record page. Views that could not
+	 * be read are reported as INDEX_NONE
+	 */
+	static void RequestRecordCounts(const TArray<FString>& ViewIds, const FString& ApiKey,
+		TFunction<void(const TArray<int32>& RecordCounts)> OnComplete);
+};
@@ -0,0 +1,253 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlySyncReport.h"
+
+#include "GridlyEditor.h"
+#include "GridlyProfiling.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace GridlySyncReport
+{
+	static FGridlySyncReport* ActiveReport = nullptr;
+
+	/** Requests are counted per target when one target runs the stage, and under this name when several do */
+	static const TCHAR* SharedTargetName = TEXT("(shared)");
+
+	static const TCHAR* GetRequestStage(const IHttpRequest& Request)
+	{
+		const FString Verb = Request.GetVerb();
+		const FString Url = Request.GetURL();
+
+		if (Verb == TEXT("POST"))
+		{
+			return TEXT("upload");
+		}
+		if (Verb == TEXT("DELETE") || Url.Contains(TEXT("/export")))
+		{
+			return TEXT("sync-delete");
+		}
+		return TEXT("fetch");
+	}
+}
+
+FGridlySyncReport* FGridlySyncReport::GetActive()
+{
+	return GridlySyncReport::ActiveReport;
+}
+
+FGridlySyncReport::~FGridlySyncReport()
+{
+	if (GridlySyncReport::ActiveReport == this)
+	{
+		Stop();
+	}
+}
+
+void FGridlySyncReport::Start()
+{
+	check(!GridlySyncReport::ActiveReport);
+	GridlySyncReport::ActiveReport = this;
+
+	StartTime = FDateTime::UtcNow();
+	StartSeconds = FPlatformTime::Seconds();
+
+	FHttpManager& HttpManager = FHttpModule::Get().GetHttpManager();
+	HttpManager.SetRequestAddedDelegate(FHttpManagerRequestAddedDelegate::CreateRaw(this, &FGridlySyncReport::OnRequestAdded));
+	HttpManager.SetRequestCompletedDelegate(
+		FHttpManagerRequestCompletedDelegate::CreateRaw(this, &FGridlySyncReport::OnRequestCompleted));
+}
+
+void FGridlySyncReport::Stop()
+{
+	StopSeconds = FPlatformTime::Seconds();
+
+	FHttpManager& HttpManager = FHttpModule::Get().GetHttpManager();
+	HttpManager.SetRequestAddedDelegate(FHttpManagerRequestAddedDelegate());
+	HttpManager.SetRequestCompletedDelegate(FHttpManagerRequestCompletedDelegate());
+
+	GridlySyncReport::ActiveReport = nullptr;
+}
+
+void FGridlySyncReport::BeginStage(const FString& TargetName, const FString& Stage)
+{
+	FindOrAddStats(TargetName, Stage);
+	OpenStages.Add(TPair<FString, FString>(TargetName, Stage), FPlatformTime::Seconds());
+
+	if (Stage == TEXT("serialize") || Stage == TEXT("upload"))
+	{
+		LastExportTargetName = TargetName;
+	}
+}
+
+void FGridlySyncReport::EndStage(const FString& TargetName, const FString& Stage)
+{
+	double StageStartSeconds = 0.0;
+	if (OpenStages.RemoveAndCopyValue(TPair<FString, FString>(TargetName, Stage), StageStartSeconds))
+	{
+		FStageStats& Stats = FindOrAddStats(TargetName, Stage);
+		Stats.WallSeconds += FPlatformTime::Seconds() - StageStartSeconds;
+		UpdatePeakMemory(Stats);
+	}
+}
+
+void FGridlySyncReport::AddStageTime(const FString& TargetName, const FString& Stage, const double Seconds)
+{
+	FStageStats& Stats = FindOrAddStats(TargetName, Stage);
+	Stats.WallSeconds += Seconds;
+	UpdatePeakMemory(Stats);
+}
+
+void FGridlySyncReport::AddRecords(const FString& TargetName, const FString& Stage, const int32 NumRecords)
+{
+	FindOrAddStats(TargetName, Stage).Records += NumRecords;
+}
+
+void FGridlySyncReport::AddRecords(const FString& Stage, const int32 NumRecords)
+{
+	AddRecords(ResolveTargetName(Stage), Stage, NumRecords);
+}
+
+FGridlySyncReport::FStageStats& FGridlySyncReport::FindOrAddStats(const FString& TargetName, const FString& Stage)
+{
+	TArray<TPair<FString, FStageStats>>* Stages = StatsByTarget.Find(TargetName);
+	if (!Stages)
+	{
+		TargetNames.Add(TargetName);
+		Stages = &StatsByTarget.Add(TargetName);
+	}
+
+	// Stages are kept in the order they first ran in
+
+	for (TPair<FString, FStageStats>& StageStats : *Stages)
+	{
+		if (StageStats.Key == Stage)
+		{
+			return StageStats.Value;
+		}
+	}
+	return Stages->Emplace_GetRef(Stage, FStageStats()).Value;
+}
+
+FString FGridlySyncReport::ResolveTargetName(const FString& Stage) const
+{
+	const FString* FoundTargetName = nullptr;
+	for (const TPair<TPair<FString, FString>, double>& OpenStage : OpenStages)
+	{
+		if (OpenStage.Key.Value == Stage)
+		{
+			if (FoundTargetName)
+			{
+				return GridlySyncReport::SharedTargetName;
+			}
+			FoundTargetName = &OpenStage.Key.Key;
+		}
+	}
+
+	if (FoundTargetName)
+	{
+		return *FoundTargetName;
+	}
+	if ((Stage == TEXT("upload") || Stage == TEXT("sync-delete")) && !LastExportTargetName.IsEmpty())
+	{
+		return LastExportTargetName;
+	}
+	return GridlySyncReport::SharedTargetName;
+}
+
+void FGridlySyncReport::UpdatePeakMemory(FStageStats& Stats) const
+{
+	// The platform only tracks the peak of the whole process, so this is the peak reached by the end of the stage
+	Stats.PeakUsedPhysical = FMath::Max<uint64>(Stats.PeakUsedPhysical, FPlatformMemory::GetStats().PeakUsedPhysical);
+}
+
+void FGridlySyncReport::OnRequestAdded(const FHttpRequestRef& Request)
+{
+	const FString Stage = GridlySyncReport::GetRequestStage(*Request);
+	RequestsInFlight.Add(&Request.Get(), TPair<FString, FString>(ResolveTargetName(Stage), Stage));
+}
+
+void FGridlySyncReport::OnRequestCompleted(const FHttpRequestRef& Request)
+{
+	TPair<FString, FString> TargetAndStage;
+	if (!RequestsInFlight.RemoveAndCopyValue(&Request.Get(), TargetAndStage))
+	{
+		return;
+	}
+
+	FStageStats& Stats = FindOrAddStats(TargetAndStage.Key, TargetAndStage.Value);
+	Stats.Requests++;
+	Stats.BytesSent += Request->GetContentLength();
+
+	if (const FHttpResponsePtr Response = Request->GetResponse())
+	{
+		Stats.BytesReceived += Response->GetContentLength();
+	}
+
+	// Stages that only consist of requests have no wall time of their own
+	if (!OpenStages.Contains(TargetAndStage))
+	{
+		Stats.WallSeconds += Request->GetElapsedTime();
+	}
+
+	UpdatePeakMemory(Stats);
+}
+
+bool FGridlySyncReport::WriteToFile(const FString& FilePath, const int32 MaxParallelTargets) const
+{
+	const TSharedRef<FJsonObject> ReportObject = MakeShareable(new FJsonObject);
+	ReportObject->SetNumberField(TEXT("version"), 1);
+	ReportObject->SetStringField(TEXT("startedAt"), StartTime.ToIso8601());
+	ReportObject->SetNumberField(TEXT("wallSeconds"), (StopSeconds > 0.0 ? StopSeconds : FPlatformTime::Seconds()) - StartSeconds);
+	ReportObject->SetNumberField(TEXT("parallel"), MaxParallelTargets);
+
+	TArray<TSharedPtr<FJsonValue>> TargetValues;
+	for (const FString& TargetName : TargetNames)
+	{
+		const TSharedRef<FJsonObject> TargetObject = MakeShareable(new FJsonObject);
+		TargetObject->SetStringField(TEXT("name"), TargetName);
+
+		TArray<TSharedPtr<FJsonValue>> StageValues;
+		for (const TPair<FString, FStageStats>& StageStats : StatsByTarget[TargetName])
+		{
+			const FStageStats& Stats = StageStats.Value;
+
+			const TSharedRef<FJsonObject> StageObject = MakeShareable(new FJsonObject);
+			StageObject->SetStringField(TEXT("stage"), StageStats.Key);
+			StageObject->SetNumberField(TEXT("wallSeconds"), Stats.WallSeconds);
+			StageObject->SetNumberField(TEXT("requests"), Stats.Requests);
+			StageObject->SetNumberField(TEXT("retries"), Stats.Retries);
+			StageObject->SetNumberField(TEXT("bytesSent"), Stats.BytesSent);
+			StageObject->SetNumberField(TEXT("bytesReceived"), Stats.BytesReceived);
+			StageObject->SetNumberField(TEXT("records"), Stats.Records);
+			StageObject->SetNumberField(TEXT("peakMemoryBytes"), Stats.PeakUsedPhysical);
+			StageValues.Add(MakeShareable(new FJsonValueObject(StageObject)));
+		}
+
+		TargetObject->SetArrayField(TEXT("stages"), StageValues);
+		TargetValues.Add(MakeShareable(new FJsonValueObject(TargetObject)));
+	}
+	ReportObject->SetArrayField(TEXT("targets"), TargetValues);
+
+	// Latency percentiles per endpoint and a timeline of every request, with times relative to the start of the report
+	ReportObject->SetObjectField(TEXT("http"), FGridlyProfiling::RequestTimingsToJson(StartSeconds));
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(ReportObject, JsonWriter))
+	{
+		return false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(JsonString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogGridlyEditor, Error, TEXT("Failed to write sync report: %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogGridlyEditor, Log, TEXT("Wrote sync report: %s"), *FilePath);
+	return true;
+}
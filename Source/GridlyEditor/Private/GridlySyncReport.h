@@ -0,0 +1,71 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+
+/**
+ * Collects wall time, HTTP traffic, records and peak memory per localization target and sync stage, and writes them as JSON
+ * so that sync performance can be tracked over time. HTTP requests are counted through the HTTP manager while the report is active
+ */
+class FGridlySyncReport
+{
+public:
+	struct FStageStats
+	{
+		double WallSeconds = 0.0;
+		int32 Requests = 0;
+		int32 Retries = 0;
+		int64 BytesSent = 0;
+		int64 BytesReceived = 0;
+		int32 Records = 0;
+		uint64 PeakUsedPhysical = 0;
+	};
+
+	~FGridlySyncReport();
+
+	/** Returns the report of the running sync, or nullptr if no report was requested */
+	static FGridlySyncReport* GetActive();
+
+	/** Counts HTTP requests until stopped. A report that is destroyed while started stops itself */
+	void Start();
+	void Stop();
+
+	void BeginStage(const FString& TargetName, const FString& Stage);
+	void EndStage(const FString& TargetName, const FString& Stage);
+
+	/** Adds time spent in a stage outside of BeginStage/EndStage, e.g. for work done in callbacks */
+	void AddStageTime(const FString& TargetName, const FString& Stage, double Seconds);
+	void AddRecords(const FString& TargetName, const FString& Stage, int32 NumRecords);
+
+	/** Adds records to the target that is currently running the stage */
+	void AddRecords(const FString& Stage, int32 NumRecords);
+
+	int32 GetNumRequestsInFlight() const { return RequestsInFlight.Num(); }
+
+	bool WriteToFile(const FString& FilePath, int32 MaxParallelTargets) const;
+
+private:
+	FStageStats& FindOrAddStats(const FString& TargetName, const FString& Stage);
+	FString ResolveTargetName(const FString& Stage) const;
+	void UpdatePeakMemory(FStageStats& Stats) const;
+
+	void OnRequestAdded(const FHttpRequestRef& Request);
+	void OnRequestCompleted(const FHttpRequestRef& Request);
+
+	FDateTime StartTime;
+	double StartSeconds = 0.0;
+	double StopSeconds = 0.0;
+
+	TArray<FString> TargetNames;
+	TMap<FString, TArray<TPair<FString, FStageStats>>> StatsByTarget;
+
+	/** Start times of stages that are running, by target and stage */
+	TMap<TPair<FString, FString>, double> OpenStages;
+
+	/** Target that exported last, which owns upload requests sent before its upload stage begins and the sync-delete requests after it */
+	FString LastExportTargetName;
+
+	TMap<const IHttpRequest*, TPair<FString, FString>> RequestsInFlight;
+};
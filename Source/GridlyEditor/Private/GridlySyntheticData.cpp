@@ -0,0 +1,489 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlySyntheticData.h"
+
+#include "GridlyGameSettings.h"
+#include "LocTextHelper.h"
+#include "HAL/FileManager.h"
+#include "Internationalization/PolyglotTextData.h"
+#include "Math/RandomStream.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+namespace GridlySyntheticData
+{
+	static const TCHAR* const Words[] = {
+		TEXT("the"), TEXT("sword"), TEXT("of"), TEXT("ancient"), TEXT("kings"), TEXT("lies"), TEXT("beyond"), TEXT("the"),
+		TEXT("northern"), TEXT("gate"), TEXT("bring"), TEXT("me"), TEXT("three"), TEXT("wolf"), TEXT("pelts"), TEXT("and"),
+		TEXT("I"), TEXT("will"), TEXT("forge"), TEXT("you"), TEXT("a"), TEXT("shield"), TEXT("quest"), TEXT("complete"),
+		TEXT("press"), TEXT("{0}"), TEXT("to"), TEXT("continue"), TEXT("level"), TEXT("up!"), TEXT("gold"), TEXT("{Count}")
+	};
+
+	static const TCHAR* const Escapes[] = { TEXT("\""), TEXT("\\"), TEXT("\t"), TEXT("\n"), TEXT("\r\n") };
+
+	static const TCHAR* const Categories[] = { TEXT("Dialogue"), TEXT("Quest"), TEXT("Item"), TEXT("UI"), TEXT("Tutorial") };
+
+	static const TCHAR* const PathSegments[] = { TEXT("Scene"), TEXT("Sequence"), TEXT("Shot"), TEXT("Branch"), TEXT("Line") };
+
+	static const TCHAR* const Speakers[] = { TEXT("KING"), TEXT("BLACKSMITH"), TEXT("WITCH"), TEXT("GUARD"), TEXT("NARRATOR") };
+
+	static const TCHAR* const Tags[] = { TEXT("Rare"), TEXT("Quest"), TEXT("Hidden"), TEXT("Story"), TEXT("Combat"), TEXT("Voiced") };
+
+	static const TCHAR* const Rarities[] = { TEXT("Common"), TEXT("Rare"), TEXT("Epic"), TEXT("Legendary") };
+
+	static const TCHAR* const Modifiers[] = { TEXT("Fire"), TEXT("Frost"), TEXT("Poison"), TEXT("Haste") };
+
+	/** Number of records per namespace */
+	static const int32 RecordsPerNamespace = 250;
+
+	static FString QuoteCSV(const FString& Value)
+	{
+		return TEXT("\"") + Value.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+	}
+
+	static FGridlyTableCell MakeCell(const FString& ColumnId, FString Value)
+	{
+		FGridlyTableCell Cell;
+		Cell.ColumnId = ColumnId;
+		Cell.Value = MoveTemp(Value);
+		return Cell;
+	}
+
+	static void AppendWords(TStringBuilder<512>& Builder, FRandomStream& Random, const int32 NumWords, const bool bUseEscapes)
+	{
+		for (int32 i = 0; i < NumWords; i++)
+		{
+			if (i > 0)
+			{
+				Builder << (bUseEscapes && Random.RandHelper(8) == 0 ? Escapes[Random.RandHelper(UE_ARRAY_COUNT(Escapes))] : TEXT(" "));
+			}
+			Builder << Words[Random.RandHelper(UE_ARRAY_COUNT(Words))];
+		}
+	}
+}
+
+const TCHAR* const FGridlySyntheticData::MultiSelectColumnId = TEXT("Tags");
+const TCHAR* const FGridlySyntheticData::ManifestName = TEXT("Synthetic.manifest");
+const TCHAR* const FGridlySyntheticData::ArchiveName = TEXT("Synthetic.archive");
+
+void FGridlySyntheticDataShape::ParseParams(const TMap<FString, FString>& ParamVals, const TArray<FString>& Switches)
+{
+	if (const FString* RecordsParamVal = ParamVals.Find(FString(TEXT("Records"))))
+	{
+		NumRecords = FMath::Max(0, FCString::Atoi(**RecordsParamVal));
+	}
+	if (const FString* LanguagesParamVal = ParamVals.Find(FString(TEXT("Languages"))))
+	{
+		NumLanguages = FMath::Clamp(FCString::Atoi(**LanguagesParamVal), 1, FGridlySyntheticData::GetAllGridlyCultures().Num());
+	}
+	if (const FString* MinWordsParamVal = ParamVals.Find(FString(TEXT("MinWords"))))
+	{
+		MinWords = FMath::Max(1, FCString::Atoi(**MinWordsParamVal));
+	}
+	if (const FString* MaxWordsParamVal = ParamVals.Find(FString(TEXT("MaxWords"))))
+	{
+		MaxWords = FMath::Max(1, FCString::Atoi(**MaxWordsParamVal));
+	}
+	if (const FString* DialogueParamVal = ParamVals.Find(FString(TEXT("DialogueRatio"))))
+	{
+		DialogueRatio = FMath::Clamp(FCString::Atof(**DialogueParamVal), 0.0f, 1.0f);
+	}
+	if (const FString* DialogueWordsParamVal = ParamVals.Find(FString(TEXT("MaxDialogueWords"))))
+	{
+		MaxDialogueWords = FMath::Max(1, FCString::Atoi(**DialogueWordsParamVal));
+	}
+	if (const FString* EscapeParamVal = ParamVals.Find(FString(TEXT("EscapeRatio"))))
+	{
+		EscapeRatio = FMath::Clamp(FCString::Atof(**EscapeParamVal), 0.0f, 1.0f);
+	}
+	if (const FString* PathDepthParamVal = ParamVals.Find(FString(TEXT("PathDepth"))))
+	{
+		PathDepth = FMath::Max(0, FCString::Atoi(**PathDepthParamVal));
+	}
+	if (const FString* SeedParamVal = ParamVals.Find(FString(TEXT("Seed"))))
+	{
+		Seed = FCString::Atoi(**SeedParamVal);
+	}
+
+	bDataColumns |= Switches.Contains(TEXT("DataColumns"));
+}
+
+FGridlySyntheticData::FGridlySyntheticData(const FGridlySyntheticDataShape& InShape)
+	: Shape(InShape)
+{
+	const UGridlyGameSettings* GameSettings = GetMutableDefault<UGridlyGameSettings>();
+	const TArray<FString> GridlyCultures = GetGridlyCultures();
+
+	FRandomStream Random(Shape.Seed);
+
+	TableRows.SetNum(FMath::Max(0, Shape.NumRecords));
+
+	for (int32 i = 0; i < TableRows.Num(); i++)
+	{
+		FGridlyTableRow& TableRow = TableRows[i];
+
+		const FString Namespace = MakePath(i);
+		const FString Key = FString::Printf(TEXT("Key_%07d"), i);
+
+		TableRow.Id = GameSettings->bUseCombinedNamespaceId ? Namespace + TEXT(",") + Key : Key;
+		TableRow.Path = Namespace;
+		TableRow.Cells.SetNum(GridlyCultures.Num());
+
+		for (int32 j = 0; j < GridlyCultures.Num(); j++)
+		{
+			FGridlyTableCell& Cell = TableRow.Cells[j];
+			Cell.ColumnId = (j == 0 ? GameSettings->SourceLanguageColumnIdPrefix : GameSettings->TargetLanguageColumnIdPrefix)
+				+ GridlyCultures[j];
+			Cell.Value = MakeText(Random);
+		}
+
+		if (Shape.bDataColumns)
+		{
+			TableRow.Cells.Add(GridlySyntheticData::MakeCell(TEXT("Text"), GridlyCultures.Num() > 0 ? TableRow.Cells[0].Value : FString()));
+			MakeDataCells(i, TableRow.Cells);
+		}
+	}
+}
+
+TArray<FString> FGridlySyntheticData::GetGridlyCultures() const
+{
+	const TArray<FString>& AllGridlyCultures = GetAllGridlyCultures();
+	const int32 NumLanguages = FMath::Clamp(Shape.NumLanguages, 1, AllGridlyCultures.Num());
+	return TArray<FString>(AllGridlyCultures.GetData(), NumLanguages);
+}
+
+FString FGridlySyntheticData::WriteRecordsJson(const TArray<FGridlyTableRow>& Records, const int32 StartIndex, const int32 Num)
+{
+	const int32 EndIndex = Num == INDEX_NONE ? Records.Num() : FMath::Min(Records.Num(), StartIndex + Num);
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+
+	JsonWriter->WriteArrayStart();
+
+	for (int32 i = StartIndex; i < EndIndex; i++)
+	{
+		const FGridlyTableRow& TableRow = Records[i];
+
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("id"), TableRow.Id);
+		JsonWriter->WriteValue(TEXT("path"), TableRow.Path);
+		JsonWriter->WriteArrayStart(TEXT("cells"));
+
+		for (const FGridlyTableCell& Cell : TableRow.Cells)
+		{
+			JsonWriter->WriteObjectStart();
+			JsonWriter->WriteValue(TEXT("columnId"), Cell.ColumnId);
+			if (Cell.ColumnId == MultiSelectColumnId && Cell.Value.StartsWith(TEXT("[")))
+			{
+				JsonWriter->WriteRawJSONValue(TEXT("value"), Cell.Value);
+			}
+			else
+			{
+				JsonWriter->WriteValue(TEXT("value"), Cell.Value);
+			}
+			JsonWriter->WriteObjectEnd();
+		}
+
+		JsonWriter->WriteArrayEnd();
+		JsonWriter->WriteObjectEnd();
+	}
+
+	JsonWriter->WriteArrayEnd();
+	JsonWriter->Close();
+
+	return JsonString;
+}
+
+FString FGridlySyntheticData::WriteCSV(const TArray<FGridlyTableRow>& Records)
+{
+	TArray<FString> ColumnIds;
+	for (const FGridlyTableRow& TableRow : Records)
+	{
+		for (const FGridlyTableCell& Cell : TableRow.Cells)
+		{
+			ColumnIds.AddUnique(Cell.ColumnId);
+		}
+	}
+
+	TStringBuilder<4096> Builder;
+	Builder << TEXT("\"Record ID\",\"Path\"");
+	for (const FString& ColumnId : ColumnIds)
+	{
+		Builder << TEXT(",") << GridlySyntheticData::QuoteCSV(ColumnId);
+	}
+	Builder << TEXT("\n");
+
+	TArray<const FString*> Values;
+	for (const FGridlyTableRow& TableRow : Records)
+	{
+		Values.Init(nullptr, ColumnIds.Num());
+		for (const FGridlyTableCell& Cell : TableRow.Cells)
+		{
+			Values[ColumnIds.IndexOfByKey(Cell.ColumnId)] = &Cell.Value;
+		}
+
+		Builder << GridlySyntheticData::QuoteCSV(TableRow.Id) << TEXT(",") << GridlySyntheticData::QuoteCSV(TableRow.Path);
+		for (const FString* Value : Values)
+		{
+			Builder << TEXT(",") << (Value ? GridlySyntheticData::QuoteCSV(*Value) : FString());
+		}
+		Builder << TEXT("\n");
+	}
+
+	return FString(Builder.ToView());
+}
+
+FString FGridlySyntheticData::ToDataTableJson() const
+{
+	FString JsonString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+
+	// Scalar cells are strings, as the import task passes them on from the Gridly records. The multi-select and the
+	// struct are written as JSON, which the importer reads without any of the HS_GRIDLY_* options
+
+	JsonWriter->WriteArrayStart();
+
+	TArray<FGridlyTableCell> DataCells;
+	for (int32 i = 0; i < TableRows.Num(); i++)
+	{
+		const FGridlyTableRow& TableRow = TableRows[i];
+
+		DataCells.Reset();
+		MakeDataCells(i, DataCells);
+
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("name"), TableRow.Id);
+		JsonWriter->WriteValue(TEXT("_path"), TableRow.Path);
+		JsonWriter->WriteValue(TEXT("Text"), TableRow.Cells.Num() > 0 ? TableRow.Cells[0].Value : FString());
+
+		for (const FGridlyTableCell& Cell : DataCells)
+		{
+			if (Cell.Value.StartsWith(TEXT("[")) || Cell.Value.StartsWith(TEXT("{")))
+			{
+				JsonWriter->WriteRawJSONValue(Cell.ColumnId, Cell.Value);
+			}
+			else
+			{
+				JsonWriter->WriteValue(Cell.ColumnId, Cell.Value);
+			}
+		}
+
+		JsonWriter->WriteObjectEnd();
+	}
+
+	JsonWriter->WriteArrayEnd();
+	JsonWriter->Close();
+
+	return JsonString;
+}
+
+TArray<FPolyglotTextData> FGridlySyntheticData::ToPolyglotTextDatas() const
+{
+	const TArray<FString> Cultures = GetCultures();
+
+	TArray<FPolyglotTextData> PolyglotTextDatas;
+	PolyglotTextDatas.Reserve(TableRows.Num());
+
+	for (const FGridlyTableRow& TableRow : TableRows)
+	{
+		FString Key = TableRow.Id;
+		TableRow.Id.Split(TEXT(","), nullptr, &Key);
+
+		FPolyglotTextData& PolyglotTextData = PolyglotTextDatas.Emplace_GetRef(ELocalizedTextSourceCategory::Game, TableRow.Path,
+			Key, TableRow.Cells.Num() > 0 ? TableRow.Cells[0].Value : FString(), Cultures[0]);
+
+		for (int32 j = 1; j < Cultures.Num() && j < TableRow.Cells.Num(); j++)
+		{
+			PolyglotTextData.AddLocalizedString(Cultures[j], TableRow.Cells[j].Value);
+		}
+	}
+
+	return PolyglotTextDatas;
+}
+
+TArray<FString> FGridlySyntheticData::GetCultures() const
+{
+	const TArray<FString> GridlyCultures = GetGridlyCultures();
+
+	TArray<FString> Cultures;
+	Cultures.Reserve(GridlyCultures.Num());
+	for (const FString& GridlyCulture : GridlyCultures)
+	{
+		Cultures.Add(GridlyCultureToCulture(GridlyCulture));
+	}
+	return Cultures;
+}
+
+bool FGridlySyntheticData::WriteLocalization(const FString& OutputDir, FText* OutError) const
+{
+	IFileManager::Get().DeleteDirectory(*OutputDir, false, true);
+
+	const TArray<FString> Cultures = GetCultures();
+	const FString NativeCulture = Cultures[0];
+	const TArray<FString> ForeignCultures(Cultures.GetData() + 1, Cultures.Num() - 1);
+
+	FLocTextHelper LocTextHelper(OutputDir, ManifestName, ArchiveName, NativeCulture, ForeignCultures, nullptr);
+	if (!LocTextHelper.LoadAll(ELocTextHelperLoadFlags::Create, OutError))
+	{
+		return false;
+	}
+
+	for (const FPolyglotTextData& PolyglotTextData : ToPolyglotTextDatas())
+	{
+		const FLocItem Source(PolyglotTextData.GetNativeString());
+
+		FManifestContext Context;
+		Context.Key = PolyglotTextData.GetKey();
+		LocTextHelper.AddSourceText(PolyglotTextData.GetNamespace(), Source, Context);
+		LocTextHelper.AddTranslation(NativeCulture, PolyglotTextData.GetNamespace(), Context.Key, nullptr, Source, Source, false);
+
+		for (const FString& Culture : ForeignCultures)
+		{
+			FString LocalizedString;
+			if (PolyglotTextData.GetLocalizedString(Culture, LocalizedString))
+			{
+				LocTextHelper.AddTranslation(Culture, PolyglotTextData.GetNamespace(), Context.Key, nullptr, Source,
+					FLocItem(LocalizedString), false);
+			}
+		}
+	}
+
+	return LocTextHelper.SaveAll(OutError);
+}
+
+FString FGridlySyntheticData::GridlyCultureToCulture(const FString& GridlyCulture)
+{
+	for (int32 i = 1; i < GridlyCulture.Len(); i++)
+	{
+		if (FChar::IsUpper(GridlyCulture[i]))
+		{
+			return GridlyCulture.Left(i) + TEXT("-") + GridlyCulture.RightChop(i);
+		}
+	}
+
+	return GridlyCulture;
+}
+
+const TArray<FString>& FGridlySyntheticData::GetAllGridlyCultures()
+{
+	static const TArray<FString> GridlyCultures = {
+		TEXT("enUS"), TEXT("deDE"), TEXT("frFR"), TEXT("esES"), TEXT("itIT"), TEXT("jaJP"), TEXT("koKR"), TEXT("zhCN"),
+		TEXT("ptBR"), TEXT("ruRU"), TEXT("plPL"), TEXT("zhTW"), TEXT("ptPT"), TEXT("trTR"), TEXT("arSA"), TEXT("nlNL"),
+		TEXT("svSE"), TEXT("daDK"), TEXT("fiFI"), TEXT("nbNO"), TEXT("csCZ"), TEXT("huHU"), TEXT("roRO"), TEXT("ukUA"),
+		TEXT("thTH"), TEXT("viVN"), TEXT("idID"), TEXT("heIL"), TEXT("elGR"), TEXT("esMX")
+	};
+	return GridlyCultures;
+}
+
+FString FGridlySyntheticData::MakeText(FRandomStream& Random) const
+{
+	const bool bUseEscapes = Random.FRand() < Shape.EscapeRatio;
+
+	TStringBuilder<512> Builder;
+
+	if (Shape.DialogueRatio > 0.0f && Random.FRand() < Shape.DialogueRatio)
+	{
+		// Dialogue is a few lines of "SPEAKER: ..." separated by line breaks
+
+		const int32 NumLines = Random.RandRange(2, 6);
+		for (int32 i = 0; i < NumLines; i++)
+		{
+			if (i > 0)
+			{
+				Builder << TEXT("\n");
+			}
+			Builder << GridlySyntheticData::Speakers[Random.RandHelper(UE_ARRAY_COUNT(GridlySyntheticData::Speakers))] << TEXT(": ");
+			GridlySyntheticData::AppendWords(Builder, Random, Random.RandRange(1, FMath::Max(1, Shape.MaxDialogueWords / NumLines)),
+				bUseEscapes);
+		}
+	}
+	else
+	{
+		const int32 NumWords = Random.RandRange(FMath::Max(1, Shape.MinWords), FMath::Max(Shape.MinWords, Shape.MaxWords));
+		GridlySyntheticData::AppendWords(Builder, Random, NumWords, bUseEscapes);
+	}
+
+	return FString(Builder.ToView());
+}
+
+FString FGridlySyntheticData::MakePath(const int32 RecordIndex) const
+{
+	const int32 Group = RecordIndex / GridlySyntheticData::RecordsPerNamespace;
+
+	TStringBuilder<128> Builder;
+	Builder << GridlySyntheticData::Categories[Group % UE_ARRAY_COUNT(GridlySyntheticData::Categories)];
+
+	for (int32 Depth = 0; Depth < Shape.PathDepth; Depth++)
+	{
+		if (Depth == 0)
+		{
+			Builder.Appendf(TEXT("/Chapter%02d"), Group);
+		}
+		else
+		{
+			Builder.Appendf(TEXT("/%s%02d"),
+				GridlySyntheticData::PathSegments[(Depth - 1) % UE_ARRAY_COUNT(GridlySyntheticData::PathSegments)],
+				(Group * 31 + Depth * 7) % 20);
+		}
+	}
+
+	return FString(Builder.ToView());
+}
+
+void FGridlySyntheticData::MakeDataCells(const int32 RecordIndex, TArray<FGridlyTableCell>& OutCells) const
+{
+	FRandomStream Random(HashCombine(GetTypeHash(Shape.Seed), GetTypeHash(RecordIndex)));
+
+	OutCells.Add(GridlySyntheticData::MakeCell(TEXT("Count"), FString::FromInt(Random.RandRange(0, 9999))));
+	OutCells.Add(GridlySyntheticData::MakeCell(TEXT("Weight"), FString::SanitizeFloat(Random.FRandRange(0.0f, 100.0f))));
+	OutCells.Add(GridlySyntheticData::MakeCell(TEXT("Category"),
+		GridlySyntheticData::Categories[Random.RandHelper(UE_ARRAY_COUNT(GridlySyntheticData::Categories))]));
+
+	// Multi-select options are a JSON array of strings
+
+	FString Tags;
+	{
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Tags);
+		JsonWriter->WriteArrayStart();
+		const int32 FirstTag = Random.RandHelper(UE_ARRAY_COUNT(GridlySyntheticData::Tags));
+		const int32 NumTags = Random.RandRange(0, 3);
+		for (int32 i = 0; i < NumTags; i++)
+		{
+			JsonWriter->WriteValue(GridlySyntheticData::Tags[(FirstTag + i) % UE_ARRAY_COUNT(GridlySyntheticData::Tags)]);
+		}
+		JsonWriter->WriteArrayEnd();
+		JsonWriter->Close();
+	}
+	OutCells.Add(GridlySyntheticData::MakeCell(MultiSelectColumnId, MoveTemp(Tags)));
+
+	// The struct is a JSON object with a nested array of objects
+
+	FString Stats;
+	{
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Stats);
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("Level"), Random.RandRange(1, 60));
+		JsonWriter->WriteValue(TEXT("Damage"), Random.FRandRange(1.0f, 500.0f));
+		JsonWriter->WriteValue(TEXT("Rarity"),
+			GridlySyntheticData::Rarities[Random.RandHelper(UE_ARRAY_COUNT(GridlySyntheticData::Rarities))]);
+		JsonWriter->WriteArrayStart(TEXT("Modifiers"));
+		const int32 NumModifiers = Random.RandRange(0, 3);
+		for (int32 i = 0; i < NumModifiers; i++)
+		{
+			JsonWriter->WriteObjectStart();
+			JsonWriter->WriteValue(TEXT("Name"),
+				GridlySyntheticData::Modifiers[Random.RandHelper(UE_ARRAY_COUNT(GridlySyntheticData::Modifiers))]);
+			JsonWriter->WriteValue(TEXT("Value"), Random.FRandRange(0.5f, 2.0f));
+			JsonWriter->WriteObjectEnd();
+		}
+		JsonWriter->WriteArrayEnd();
+		JsonWriter->WriteObjectEnd();
+		JsonWriter->Close();
+	}
+	OutCells.Add(GridlySyntheticData::MakeCell(TEXT("Stats"), MoveTemp(Stats)));
+}
@@ -0,0 +1,168 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Engine/DataTable.h"
+#include "GridlyTableRow.h"
+
+#include "GridlySyntheticData.generated.h"
+
+class FRandomStream;
+
+USTRUCT()
+struct FGridlySyntheticModifier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	FString Name;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	float Value = 0.0f;
+};
+
+/**
+ * Nested struct of the synthetic rows, stored on Gridly as a JSON string
+ */
+USTRUCT()
+struct FGridlySyntheticStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	int32 Level = 0;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	float Damage = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	FString Rarity;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	TArray<FGridlySyntheticModifier> Modifiers;
+};
+
+/**
+ * Row struct of the data tables generated from synthetic records, one property per non-language column
+ */
+USTRUCT()
+struct FGridlySyntheticRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	FString Text;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	int32 Count = 0;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	float Weight = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	FString Category;
+
+	/** Multi-select column */
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	TArray<FString> Tags;
+
+	UPROPERTY(EditAnywhere, Category = Gridly)
+	FGridlySyntheticStats Stats;
+};
+
+/**
+ * Shape of a synthetic Gridly view
+ */
+struct FGridlySyntheticDataShape
+{
+	int32 NumRecords = 1000;
+
+	/** Number of language columns, including the source language, up to 30 */
+	int32 NumLanguages = 11;
+
+	int32 MinWords = 2;
+	int32 MaxWords = 40;
+
+	/** Share of the texts that are dialogue: several lines of up to MaxDialogueWords words each */
+	float DialogueRatio = 0.0f;
+	int32 MaxDialogueWords = 400;
+
+	/** Share of the texts that contain quotes, backslashes, tabs or line breaks */
+	float EscapeRatio = 0.2f;
+
+	/** Number of path segments below the category, e.g. 3 for "Quest/Chapter01/Scene03/Shot02" */
+	int32 PathDepth = 1;
+
+	/** Adds the non-language columns of FGridlySyntheticRow to every record, including a multi-select and a JSON struct */
+	bool bDataColumns = false;
+
+	int32 Seed = 0;
+
+	/** Reads the shape from commandlet parameters such as -Records=, -Languages=, -PathDepth= and -DataColumns */
+	void ParseParams(const TMap<FString, FString>& ParamVals, const TArray<FString>& Switches);
+};
+
+/**
+ * Deterministic Gridly records for offline measurements, in the same formats that the plugin reads and writes.
+ * The same shape and seed always produce the same records
+ */
+class FGridlySyntheticData
+{
+public:
+	explicit FGridlySyntheticData(const FGridlySyntheticDataShape& InShape);
+
+	const FGridlySyntheticDataShape& GetShape() const { return Shape; }
+	const TArray<FGridlyTableRow>& GetTableRows() const { return TableRows; }
+
+	/** Gridly language codes of the language columns, the source language first */
+	TArray<FString> GetGridlyCultures() const;
+
+	/** Body of a record page response of the Gridly API */
+	FString ToRecordsJson(int32 StartIndex = 0, int32 Num = INDEX_NONE) const { return WriteRecordsJson(TableRows, StartIndex, Num); }
+
+	/** View export in the CSV layout of the Gridly API, as fetched before deleting stale records */
+	FString ToCSV() const { return WriteCSV(TableRows); }
+
+	/** Rows of FGridlySyntheticRow as the import task passes them to the data table importer */
+	FString ToDataTableJson() const;
+
+	/** Texts as gathered from a localization target, with a translation for each target language */
+	TArray<FPolyglotTextData> ToPolyglotTextDatas() const;
+
+	/** Cultures of the language columns, the native culture first */
+	TArray<FString> GetCultures() const;
+
+	/** Writes the texts as a manifest with one archive per culture, named ManifestName and ArchiveName, to OutputDir */
+	bool WriteLocalization(const FString& OutputDir, FText* OutError = nullptr) const;
+
+	/** Writes records in the layout of a record page response, from StartIndex on */
+	static FString WriteRecordsJson(const TArray<FGridlyTableRow>& Records, int32 StartIndex = 0, int32 Num = INDEX_NONE);
+
+	/** Writes one column per column ID of the records, in the order they first appear */
+	static FString WriteCSV(const TArray<FGridlyTableRow>& Records);
+
+	/** Converts a Gridly language code such as "enUS" to a culture name such as "en-US" */
+	static FString GridlyCultureToCulture(const FString& GridlyCulture);
+
+	/** All Gridly language codes that synthetic views draw their language columns from */
+	static const TArray<FString>& GetAllGridlyCultures();
+
+	/** Column whose cells hold a JSON array of options, which record pages send as an array rather than a string */
+	static const TCHAR* const MultiSelectColumnId;
+
+	static const TCHAR* const ManifestName;
+	static const TCHAR* const ArchiveName;
+
+private:
+	FString MakeText(FRandomStream& Random) const;
+	FString MakePath(int32 RecordIndex) const;
+
+	/** Cells of the non-language columns, from a stream of their own so that they do not change the texts */
+	void MakeDataCells(int32 RecordIndex, TArray<FGridlyTableCell>& OutCells) const;
+
+private:
+	FGridlySyntheticDataShape Shape;
+	TArray<FGridlyTableRow> TableRows;
+};
@@ -0,0 +1,400 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "SGridlyRequestsPanel.h"
+
+#include "GridlyEditor.h"
+#include "Framework/Docking/TabManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/MessageDialog.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Styling/AppStyle.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SSplitter.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+#define LOCTEXT_NAMESPACE "GridlyRequestsPanel"
+
+namespace GridlyRequestsPanel
+{
+	/** Number of requests shown in the waterfall, newest first */
+	static const int32 MaxRecentRequests = 200;
+
+	static const FName ColumnEndpoint("Endpoint");
+	static const FName ColumnRequests("Requests");
+	static const FName ColumnFailed("Failed");
+	static const FName ColumnStatus("Status");
+	static const FName ColumnBytes("Bytes");
+	static const FName ColumnQueueWait("QueueWait");
+	static const FName ColumnTimeToFirstByte("TimeToFirstByte");
+	static const FName ColumnTransfer("Transfer");
+	static const FName ColumnDecode("Decode");
+	static const FName ColumnTotal("Total");
+	static const FName ColumnWaterfall("Waterfall");
+
+	static FText FormatMilliseconds(const double Seconds)
+	{
+		return FText::AsNumber(FMath::RoundToInt(Seconds * 1000.0));
+	}
+
+	static FText FormatPercentiles(const FGridlyLatencyPercentiles& Percentiles)
+	{
+		return FText::Format(LOCTEXT("Percentiles", "{0} / {1} / {2}"), FormatMilliseconds(Percentiles.P50),
+			FormatMilliseconds(Percentiles.P95), FormatMilliseconds(Percentiles.P99));
+	}
+
+	static FText FormatBytes(const int64 BytesSent, const int64 BytesReceived)
+	{
+		return FText::Format(LOCTEXT("Bytes", "{0} / {1}"), FText::AsMemory(BytesSent), FText::AsMemory(BytesReceived));
+	}
+
+	class SEndpointRow final : public SMultiColumnTableRow<TSharedPtr<FGridlyEndpointStats>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SEndpointRow)
+			{
+			}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable,
+			const TSharedPtr<FGridlyEndpointStats>& InStats)
+		{
+			Stats = InStats;
+			SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if (ColumnName == ColumnEndpoint)
+			{
+				Text = FText::FromString(Stats->Endpoint);
+			}
+			else if (ColumnName == ColumnRequests)
+			{
+				Text = FText::AsNumber(Stats->NumRequests);
+			}
+			else if (ColumnName == ColumnFailed)
+			{
+				Text = FText::AsNumber(Stats->NumFailed);
+			}
+			else if (ColumnName == ColumnBytes)
+			{
+				Text = FormatBytes(Stats->BytesSent, Stats->BytesReceived);
+			}
+			else if (ColumnName == ColumnQueueWait)
+			{
+				Text = FormatPercentiles(Stats->QueueWait);
+			}
+			else if (ColumnName == ColumnTimeToFirstByte)
+			{
+				Text = FormatPercentiles(Stats->TimeToFirstByte);
+			}
+			else if (ColumnName == ColumnTransfer)
+			{
+				Text = FormatPercentiles(Stats->TransferTime);
+			}
+			else if (ColumnName == ColumnDecode)
+			{
+				Text = FormatPercentiles(Stats->DecodeTime);
+			}
+			else if (ColumnName == ColumnTotal)
+			{
+				Text = FormatPercentiles(Stats->TotalTime);
+			}
+
+			return SNew(STextBlock).Text(Text);
+		}
+
+	private:
+		TSharedPtr<FGridlyEndpointStats> Stats;
+	};
+
+	class SRequestRow final : public SMultiColumnTableRow<TSharedPtr<FGridlyRequestTiming>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SRequestRow)
+			{
+			}
+			SLATE_ARGUMENT(double, WaterfallStartSeconds)
+			SLATE_ARGUMENT(double, WaterfallEndSeconds)
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable,
+			const TSharedPtr<FGridlyRequestTiming>& InTiming)
+		{
+			Timing = InTiming;
+			WaterfallStartSeconds = InArgs._WaterfallStartSeconds;
+			WaterfallEndSeconds = InArgs._WaterfallEndSeconds;
+			SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			if (ColumnName == ColumnWaterfall)
+			{
+				return MakeWaterfall();
+			}
+
+			FText Text;
+			if (ColumnName == ColumnEndpoint)
+			{
+				Text = FText::FromString(Timing->Endpoint);
+			}
+			else if (ColumnName == ColumnStatus)
+			{
+				Text = FText::AsNumber(Timing->ResponseCode);
+			}
+			else if (ColumnName == ColumnBytes)
+			{
+				Text = FormatBytes(Timing->BytesSent, Timing->BytesReceived);
+			}
+			else if (ColumnName == ColumnQueueWait)
+			{
+				Text = FormatMilliseconds(Timing->GetQueueWait());
+			}
+			else if (ColumnName == ColumnTimeToFirstByte)
+			{
+				Text = FormatMilliseconds(Timing->GetTimeToFirstByte());
+			}
+			else if (ColumnName == ColumnTransfer)
+			{
+				Text = FormatMilliseconds(Timing->GetTransferTime());
+			}
+			else if (ColumnName == ColumnDecode)
+			{
+				Text = FormatMilliseconds(Timing->DecodeSeconds);
+			}
+
+			return SNew(STextBlock)
+				.Text(Text)
+				.ColorAndOpacity(Timing->IsSuccess() ? FSlateColor::UseForeground() : FSlateColor(FLinearColor::Red));
+		}
+
+	private:
+		TSharedRef<SWidget> MakeWaterfall() const
+		{
+			// Phases are laid out as fill widths relative to the span of all requests in the waterfall
+
+			const double EndSeconds = Timing->CompleteSeconds + Timing->DecodeSeconds;
+			const float Phases[] = {
+				static_cast<float>(Timing->QueuedSeconds - WaterfallStartSeconds),
+				static_cast<float>(Timing->GetQueueWait()),
+				static_cast<float>(Timing->GetTimeToFirstByte()),
+				static_cast<float>(Timing->GetTransferTime()),
+				static_cast<float>(Timing->DecodeSeconds),
+				static_cast<float>(WaterfallEndSeconds - EndSeconds)
+			};
+			const FLinearColor Colors[] = {
+				FLinearColor::Transparent,
+				FLinearColor::Gray,
+				FLinearColor(0.1f, 0.4f, 0.9f),
+				FLinearColor(0.1f, 0.7f, 0.3f),
+				FLinearColor(0.9f, 0.6f, 0.1f),
+				FLinearColor::Transparent
+			};
+
+			const TSharedRef<SHorizontalBox> Waterfall = SNew(SHorizontalBox);
+			const int32 NumPhases = UE_ARRAY_COUNT(Phases);
+			for (int32 i = 0; i < NumPhases; i++)
+			{
+				Waterfall->AddSlot()
+				.FillWidth(FMath::Max(Phases[i], 0.f))
+				[
+					SNew(SBorder)
+					.BorderImage(FAppStyle::GetBrush("WhiteBrush"))
+					.BorderBackgroundColor(Colors[i])
+				];
+			}
+			return Waterfall;
+		}
+
+		TSharedPtr<FGridlyRequestTiming> Timing;
+		double WaterfallStartSeconds = 0.0;
+		double WaterfallEndSeconds = 0.0;
+	};
+}
+
+const FName SGridlyRequestsPanel::TabName("GridlyRequests");
+
+TSharedRef<SDockTab> SGridlyRequestsPanel::SpawnTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SGridlyRequestsPanel)
+		];
+}
+
+void SGridlyRequestsPanel::Construct(const FArguments& InArgs)
+{
+	using namespace GridlyRequestsPanel;
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.f)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.f, 0.f, 4.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Clear", "Clear"))
+				.OnClicked(this, &SGridlyRequestsPanel::OnClearClicked)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.f, 0.f, 4.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("ExportTimeline", "Export Timeline"))
+				.ToolTipText(LOCTEXT("ExportTimelineTooltip",
+					"Writes the percentiles per endpoint and the timings of every request to Saved/Gridly/RequestTimeline.json"))
+				.OnClicked(this, &SGridlyRequestsPanel::OnExportTimelineClicked)
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("Legend", "Times in ms as p50 / p95 / p99. Waterfall: queue (gray), first byte (blue), transfer (green), decode (orange)"))
+			]
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SSplitter)
+			.Orientation(Orient_Vertical)
+			+ SSplitter::Slot()
+			.Value(0.35f)
+			[
+				SAssignNew(EndpointListView, SListView<TSharedPtr<FGridlyEndpointStats>>)
+				.ListItemsSource(&EndpointStats)
+				.OnGenerateRow(this, &SGridlyRequestsPanel::OnGenerateEndpointRow)
+				.SelectionMode(ESelectionMode::None)
+				.HeaderRow(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(ColumnEndpoint).DefaultLabel(LOCTEXT("Endpoint", "Endpoint")).FillWidth(2.f)
+					+ SHeaderRow::Column(ColumnRequests).DefaultLabel(LOCTEXT("Requests", "Requests")).FillWidth(0.5f)
+					+ SHeaderRow::Column(ColumnFailed).DefaultLabel(LOCTEXT("Failed", "Failed")).FillWidth(0.5f)
+					+ SHeaderRow::Column(ColumnBytes).DefaultLabel(LOCTEXT("SentReceived", "Sent / Received")).FillWidth(1.f)
+					+ SHeaderRow::Column(ColumnQueueWait).DefaultLabel(LOCTEXT("QueueWait", "Queue")).FillWidth(1.f)
+					+ SHeaderRow::Column(ColumnTimeToFirstByte).DefaultLabel(LOCTEXT("TimeToFirstByte", "First Byte")).FillWidth(1.f)
+					+ SHeaderRow::Column(ColumnTransfer).DefaultLabel(LOCTEXT("Transfer", "Transfer")).FillWidth(1.f)
+					+ SHeaderRow::Column(ColumnDecode).DefaultLabel(LOCTEXT("Decode", "Decode")).FillWidth(1.f)
+					+ SHeaderRow::Column(ColumnTotal).DefaultLabel(LOCTEXT("Total", "Total")).FillWidth(1.f))
+			]
+			+ SSplitter::Slot()
+			.Value(0.65f)
+			[
+				SAssignNew(RequestListView, SListView<TSharedPtr<FGridlyRequestTiming>>)
+				.ListItemsSource(&RecentRequests)
+				.OnGenerateRow(this, &SGridlyRequestsPanel::OnGenerateRequestRow)
+				.SelectionMode(ESelectionMode::None)
+				.HeaderRow(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(ColumnEndpoint).DefaultLabel(LOCTEXT("Endpoint", "Endpoint")).FillWidth(2.f)
+					+ SHeaderRow::Column(ColumnStatus).DefaultLabel(LOCTEXT("Status", "Status")).FillWidth(0.5f)
+					+ SHeaderRow::Column(ColumnBytes).DefaultLabel(LOCTEXT("SentReceived", "Sent / Received")).FillWidth(1.f)
+					+ SHeaderRow::Column(ColumnQueueWait).DefaultLabel(LOCTEXT("QueueWait", "Queue")).FillWidth(0.5f)
+					+ SHeaderRow::Column(ColumnTimeToFirstByte).DefaultLabel(LOCTEXT("TimeToFirstByte", "First Byte")).FillWidth(0.5f)
+					+ SHeaderRow::Column(ColumnTransfer).DefaultLabel(LOCTEXT("Transfer", "Transfer")).FillWidth(0.5f)
+					+ SHeaderRow::Column(ColumnDecode).DefaultLabel(LOCTEXT("Decode", "Decode")).FillWidth(0.5f)
+					+ SHeaderRow::Column(ColumnWaterfall).DefaultLabel(LOCTEXT("Waterfall", "Waterfall")).FillWidth(3.f))
+			]
+		]
+	];
+
+	Refresh(0.0, 0.f);
+	RegisterActiveTimer(1.f, FWidgetActiveTimerDelegate::CreateSP(this, &SGridlyRequestsPanel::Refresh));
+}
+
+EActiveTimerReturnType SGridlyRequestsPanel::Refresh(double InCurrentTime, float InDeltaTime)
+{
+	const TArray<FGridlyRequestTiming> Timings = FGridlyProfiling::GetRequestTimings();
+
+	EndpointStats.Reset();
+	for (FGridlyEndpointStats& Stats : FGridlyProfiling::GetEndpointStats(Timings))
+	{
+		EndpointStats.Add(MakeShared<FGridlyEndpointStats>(MoveTemp(Stats)));
+	}
+
+	RecentRequests.Reset();
+	WaterfallStartSeconds = TNumericLimits<double>::Max();
+	WaterfallEndSeconds = 0.0;
+
+	for (int32 i = Timings.Num() - 1; i >= 0 && RecentRequests.Num() < GridlyRequestsPanel::MaxRecentRequests; i--)
+	{
+		const FGridlyRequestTiming& Timing = Timings[i];
+		RecentRequests.Add(MakeShared<FGridlyRequestTiming>(Timing));
+		WaterfallStartSeconds = FMath::Min(WaterfallStartSeconds, Timing.QueuedSeconds);
+		WaterfallEndSeconds = FMath::Max(WaterfallEndSeconds, Timing.CompleteSeconds + Timing.DecodeSeconds);
+	}
+
+	// Rows are regenerated so that the waterfall is laid out for the new time span
+	EndpointListView->RebuildList();
+	RequestListView->RebuildList();
+
+	return EActiveTimerReturnType::Continue;
+}
+
+FReply SGridlyRequestsPanel::OnClearClicked()
+{
+	FGridlyProfiling::ResetRequestTimings();
+	Refresh(0.0, 0.f);
+	return FReply::Handled();
+}
+
+FReply SGridlyRequestsPanel::OnExportTimelineClicked()
+{
+	double StartSeconds = TNumericLimits<double>::Max();
+	for (const FGridlyRequestTiming& Timing : FGridlyProfiling::GetRequestTimings())
+	{
+		StartSeconds = FMath::Min(StartSeconds, Timing.QueuedSeconds);
+	}
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(FGridlyProfiling::RequestTimingsToJson(StartSeconds == TNumericLimits<double>::Max() ? 0.0 : StartSeconds),
+		JsonWriter);
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Gridly") / TEXT("RequestTimeline.json");
+	FString Message;
+	if (FFileHelper::SaveStringToFile(JsonString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		Message = FString::Printf(TEXT("Wrote request timeline: %s"), *FPaths::ConvertRelativePathToFull(FilePath));
+		UE_LOG(LogGridlyEditor, Log, TEXT("%s"), *Message);
+	}
+	else
+	{
+		Message = FString::Printf(TEXT("Failed to write request timeline: %s"), *FilePath);
+		UE_LOG(LogGridlyEditor, Error, TEXT("%s"), *Message);
+	}
+
+	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+	return FReply::Handled();
+}
+
+TSharedRef<ITableRow> SGridlyRequestsPanel::OnGenerateEndpointRow(TSharedPtr<FGridlyEndpointStats> Stats,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(GridlyRequestsPanel::SEndpointRow, OwnerTable, Stats);
+}
+
+TSharedRef<ITableRow> SGridlyRequestsPanel::OnGenerateRequestRow(TSharedPtr<FGridlyRequestTiming> Timing,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(GridlyRequestsPanel::SRequestRow, OwnerTable, Timing)
+		.WaterfallStartSeconds(WaterfallStartSeconds)
+		.WaterfallEndSeconds(WaterfallEndSeconds);
+}
+
+#undef LOCTEXT_NAMESPACE
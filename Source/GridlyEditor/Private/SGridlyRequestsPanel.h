@@ -0,0 +1,51 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridlyProfiling.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class SDockTab;
+class FSpawnTabArgs;
+
+/**
+ * Debug panel with the latency percentiles of every Gridly endpoint, and a waterfall of the most recent requests that shows
+ * how long each one waited in the queue, for the first byte, for the transfer and for decoding
+ */
+class SGridlyRequestsPanel final : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SGridlyRequestsPanel)
+		{
+		}
+	SLATE_END_ARGS()
+
+	static const FName TabName;
+
+	static TSharedRef<SDockTab> SpawnTab(const FSpawnTabArgs& SpawnTabArgs);
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	EActiveTimerReturnType Refresh(double InCurrentTime, float InDeltaTime);
+
+	FReply OnClearClicked();
+	FReply OnExportTimelineClicked();
+
+	TSharedRef<ITableRow> OnGenerateEndpointRow(TSharedPtr<FGridlyEndpointStats> Stats,
+		const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateRequestRow(TSharedPtr<FGridlyRequestTiming> Timing,
+		const TSharedRef<STableViewBase>& OwnerTable);
+
+	TArray<TSharedPtr<FGridlyEndpointStats>> EndpointStats;
+	TArray<TSharedPtr<FGridlyRequestTiming>> RecentRequests;
+
+	/** Time span of the waterfall, shared by all its rows */
+	double WaterfallStartSeconds = 0.0;
+	double WaterfallEndSeconds = 0.0;
+
+	TSharedPtr<SListView<TSharedPtr<FGridlyEndpointStats>>> EndpointListView;
+	TSharedPtr<SListView<TSharedPtr<FGridlyRequestTiming>>> RequestListView;
+};
@@ -0,0 +1,60 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyBenchmark.h"
+#include "GridlyProfiling.h"
+#include "GridlySyntheticData.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FGridlyBenchmarkTest, "Gridly.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FGridlyBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	TArray<FString> SizeStrings;
+	FString(FGridlyBenchmark::DefaultSizes).ParseIntoArray(SizeStrings, TEXT(","));
+
+	for (const FString& Stage : FGridlyBenchmark::GetStageNames())
+	{
+		for (const FString& SizeString : SizeStrings)
+		{
+			OutBeautifiedNames.Add(FString::Printf(TEXT("%s %s"), *Stage, *SizeString));
+			OutTestCommands.Add(FString::Printf(TEXT("%s %s"), *Stage, *SizeString));
+		}
+	}
+}
+
+bool FGridlyBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FString Stage;
+	FString SizeString;
+	if (!Parameters.Split(TEXT(" "), &Stage, &SizeString))
+	{
+		AddError(FString::Printf(TEXT("Invalid test parameters: %s"), *Parameters));
+		return false;
+	}
+
+	FGridlyProfiling::EnableAllocationCounting();
+
+	FGridlySyntheticDataShape Shape;
+	Shape.NumRecords = FCString::Atoi(*SizeString);
+
+	FGridlyBenchmark Benchmark(Shape);
+	FGridlyBenchmark::FStageResult Result;
+	FString Error;
+	if (!Benchmark.RunStage(Stage, FGridlyBenchmark::DefaultIterations, Result, Error))
+	{
+		AddError(FString::Printf(TEXT("Skipped %s with %d records: %s"), *Stage, Shape.NumRecords, *Error));
+		return false;
+	}
+
+	const double MedianSeconds = Result.GetMedianSeconds();
+	AddInfo(FString::Printf(TEXT("%s with %d records: median %.2f ms, min %.2f ms, %.0f records/s, %.2f allocations per record"),
+		*Stage, Result.NumRecords, MedianSeconds * 1000.0, Result.GetMinSeconds() * 1000.0,
+		MedianSeconds > 0.0 ? Result.NumRecords / MedianSeconds : 0.0, Result.GetAllocationsPerRecord()));
+
+	return true;
+}
+
+#endif	  // WITH_DEV_AUTOMATION_TESTS
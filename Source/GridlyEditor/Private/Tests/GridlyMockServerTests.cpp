@@ -0,0 +1,187 @@
+// Copyright (c) 2021 LocalizeDirect AB
+
+#include "GridlyMockServer.h"
+#include "GridlySyntheticData.h"
+#include "GridlyTableRow.h"
+#include "HttpModule.h"
+#include "JsonObjectConverter.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GridlyMockServerTests
+{
+	/** Port of the mock server under test, apart from the default so that a running mock server does not get in the way */
+	static const uint32 Port = 8091;
+
+	static const TCHAR* const ViewId = TEXT("view");
+	static const int32 NumRecords = 10;
+
+	static const double TimeoutSeconds = 10.0;
+}
+
+/**
+ * Sends one request to the mock server and waits for its response, then checks the status and, optionally, the body
+ */
+class FGridlyMockServerRequestCommand : public IAutomationLatentCommand
+{
+public:
+	FGridlyMockServerRequestCommand(FAutomationTestBase& InTest, const TSharedRef<FGridlyMockServer>& InMockServer,
+		const FString& InVerb, const FString& InPath, const FString& InBody, const int32 InExpectedCode,
+		TFunction<void(const FString&)> InCheckBody = nullptr)
+		: Test(InTest)
+		, MockServer(InMockServer)
+		, Verb(InVerb)
+		, Path(InPath)
+		, Body(InBody)
+		, ExpectedCode(InExpectedCode)
+		, CheckBody(MoveTemp(InCheckBody))
+	{
+	}
+
+	virtual ~FGridlyMockServerRequestCommand() override
+	{
+		if (HttpRequest.IsValid())
+		{
+			HttpRequest->OnProcessRequestComplete().Unbind();
+		}
+	}
+
+	virtual bool Update() override
+	{
+		if (!HttpRequest.IsValid())
+		{
+			HttpRequest = FHttpModule::Get().CreateRequest();
+			HttpRequest->SetVerb(Verb);
+			HttpRequest->SetURL(MockServer->GetBaseUrl() + Path);
+			HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+			HttpRequest->SetContentAsString(Body);
+			HttpRequest->OnProcessRequestComplete().BindLambda(
+				[this](FHttpRequestPtr, FHttpResponsePtr InHttpResponse, bool)
+				{
+					HttpResponse = InHttpResponse;
+					bComplete = true;
+				});
+			HttpRequest->ProcessRequest();
+			return false;
+		}
+
+		if (!bComplete)
+		{
+			if (GetCurrentRunTime() > GridlyMockServerTests::TimeoutSeconds)
+			{
+				HttpRequest->CancelRequest();
+				Test.AddError(FString::Printf(TEXT("%s %s timed out"), *Verb, *Path));
+				return true;
+			}
+			return false;
+		}
+
+		if (!HttpResponse.IsValid())
+		{
+			Test.AddError(FString::Printf(TEXT("%s %s failed"), *Verb, *Path));
+			return true;
+		}
+
+		Test.TestEqual(FString::Printf(TEXT("%s %s status"), *Verb, *Path), HttpResponse->GetResponseCode(), ExpectedCode);
+		if (CheckBody)
+		{
+			CheckBody(HttpResponse->GetContentAsString());
+		}
+		return true;
+	}
+
+private:
+	FAutomationTestBase& Test;
+	TSharedRef<FGridlyMockServer> MockServer;
+	FString Verb;
+	FString Path;
+	FString Body;
+	int32 ExpectedCode;
+	TFunction<void(const FString&)> CheckBody;
+
+	FHttpRequestPtr HttpRequest;
+	FHttpResponsePtr HttpResponse;
+	bool bComplete = false;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridlyMockServerRoundTripTest, "Gridly.MockServer.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGridlyMockServerRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace GridlyMockServerTests;
+
+	FGridlyMockServerOptions Options;
+	Options.Port = Port;
+
+	FGridlySyntheticDataShape Shape;
+	Shape.NumRecords = NumRecords;
+	const FGridlySyntheticData SyntheticData(Shape);
+
+	const TSharedRef<FGridlyMockServer> MockServer = MakeShared<FGridlyMockServer>(Options);
+	MockServer->SetViewRecords(ViewId, SyntheticData.GetTableRows());
+
+	if (!MockServer->Start())
+	{
+		AddError(FString::Printf(TEXT("Failed to start the mock server on port %u"), Port));
+		return false;
+	}
+
+	const FString ViewPath = FString::Printf(TEXT("/v1/views/%s"), ViewId);
+	const FString RecordsPath = ViewPath + TEXT("/records");
+
+	// Every endpoint the plugin uses, then an upsert and a delete that must change the view
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGridlyMockServerRequestCommand(*this, MockServer, TEXT("GET"), ViewPath, FString(),
+		static_cast<int32>(EHttpResponseCodes::Ok),
+		[this](const FString& Content) { TestTrue(TEXT("View has columns"), Content.Contains(TEXT("\"columns\""))); }));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGridlyMockServerRequestCommand(*this, MockServer, TEXT("GET"), RecordsPath, FString(),
+		static_cast<int32>(EHttpResponseCodes::Ok),
+		[this](const FString& Content)
+		{
+			TArray<FGridlyTableRow> Records;
+			TestTrue(TEXT("Records decode"), FJsonObjectConverter::JsonArrayStringToUStruct(Content, &Records, 0, 0));
+			TestEqual(TEXT("Number of records"), Records.Num(), NumRecords);
+		}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGridlyMockServerRequestCommand(*this, MockServer, TEXT("GET"), ViewPath + TEXT("/export"),
+		FString(), static_cast<int32>(EHttpResponseCodes::Ok),
+		[this](const FString& Content) { TestFalse(TEXT("Export is not empty"), Content.IsEmpty()); }));
+
+	FGridlyTableRow NewRecord;
+	NewRecord.Id = TEXT("RoundTrip");
+	NewRecord.Path = TEXT("Tests");
+	NewRecord.Cells.AddDefaulted_GetRef().ColumnId = SyntheticData.GetTableRows()[0].Cells[0].ColumnId;
+	NewRecord.Cells[0].Value = TEXT("Round trip");
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGridlyMockServerRequestCommand(*this, MockServer, TEXT("POST"), RecordsPath,
+		FGridlySyntheticData::WriteRecordsJson({ NewRecord }), static_cast<int32>(EHttpResponseCodes::Created),
+		[this, MockServer](const FString&)
+		{
+			TestEqual(TEXT("Number of records after the upsert"), MockServer->GetViewRecords(ViewId)->Num(), NumRecords + 1);
+		}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGridlyMockServerRequestCommand(*this, MockServer, TEXT("DELETE"), RecordsPath,
+		TEXT("{\"ids\":[\"Tests,RoundTrip\"]}"), static_cast<int32>(EHttpResponseCodes::NoContent),
+		[this, MockServer](const FString&)
+		{
+			TestEqual(TEXT("Number of records after the delete"), MockServer->GetViewRecords(ViewId)->Num(), NumRecords);
+		}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGridlyMockServerRequestCommand(*this, MockServer, TEXT("GET"), TEXT("/v1/views/missing"),
+		FString(), static_cast<int32>(EHttpResponseCodes::NotFound)));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([MockServer]()
+	{
+		MockServer->Stop();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif	  // WITH_DEV_AUTOMATION_TESTS